@@ -31,69 +31,48 @@ template<class Base>
 class Argument {
 private:
     OperationNode<Base>* operation_;
-    std::unique_ptr<Base> parameter_;
+    /**
+     * The constant value (kept inline to avoid a heap allocation per
+     * argument)
+     */
+    Base parameter_;
+    bool parameterDefined_;
 public:
 
     inline Argument() :
-        operation_(nullptr) {
+        operation_(nullptr),
+        parameter_(),
+        parameterDefined_(false) {
     }
 
     inline Argument(OperationNode<Base>& operation) :
-        operation_(&operation) {
+        operation_(&operation),
+        parameter_(),
+        parameterDefined_(false) {
     }
 
     inline Argument(const Base& parameter) :
         operation_(nullptr),
-        parameter_(new Base(parameter)) {
-    }
-
-    inline Argument(const Argument& orig) :
-        operation_(orig.operation_),
-        parameter_(orig.parameter_ != nullptr ? new Base(*orig.parameter_) : nullptr) {
-    }
-
-    inline Argument(Argument&& orig) :
-            operation_(orig.operation_),
-            parameter_(std::move(orig.parameter_)) {
-    }
-
-    inline Argument& operator=(const Argument& rhs) {
-        if (&rhs == this) {
-            return *this;
-        }
-        if (rhs.operation_ != nullptr) {
-            operation_ = rhs.operation_;
-            parameter_.reset();
-        } else {
-            operation_ = nullptr;
-            if (parameter_ != nullptr) {
-                *parameter_ = *rhs.parameter_;
-            } else {
-                parameter_.reset(new Base(*rhs.parameter_)); // to replace with parameter_ = std::make_unique once c++14 is used
-            }
-        }
-        return *this;
+        parameter_(parameter),
+        parameterDefined_(true) {
     }
 
-    inline Argument& operator=(Argument&& rhs) {
-        assert(this != &rhs);
+    inline Argument(const Argument& orig) = default;
 
-        operation_ = rhs.operation_;
+    inline Argument(Argument&& orig) = default;
 
-        // steal the parameter
-        parameter_ = std::move(rhs.parameter_);
+    inline Argument& operator=(const Argument& rhs) = default;
 
-        return *this;
-    }
+    inline Argument& operator=(Argument&& rhs) = default;
 
-    virtual ~Argument() = default;
+    ~Argument() = default;
 
     inline OperationNode<Base>* getOperation() const {
         return operation_;
     }
 
-    inline Base* getParameter() const {
-        return parameter_.get();
+    inline const Base* getParameter() const {
+        return parameterDefined_ ? &parameter_ : nullptr;
     }
 
 };
@@ -24,6 +24,8 @@ namespace cg {
  * type.
  * This class can be useful when a CppAD::ADFun<CppAD::cg::CG> is going to
  * be used to create a compiled model library but has not been compiled yet.
+ * The wrapped model can also be inlined (see setInline()) so that its
+ * operations are added directly to the caller's generated source code.
  *
  * @author Joao Leal
  */
@@ -38,6 +40,7 @@ protected:
     CustomPosition custom_jac_;
     CustomPosition custom_hess_;
     std::map<size_t, CppAD::vector<std::set<size_t> > > hess_;
+    bool inline_;
 public:
 
     /**
@@ -58,7 +61,8 @@ public:
                       bool cacheSparsities = true) :
         CGAbstractAtomicFun<Base>(name, standAlone),
         fun_(fun),
-        cacheSparsities_(cacheSparsities) {
+        cacheSparsities_(cacheSparsities),
+        inline_(false) {
         this->option(CppAD::atomic_base<CGB>::set_sparsity_enum);
     }
 
@@ -72,6 +76,81 @@ public:
         this->CGAbstractAtomicFun<Base>::operator()(ax, ay, id);
     }
 
+    /**
+     * Whether or not the operations of the wrapped model are added directly
+     * to the operation graph of the caller during source code generation.
+     */
+    inline bool isInline() const {
+        return inline_;
+    }
+
+    /**
+     * Defines whether or not the operations of the wrapped model are added
+     * directly to the operation graph of the caller during source code
+     * generation (forward and reverse mode calls with CG variables).
+     * The generated source code will then not call the atomic function and
+     * the compiler can optimize across the two models.
+     * When disabled, calls to an atomic function are created which must be
+     * provided to the compiled model at runtime.
+     *
+     * @param inlineFun whether or not to inline the wrapped model
+     */
+    inline void setInline(bool inlineFun) {
+        inline_ = inlineFun;
+    }
+
+    bool forward(size_t q,
+                 size_t p,
+                 const CppAD::vector<bool>& vx,
+                 CppAD::vector<bool>& vy,
+                 const CppAD::vector<CGB>& tx,
+                 CppAD::vector<CGB>& ty) override {
+        if (!inline_ || BaseAbstractAtomicFun<Base>::isParameters(tx)) {
+            return CGAbstractAtomicFun<Base>::forward(q, p, vx, vy, tx, ty);
+        }
+
+        if (vx.size() > 0) {
+            CppAD::cg::zeroOrderDependency(fun_, vx, vy);
+        }
+
+        // the model operations are created in the handler of tx
+        CppAD::vector<CGB> tyInner = fun_.Forward(p, tx);
+
+        size_t p1 = p + 1;
+        size_t m = ty.size() / p1;
+        for (size_t i = 0; i < m; i++) {
+            for (size_t k = q; k < p1; k++) {
+                ty[i * p1 + k] = tyInner[i * p1 + k];
+            }
+        }
+
+        fun_.capacity_order(0);
+
+        return true;
+    }
+
+    bool reverse(size_t p,
+                 const CppAD::vector<CGB>& tx,
+                 const CppAD::vector<CGB>& ty,
+                 CppAD::vector<CGB>& px,
+                 const CppAD::vector<CGB>& py) override {
+        if (!inline_ ||
+            (BaseAbstractAtomicFun<Base>::isParameters(tx) && BaseAbstractAtomicFun<Base>::isParameters(py))) {
+            return CGAbstractAtomicFun<Base>::reverse(p, tx, ty, px, py);
+        }
+
+        fun_.Forward(p, tx);
+
+        CppAD::vector<CGB> pxInner = fun_.Reverse(p + 1, py);
+        for (size_t j = 0; j < px.size(); j++) {
+            px[j] = pxInner[j];
+        }
+
+        fun_.capacity_order(0);
+
+        return true;
+    }
+
     template<class VectorSize>
     inline void setCustomSparseJacobianElements(const VectorSize& row,
                                                 const VectorSize& col) {
@@ -36,8 +36,14 @@ private:
     /**
      * A constant value which must be defined for parameters.
      * Its definition is optional for variables.
+     * It is kept inline (instead of in the heap) since a very large number
+     * of CG objects are created and copied while taping a model.
      */
-    std::unique_ptr<Base> value_;
+    Base value_;
+    /**
+     * Whether or not value_ is defined
+     */
+    bool valueDefined_;
 
 public:
     /**
@@ -55,22 +61,22 @@ public:
     /**
      * Copy constructor
      */
-    inline CG(const CG<Base>& orig);
+    inline CG(const CG<Base>& orig) = default;
 
     /**
      * Move constructor
      */
-    inline CG(CG<Base>&& orig);
+    inline CG(CG<Base>&& orig) = default;
 
     /**
      * Copy assignment operator
      */
-    inline CG& operator=(const CG<Base>& rhs);
+    inline CG& operator=(const CG<Base>& rhs) = default;
 
     /**
      * Move assignment operator
      */
-    inline CG& operator=(CG<Base>&& rhs);
+    inline CG& operator=(CG<Base>&& rhs) = default;
 
     /**
      * Creates a parameter with the provided value
@@ -87,7 +93,7 @@ public:
     inline CG& operator=(const Base& rhs);
 
     // destructor
-    virtual ~CG();
+    ~CG() = default;
 
     /**
      * @return The code handler that owns the OperationNode when it is a
@@ -178,7 +184,7 @@ protected:
     inline void makeVariable(OperationNode<Base>& operation);
 
     inline void makeVariable(OperationNode<Base>& operation,
-                             std::unique_ptr<Base>& value);
+                             const Base& value);
 
     // creating an argument out of this node
     inline Argument<Base> argument() const;
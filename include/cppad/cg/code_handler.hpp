@@ -104,6 +104,11 @@ protected:
      * maps dependencies between variables in _variableOrder
      */
     std::vector<std::set<Node*>> _variableDependencies;
+    /**
+     * the positions in _variableOrder where each part of the operation
+     * graph starts (except the first part)
+     */
+    std::vector<size_t> _partitionStarts;
     /**
      * the order for the variable creation in the source code
      * (each level represents a different variable scope)
@@ -141,6 +146,8 @@ protected:
     bool _used;
     // a flag indicating whether or not to reuse the IDs of destroyed variables
     bool _reuseIDs;
+    // a flag indicating whether or not to reorder operations to reduce live ranges
+    bool _scheduleOps;
     // scope color/index counter
     ScopeIDType _scopeColorCount;
     // the current scope color/index counter
@@ -197,6 +204,27 @@ public:
      */
     inline bool isReuseVariableIDs() const;
 
+    /**
+     * Defines whether or not to reorder the operations before the source
+     * code generation so that the live ranges of temporary variables are
+     * reduced.
+     * Operations which release temporary variables (their last usage) are
+     * evaluated as soon as possible and operations using recently computed
+     * values are preferred, which improves the locality of the accesses to
+     * the temporary variable array.
+     * The reordering is only applied to operation graphs without loops,
+     * conditional scopes, atomic functions, or array operations.
+     *
+     * @param schedule whether or not to reorder operations
+     */
+    inline void setScheduleOperations(bool schedule);
+
+    /**
+     * Whether or not operations are reordered to reduce the live ranges of
+     * temporary variables.
+     */
+    inline bool isScheduleOperations() const;
+
     /**
      * Marks the provided variables as being independent variables.
      *
@@ -697,6 +725,41 @@ protected:
 
     inline void reduceTemporaryVariables(ArrayView<CGB>& dependent);
 
+    /**
+     * Reorders the operations in the evaluation queue using a greedy list
+     * scheduling which minimizes the number of simultaneously alive
+     * temporary variables.
+     *
+     * @return true if the evaluation order was changed
+     */
+    inline bool scheduleOperations();
+
+    /**
+     * Partitions the operations in the evaluation queue into parts which
+     * are evaluated consecutively (e.g. in different functions).
+     * The parts have a similar number of operations and the operations
+     * are grown greedily into each part from the results already in that
+     * part so that few variables are used by operations in other parts.
+     * The evaluation queue is reordered so that each part is contiguous.
+     *
+     * @param partitionSize the average number of assignments per part
+     */
+    inline void partitionOperations(size_t partitionSize);
+
+    /**
+     * Replaces the evaluation queue with a reordered queue.
+     *
+     * @param newOrder the new evaluation order (it is swapped with the
+     *                 current order)
+     */
+    inline void updateVariableOrder(std::vector<Node*>& newOrder);
+
+    /**
+     * Whether or not the operations in the evaluation queue can be
+     * reordered using only the dependencies between their arguments.
+     */
+    inline bool isSchedulable() const;
+
     /**
      * Change operation order so that the total number of temporary variables is
      * reduced.
@@ -778,6 +841,21 @@ protected:
 
     inline void resetManagedNodes();
 
+    /**
+     * Starts a fine grained job of the source generation which is only
+     * reported to the listeners of the job timer (if there is one).
+     */
+    inline void startingStage(const std::string& name);
+
+    inline void finishedStage();
+
+    /**
+     * Reports a metric of the current job to the job timer (if there is
+     * one).
+     */
+    inline void reportJobInfo(const std::string& name,
+                              double value);
+
     /**************************************************************************
      *                       Graph management functions
      *************************************************************************/
@@ -893,6 +971,7 @@ protected:
     friend class CGAbstractAtomicFun<Base>;
     friend class BaseAbstractAtomicFun<Base>;
     friend class LoopModel<Base>;
+    friend class GraphSerializer<Base>;
 
 };
 
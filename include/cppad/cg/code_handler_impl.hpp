@@ -38,6 +38,7 @@ CodeHandler<Base>::CodeHandler(size_t varCount) :
         _atomicFunctionsOrder(nullptr),
         _used(false),
         _reuseIDs(true),
+        _scheduleOps(false),
         _scopeColorCount(0),
         _currentScopeColor(0),
         _lang(nullptr),
@@ -72,6 +73,16 @@ inline bool CodeHandler<Base>::isReuseVariableIDs() const {
     return _reuseIDs;
 }
 
+template<class Base>
+inline void CodeHandler<Base>::setScheduleOperations(bool schedule) {
+    _scheduleOps = schedule;
+}
+
+template<class Base>
+inline bool CodeHandler<Base>::isScheduleOperations() const {
+    return _scheduleOps;
+}
+
 template<class Base>
 inline void CodeHandler<Base>::makeVariables(std::vector<AD<CGB> >& variables) {
     for (auto& v : variables) {
@@ -127,6 +138,25 @@ inline void CodeHandler<Base>::setJobTimer(JobTimer* jobTimer) {
     _jobTimer = jobTimer;
 }
 
+template<class Base>
+inline void CodeHandler<Base>::startingStage(const std::string& name) {
+    if (_jobTimer != nullptr)
+        _jobTimer->startingStage(name);
+}
+
+template<class Base>
+inline void CodeHandler<Base>::finishedStage() {
+    if (_jobTimer != nullptr)
+        _jobTimer->finishedJob();
+}
+
+template<class Base>
+inline void CodeHandler<Base>::reportJobInfo(const std::string& name,
+                                             double value) {
+    if (_jobTimer != nullptr)
+        _jobTimer->reportJobInfo(name, value);
+}
+
 template<class Base>
 inline bool CodeHandler<Base>::isZeroDependents() const {
     return _zeroDependents;
@@ -335,6 +365,8 @@ void CodeHandler<Base>::generateCode(std::ostream& out,
     /**
      * determine the number of times each variable is used
      */
+    startingStage("operation ordering");
+
     for (size_t i = 0; i < m; i++) {
         Node* node = dependent[i].getOperationNode();
         if (node != nullptr) {
@@ -396,11 +428,35 @@ void CodeHandler<Base>::generateCode(std::ostream& out,
         dependentAdded2EvaluationQueue(arg);
     }
 
+    finishedStage();
+
+    /**
+     * Reorder operations to reduce the live ranges of temporary variables
+     */
+    if (_scheduleOps) {
+        startingStage("operation scheduling");
+        scheduleOperations();
+        finishedStage();
+    }
+
+    /**
+     * Partition the operations (e.g. into different functions)
+     */
+    _partitionStarts.clear();
+    size_t partitionSize = lang.getOperationPartitionSize();
+    if (partitionSize > 0) {
+        startingStage("operation partitioning");
+        partitionOperations(partitionSize);
+        finishedStage();
+    }
+
     /**
      * Reuse temporary variables
      */
     if (_reuseIDs) {
+        startingStage("temporary variable reduction");
         reduceTemporaryVariables(dependent);
+        finishedStage();
     }
 
     /**
@@ -442,9 +498,11 @@ void CodeHandler<Base>::generateCode(std::ostream& out,
                                                                                           _loops.indexes, _loops.indexRandomPatterns,
                                                                                           _loops.dependentIndexPatterns, _loops.independentIndexPatterns,
                                                                                           _totalUseCount, _scope, *_auxIterationIndexOp,
-                                                                                          _zeroDependents));
+                                                                                          _zeroDependents, _partitionStarts));
 
+    startingStage("emission");
     lang.generateSourceCode(out, std::move(_info));
+    finishedStage();
 
     /**
      * clean-up
@@ -462,6 +520,11 @@ void CodeHandler<Base>::generateCode(std::ostream& out,
     }
     _alteredNodes.clear();
 
+    reportJobInfo("nodes", getManagedNodesCount());
+    reportJobInfo("evaluated operations", _variableOrder.size());
+    reportJobInfo("dependents", m);
+    reportJobInfo("temporary variables", getTemporaryVariableCount());
+
     if (_jobTimer != nullptr) {
         _jobTimer->finishedJob();
     } else if (_verbose) {
@@ -1712,6 +1775,323 @@ inline void CodeHandler<Base>::reduceTemporaryVariables(ArrayView<CGB>& dependen
     _idSparseArrayCount = sparseArrayComp.getIdCount();
 }
 
+template<class Base>
+inline bool CodeHandler<Base>::isSchedulable() const {
+    for (const Node* node : _variableOrder) {
+        switch (node->getOperationType()) {
+            case CGOpCode::AtomicForward:
+            case CGOpCode::AtomicReverse:
+            case CGOpCode::ArrayCreation:
+            case CGOpCode::SparseArrayCreation:
+            case CGOpCode::ArrayElement:
+            case CGOpCode::CondResult:
+            case CGOpCode::DependentMultiAssign:
+            case CGOpCode::DependentRefRhs:
+            case CGOpCode::Index:
+            case CGOpCode::IndexAssign:
+            case CGOpCode::IndexDeclaration:
+            case CGOpCode::LoopStart:
+            case CGOpCode::LoopEnd:
+            case CGOpCode::LoopIndexedDep:
+            case CGOpCode::LoopIndexedIndep:
+            case CGOpCode::LoopIndexedTmp:
+            case CGOpCode::StartIf:
+            case CGOpCode::ElseIf:
+            case CGOpCode::Else:
+            case CGOpCode::EndIf:
+            case CGOpCode::Pri:
+            case CGOpCode::Tmp:
+            case CGOpCode::TmpDcl:
+                // the evaluation order of these operations is not fully
+                // defined by their arguments
+                return false;
+            default:
+                break;
+        }
+    }
+
+    return true;
+}
+
+template<class Base>
+inline bool CodeHandler<Base>::scheduleOperations() {
+    const size_t nOps = _variableOrder.size();
+    if (nOps < 3 || !isSchedulable()) {
+        return false;
+    }
+
+    /**
+     * dependencies between operations in the evaluation queue
+     */
+    findVariableDependencies();
+
+    std::vector<std::vector<size_t> > preds(nOps);
+    std::vector<std::vector<size_t> > succs(nOps);
+    for (size_t i = 0; i < nOps; ++i) {
+        for (Node* d : _variableDependencies[i]) {
+            size_t pos = getEvaluationOrder(*d);
+            if (pos > 0 && pos <= nOps && _variableOrder[pos - 1] == d) {
+                preds[i].push_back(pos - 1);
+                succs[pos - 1].push_back(i);
+            }
+        }
+    }
+    _variableDependencies.clear();
+
+    /**
+     * greedy list scheduling
+     */
+    struct ReadyOp {
+        long score; // released temporaries minus created temporaries
+        size_t lastPred; // position (+1) of the most recently evaluated argument
+        size_t op; // position in the original evaluation order
+        size_t version;
+
+        inline bool operator<(const ReadyOp& o) const {
+            if (score != o.score) return score < o.score;
+            if (lastPred != o.lastPred) return lastPred < o.lastPred;
+            return op > o.op; // keep the original order
+        }
+    };
+
+    std::vector<size_t> remainingUses(nOps); // successors not evaluated yet
+    std::vector<size_t> missingArgs(nOps); // predecessors not evaluated yet
+    std::vector<size_t> version(nOps, 0);
+    std::vector<size_t> newPos(nOps, 0); // new position (+1)
+    for (size_t i = 0; i < nOps; ++i) {
+        remainingUses[i] = succs[i].size();
+        missingArgs[i] = preds[i].size();
+    }
+
+    auto makeReadyOp = [&](size_t i) {
+        long score = 0;
+        size_t lastPred = 0;
+        for (size_t p : preds[i]) {
+            if (remainingUses[p] == 1 && isTemporary(*_variableOrder[p]))
+                score++;
+            lastPred = std::max<size_t>(lastPred, newPos[p]);
+        }
+        if (isTemporary(*_variableOrder[i]))
+            score--;
+        return ReadyOp{score, lastPred, i, version[i]};
+    };
+
+    std::vector<ReadyOp> ready;
+    ready.reserve(nOps);
+    for (size_t i = 0; i < nOps; ++i) {
+        if (missingArgs[i] == 0) {
+            ready.push_back(makeReadyOp(i));
+        }
+    }
+    std::make_heap(ready.begin(), ready.end());
+
+    std::vector<Node*> newOrder;
+    newOrder.reserve(nOps);
+
+    while (!ready.empty()) {
+        std::pop_heap(ready.begin(), ready.end());
+        ReadyOp r = ready.back();
+        ready.pop_back();
+
+        if (newPos[r.op] != 0 || r.version != version[r.op])
+            continue; // outdated entry
+
+        newOrder.push_back(_variableOrder[r.op]);
+        newPos[r.op] = newOrder.size();
+
+        for (size_t p : preds[r.op]) {
+            remainingUses[p]--;
+            if (remainingUses[p] == 1) {
+                // the last user of p now releases it
+                for (size_t s : succs[p]) {
+                    if (newPos[s] == 0 && missingArgs[s] == 0) {
+                        version[s]++;
+                        ready.push_back(makeReadyOp(s));
+                        std::push_heap(ready.begin(), ready.end());
+                    }
+                }
+            }
+        }
+
+        for (size_t s : succs[r.op]) {
+            missingArgs[s]--;
+            if (missingArgs[s] == 0) {
+                ready.push_back(makeReadyOp(s));
+                std::push_heap(ready.begin(), ready.end());
+            }
+        }
+    }
+
+    CPPADCG_ASSERT_UNKNOWN(newOrder.size() == nOps)
+
+    bool changed = false;
+    for (size_t i = 0; i < nOps; ++i) {
+        if (newPos[i] != i + 1) {
+            changed = true;
+            break;
+        }
+    }
+    if (!changed)
+        return false;
+
+    updateVariableOrder(newOrder);
+
+    return true;
+}
+
+template<class Base>
+inline void CodeHandler<Base>::partitionOperations(size_t partitionSize) {
+    const size_t nOps = _variableOrder.size();
+    const size_t nParts = (nOps + partitionSize - 1) / partitionSize;
+    if (nParts < 2 || !isSchedulable()) {
+        return;
+    }
+
+    /**
+     * dependencies between operations in the evaluation queue
+     */
+    findVariableDependencies();
+
+    std::vector<std::vector<size_t> > preds(nOps);
+    std::vector<std::vector<size_t> > succs(nOps);
+    for (size_t i = 0; i < nOps; ++i) {
+        for (Node* d : _variableDependencies[i]) {
+            size_t pos = getEvaluationOrder(*d);
+            if (pos > 0 && pos <= nOps && _variableOrder[pos - 1] == d) {
+                preds[i].push_back(pos - 1);
+                succs[pos - 1].push_back(i);
+            }
+        }
+    }
+    _variableDependencies.clear();
+
+    /**
+     * the compilation cost of each assignment is estimated by the number
+     * of operations in its expression
+     */
+    std::vector<size_t> cost(nOps, 1);
+    size_t totalCost = 0;
+    for (size_t i = 0; i < nOps; ++i) {
+        for (const auto& a : *_variableOrder[i]) {
+            if (a.getOperation() != nullptr && _varId[*a.getOperation()] == 0) {
+                cost[i] += _operationCount[*a.getOperation()];
+            }
+        }
+        totalCost += cost[i];
+    }
+    const size_t partCost = (totalCost + nParts - 1) / nParts;
+
+    /**
+     * greedy graph growing: an operation is added to the current part when
+     * all of its arguments were already evaluated giving priority to the
+     * operations with more arguments in the current part (cut edges which
+     * are avoided)
+     */
+    struct ReadyOp {
+        size_t gain; // number of arguments in the current part
+        size_t op; // position in the original evaluation order
+
+        inline bool operator<(const ReadyOp& o) const {
+            if (gain != o.gain) return gain < o.gain;
+            return op > o.op; // keep the original order
+        }
+    };
+
+    std::vector<size_t> gain(nOps, 0); // number of arguments in the part gainPart
+    std::vector<size_t> gainPart(nOps, 0);
+    std::vector<size_t> missingArgs(nOps); // predecessors not evaluated yet
+    for (size_t i = 0; i < nOps; ++i) {
+        missingArgs[i] = preds[i].size();
+    }
+
+    std::vector<ReadyOp> ready;
+    ready.reserve(nOps);
+    for (size_t i = 0; i < nOps; ++i) {
+        if (missingArgs[i] == 0) {
+            ready.push_back(ReadyOp{0, i});
+        }
+    }
+    std::make_heap(ready.begin(), ready.end());
+
+    std::vector<Node*> newOrder;
+    newOrder.reserve(nOps);
+    _partitionStarts.clear();
+
+    size_t currentPart = 0;
+    size_t currentCost = 0;
+
+    while (!ready.empty()) {
+        std::pop_heap(ready.begin(), ready.end());
+        ReadyOp r = ready.back();
+        ready.pop_back();
+
+        if (currentCost >= partCost && currentPart + 1 < nParts) {
+            /**
+             * start a new part (no argument is in the new part)
+             */
+            currentPart++;
+            currentCost = 0;
+            _partitionStarts.push_back(newOrder.size());
+
+            ready.push_back(r);
+            for (ReadyOp& o : ready) {
+                o.gain = 0;
+            }
+            std::make_heap(ready.begin(), ready.end());
+            continue;
+        }
+
+        currentCost += cost[r.op];
+        newOrder.push_back(_variableOrder[r.op]);
+
+        for (size_t s : succs[r.op]) {
+            if (gainPart[s] != currentPart) {
+                gainPart[s] = currentPart;
+                gain[s] = 0;
+            }
+            gain[s]++;
+            missingArgs[s]--;
+            if (missingArgs[s] == 0) {
+                ready.push_back(ReadyOp{gain[s], s});
+                std::push_heap(ready.begin(), ready.end());
+            }
+        }
+    }
+
+    CPPADCG_ASSERT_UNKNOWN(newOrder.size() == nOps)
+
+    updateVariableOrder(newOrder);
+}
+
+template<class Base>
+inline void CodeHandler<Base>::updateVariableOrder(std::vector<Node*>& newOrder) {
+    _variableOrder.swap(newOrder);
+
+    /**
+     * update the evaluation order
+     */
+    _evaluationOrder.fill(0);
+    for (size_t p = 0; p < _variableOrder.size(); p++) {
+        Node& arg = *_variableOrder[p];
+        setEvaluationOrder(arg, p + 1);
+        dependentAdded2EvaluationQueue(arg);
+    }
+
+    /**
+     * temporary variables IDs follow the evaluation order
+     * (IDs are redefined later if they are reused)
+     */
+    if (!_reuseIDs) {
+        size_t id = _minTemporaryVarID;
+        for (Node* node : _variableOrder) {
+            if (isTemporary(*node)) {
+                _varId[*node] = id++;
+            }
+        }
+        CPPADCG_ASSERT_UNKNOWN(id == _idCount)
+    }
+}
+
 template<class Base>
 inline void CodeHandler<Base>::reorderOperations(ArrayView<CGB>& dependent) {
     // determine the location of the last temporary variable used for each dependent
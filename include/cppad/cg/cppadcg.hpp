@@ -32,6 +32,7 @@ static_assert(false,
 #include <array>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <cerrno>
 #include <fstream>
 #include <iomanip>
@@ -55,7 +56,11 @@ static_assert(false,
 #include <cstring>
 #include <chrono>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
 #include <functional>
+#include <type_traits>
 
 // ---------------------------------------------------------------------------
 // operating system detection
@@ -127,6 +132,7 @@ static_assert(false,
 #include <cppad/cg/atomic_dependency_locator.hpp>
 #include <cppad/cg/variable_name_generator.hpp>
 #include <cppad/cg/job_timer.hpp>
+#include <cppad/cg/job_profiler.hpp>
 #include <cppad/cg/lang/language.hpp>
 #include <cppad/cg/lang/lang_stream_stack.hpp>
 #include <cppad/cg/scope_path_element.hpp>
@@ -174,6 +180,9 @@ static_assert(false,
 #include <cppad/cg/solver.hpp>
 #include <cppad/cg/collect_variable.hpp>
 #include <cppad/cg/graph_mod.hpp>
+#include <cppad/cg/graph_sparsity.hpp>
+#include <cppad/cg/graph_serializer.hpp>
+#include <cppad/cg/task_graph.hpp>
 #include <cppad/cg/operation_node_name_streambuf.hpp>
 
 // ---------------------------------------------------------------------------
@@ -208,6 +217,7 @@ static_assert(false,
 #include <cppad/cg/lang/c/lang_c_default_var_name_gen.hpp>
 #include <cppad/cg/lang/c/lang_c_default_hessian_var_name_gen.hpp>
 #include <cppad/cg/lang/c/lang_c_default_reverse2_var_name_gen.hpp>
+#include <cppad/cg/lang/c/lang_c_workspace_var_name_gen.hpp>
 #include <cppad/cg/lang/c/lang_c_custom_var_name_gen.hpp>
 #include <cppad/cg/lang/c/lang_c_util.hpp>
 
@@ -215,8 +225,8 @@ static_assert(false,
 #include <cppad/cg/model/threadpool/multi_threading_type.hpp>
 #include <cppad/cg/model/threadpool/thread_pool_schedule_strategy.hpp>
 #include <cppad/cg/model/external_function_wrapper.hpp>
-#include <cppad/cg/model/atomic_external_function_wrapper.hpp>
 #include <cppad/cg/model/generic_model_external_function_wrapper.hpp>
+#include <cppad/cg/model/atomic_external_function_wrapper.hpp>
 #include <cppad/cg/model/model_library_processor.hpp>
 #include <cppad/cg/model/model_library.hpp>
 #include <cppad/cg/model/generic_model.hpp>
@@ -239,6 +249,9 @@ static_assert(false,
 #include <cppad/cg/model/threadpool/pthread_pool_h.hpp>
 #include <cppad/cg/model/threadpool/openmp_c.hpp>
 #include <cppad/cg/model/threadpool/openmp_h.hpp>
+#include <cppad/cg/model/threadpool/host_executor_c.hpp>
+#include <cppad/cg/model/threadpool/host_executor_h.hpp>
+#include <cppad/cg/model/source_sink.hpp>
 #include <cppad/cg/model/model_c_source_gen.hpp>
 #include <cppad/cg/model/model_c_source_gen_impl.hpp>
 #include <cppad/cg/model/model_library_c_source_gen.hpp>
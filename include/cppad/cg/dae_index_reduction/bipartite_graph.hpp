@@ -16,6 +16,7 @@
  */
 
 #include <cppad/cg/dae_index_reduction/bipartite_nodes.hpp>
+#include <cppad/cg/dae_index_reduction/bipartite_matching.hpp>
 #include <cppad/cg/dae_index_reduction/dae_equation_info.hpp>
 #include <cppad/cg/dae_index_reduction/time_diff.hpp>
 
@@ -371,6 +372,89 @@ public:
         logger_.log() << "\n   Degrees of freedom: " << vnodes_.size() - enodes_.size() << std::endl;
     }
 
+    /**
+     * Updates the structure of a matching with the current equations and
+     * variables which were not deleted from this graph.
+     * Assignments in the matching which are still valid are kept.
+     *
+     * @param matching the matching to update (the equation and variable
+     *                 indexes are the ones of the nodes in this graph)
+     */
+    inline void updateMatching(BipartiteMatching& matching) const {
+        std::vector<size_t> eqStart;
+        eqStart.reserve(enodes_.size() + 1);
+        eqStart.push_back(0);
+        std::vector<size_t> eqVars;
+        for (const Enode<Base>* i : enodes_) {
+            for (const Vnode<Base>* j : i->variables()) {
+                eqVars.push_back(j->index());
+            }
+            eqStart.push_back(eqVars.size());
+        }
+
+        matching.setStructure(vnodes_.size(), std::move(eqStart), std::move(eqVars));
+    }
+
+    /**
+     * Assigns equations to variables with a maximum matching of the
+     * current graph (Hopcroft-Karp) which starts from the assignments
+     * already defined in the nodes.
+     * Variables which were already assigned remain assigned (possibly to
+     * a different equation).
+     *
+     * @param matching the matching used to hold the structure (it can be
+     *                 reused in later calls)
+     * @return the number of assigned equations
+     */
+    inline size_t assignEquations(BipartiteMatching& matching) {
+        updateMatching(matching);
+
+        for (size_t i = 0; i < enodes_.size(); i++) {
+            Vnode<Base>* j = enodes_[i]->assignmentVariable();
+            if (j != nullptr && !j->isDeleted() && j->assignmentEquation() == enodes_[i]) {
+                matching.assign(i, j->index());
+            }
+        }
+
+        size_t n = matching.match();
+
+        for (size_t i = 0; i < enodes_.size(); i++) {
+            size_t j = matching.matchedVariable(i);
+            if (j != BipartiteMatching::UNMATCHED) {
+                Vnode<Base>* jj = vnodes_[j];
+                if (jj->assignmentEquation() != enodes_[i]) {
+                    jj->setAssignmentEquation(*enodes_[i], logger_.log(), logger_.getVerbosity());
+                }
+            }
+        }
+
+        return n;
+    }
+
+    /**
+     * Determines the Dulmage-Mendelsohn decomposition of the current graph
+     * (ignoring deleted variables).
+     * The structurally well-determined part is also sorted into a block
+     * lower triangular form which can be used to process independent
+     * blocks of equations separately.
+     * The assignments in the nodes are not modified.
+     */
+    inline DulmageMendelsohn dulmageMendelsohn() const {
+        BipartiteMatching matching;
+        updateMatching(matching);
+
+        for (size_t i = 0; i < enodes_.size(); i++) {
+            Vnode<Base>* j = enodes_[i]->assignmentVariable();
+            if (j != nullptr && !j->isDeleted() && j->assignmentEquation() == enodes_[i]) {
+                matching.assign(i, j->index());
+            }
+        }
+
+        matching.match();
+
+        return matching.dulmageMendelsohn();
+    }
+
     inline void uncolorAll() {
         for (Vnode<Base>* j : vnodes_) {
             j->uncolor();
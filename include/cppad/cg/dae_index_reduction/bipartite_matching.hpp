@@ -0,0 +1,583 @@
+#ifndef CPPAD_CG_BIPARTITE_MATCHING_INCLUDED
+#define CPPAD_CG_BIPARTITE_MATCHING_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Ciengis
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * A block lower triangular (BLT) ordering of a structurally non-singular
+ * system of equations.
+ * Each block only depends on the variables of the previous blocks and on
+ * its own variables and therefore the blocks can be solved in sequence.
+ */
+struct BltDecomposition {
+    /**
+     * the equations sorted by block
+     */
+    std::vector<size_t> equations;
+    /**
+     * the variable assigned to each equation (same order as the equations)
+     */
+    std::vector<size_t> variables;
+    /**
+     * the position of the first equation of each block in equations
+     * (it also contains the total number of equations at the end)
+     */
+    std::vector<size_t> blockStart;
+
+    inline size_t blockCount() const {
+        return blockStart.empty() ? 0 : blockStart.size() - 1;
+    }
+
+    inline size_t blockSize(size_t b) const {
+        return blockStart[b + 1] - blockStart[b];
+    }
+};
+
+/**
+ * The Dulmage-Mendelsohn decomposition of a system of equations.
+ */
+struct DulmageMendelsohn {
+    /**
+     * equations in the structurally under-determined part
+     * (with more variables than equations)
+     */
+    std::vector<size_t> underEquations;
+    /**
+     * variables in the structurally under-determined part
+     */
+    std::vector<size_t> underVariables;
+    /**
+     * equations in the structurally over-determined part
+     * (with more equations than variables)
+     */
+    std::vector<size_t> overEquations;
+    /**
+     * variables in the structurally over-determined part
+     */
+    std::vector<size_t> overVariables;
+    /**
+     * the structurally well-determined (square) part
+     */
+    BltDecomposition square;
+};
+
+/**
+ * Maximum matching between the equations and the variables of a system
+ * of equations.
+ * The incidence structure is kept in compact adjacency arrays (one list
+ * of variable indexes per equation) and the matching is determined with the
+ * Hopcroft-Karp algorithm.
+ * The current matching is kept when the structure is updated (e.g. after
+ * equations are differentiated) so that only the unmatched equations have
+ * to be processed again.
+ *
+ * @author Joao Leal
+ */
+class BipartiteMatching {
+public:
+    static const size_t UNMATCHED = (std::numeric_limits<size_t>::max)();
+protected:
+    // the number of variables
+    size_t nVars_;
+    // the position of the first variable of each equation in eqVars_ (CSR)
+    std::vector<size_t> eqStart_;
+    // the variables of each equation
+    std::vector<size_t> eqVars_;
+    // the variable assigned to each equation
+    std::vector<size_t> eqMatch_;
+    // the equation assigned to each variable
+    std::vector<size_t> varMatch_;
+    // auxiliary data used by the Hopcroft-Karp algorithm
+    std::vector<size_t> dist_;
+    std::vector<size_t> next_;
+    std::vector<size_t> queue_;
+    std::vector<size_t> stack_;
+public:
+
+    inline BipartiteMatching() :
+        nVars_(0),
+        eqStart_(1, 0) {
+    }
+
+    inline size_t equationCount() const {
+        return eqStart_.size() - 1;
+    }
+
+    inline size_t variableCount() const {
+        return nVars_;
+    }
+
+    /**
+     * Removes all equations and variables.
+     */
+    inline void clear() {
+        nVars_ = 0;
+        eqStart_.assign(1, 0);
+        eqVars_.clear();
+        eqMatch_.clear();
+        varMatch_.clear();
+    }
+
+    /**
+     * Adds new variables to the system.
+     *
+     * @param n the number of new variables
+     */
+    inline void addVariables(size_t n) {
+        nVars_ += n;
+        varMatch_.resize(nVars_, size_t(UNMATCHED));
+    }
+
+    /**
+     * Adds a new equation to the system.
+     *
+     * @param vars the indexes of the variables present in the equation
+     * @return the index of the new equation
+     */
+    template<class VectorSize>
+    inline size_t addEquation(const VectorSize& vars) {
+        for (size_t j : vars) {
+            CPPADCG_ASSERT_KNOWN(j < nVars_, "Invalid variable index")
+            eqVars_.push_back(j);
+        }
+        eqStart_.push_back(eqVars_.size());
+        eqMatch_.push_back(size_t(UNMATCHED));
+        return eqStart_.size() - 2;
+    }
+
+    /**
+     * Replaces the structure of the system.
+     * The current assignments which are still valid in the new structure
+     * are kept.
+     *
+     * @param nVars the number of variables
+     * @param eqStart the position of the first variable of each equation in
+     *                eqVars (the last element is the size of eqVars)
+     * @param eqVars the variables of each equation
+     */
+    inline void setStructure(size_t nVars,
+                             std::vector<size_t> eqStart,
+                             std::vector<size_t> eqVars) {
+        CPPADCG_ASSERT_KNOWN(!eqStart.empty() && eqStart.back() == eqVars.size(), "Invalid equation structure")
+
+        nVars_ = nVars;
+        eqStart_ = std::move(eqStart);
+        eqVars_ = std::move(eqVars);
+
+        size_t nEqs = equationCount();
+        eqMatch_.resize(nEqs, size_t(UNMATCHED));
+        varMatch_.assign(nVars_, size_t(UNMATCHED));
+
+        for (size_t i = 0; i < nEqs; i++) {
+            size_t j = eqMatch_[i];
+            if (j == UNMATCHED)
+                continue;
+
+            bool valid = j < nVars_ && varMatch_[j] == UNMATCHED &&
+                    std::find(eqVars_.begin() + eqStart_[i], eqVars_.begin() + eqStart_[i + 1], j) != eqVars_.begin() + eqStart_[i + 1];
+            if (valid) {
+                varMatch_[j] = i;
+            } else {
+                eqMatch_[i] = UNMATCHED;
+            }
+        }
+    }
+
+    /**
+     * Defines an assignment between an equation and a variable
+     * (e.g. one which is already known from a previous matching).
+     * Any previous assignment of the equation or the variable is removed.
+     */
+    inline void assign(size_t eq,
+                       size_t var) {
+        CPPADCG_ASSERT_KNOWN(eq < equationCount() && var < nVars_, "Invalid assignment")
+        unassignEquation(eq);
+        if (varMatch_[var] != UNMATCHED)
+            eqMatch_[varMatch_[var]] = UNMATCHED;
+
+        eqMatch_[eq] = var;
+        varMatch_[var] = eq;
+    }
+
+    /**
+     * Removes the assignment of an equation.
+     */
+    inline void unassignEquation(size_t eq) {
+        size_t j = eqMatch_[eq];
+        if (j != UNMATCHED) {
+            varMatch_[j] = UNMATCHED;
+            eqMatch_[eq] = UNMATCHED;
+        }
+    }
+
+    /**
+     * @return the variable assigned to an equation or UNMATCHED
+     */
+    inline size_t matchedVariable(size_t eq) const {
+        return eqMatch_[eq];
+    }
+
+    /**
+     * @return the equation assigned to a variable or UNMATCHED
+     */
+    inline size_t matchedEquation(size_t var) const {
+        return varMatch_[var];
+    }
+
+    /**
+     * @return the number of assigned equations
+     */
+    inline size_t matchingSize() const {
+        size_t n = 0;
+        for (size_t j : eqMatch_) {
+            if (j != UNMATCHED)
+                n++;
+        }
+        return n;
+    }
+
+    /**
+     * Determines a maximum matching with the Hopcroft-Karp algorithm.
+     * Existing assignments are used as the starting point and therefore
+     * only unassigned equations are searched when the structure is only
+     * slightly changed.
+     *
+     * @return the number of assigned equations
+     */
+    inline size_t match() {
+        const size_t nEqs = equationCount();
+        eqMatch_.resize(nEqs, size_t(UNMATCHED));
+        varMatch_.resize(nVars_, size_t(UNMATCHED));
+
+        // cheap initial assignment
+        for (size_t i = 0; i < nEqs; i++) {
+            if (eqMatch_[i] != UNMATCHED)
+                continue;
+            for (size_t e = eqStart_[i]; e < eqStart_[i + 1]; e++) {
+                size_t j = eqVars_[e];
+                if (varMatch_[j] == UNMATCHED) {
+                    eqMatch_[i] = j;
+                    varMatch_[j] = i;
+                    break;
+                }
+            }
+        }
+
+        dist_.resize(nEqs);
+        next_.resize(nEqs);
+
+        while (buildLayers()) {
+            for (size_t i = 0; i < nEqs; i++) {
+                next_[i] = eqStart_[i];
+            }
+
+            size_t augmented = 0;
+            for (size_t i = 0; i < nEqs; i++) {
+                if (eqMatch_[i] == UNMATCHED && augment(i))
+                    augmented++;
+            }
+
+            if (augmented == 0)
+                break;
+        }
+
+        return matchingSize();
+    }
+
+    /**
+     * Determines the Dulmage-Mendelsohn decomposition of the system using
+     * the current matching, which must be a maximum matching
+     * (see match()).
+     * The square part is also ordered into a block lower triangular form.
+     */
+    inline DulmageMendelsohn dulmageMendelsohn() const {
+        const size_t nEqs = equationCount();
+
+        // variables to equations (transpose)
+        std::vector<size_t> varStart(nVars_ + 1, 0);
+        for (size_t j : eqVars_)
+            varStart[j + 1]++;
+        for (size_t j = 0; j < nVars_; j++)
+            varStart[j + 1] += varStart[j];
+        std::vector<size_t> varEqs(eqVars_.size());
+        std::vector<size_t> pos(varStart.begin(), varStart.end() - 1);
+        for (size_t i = 0; i < nEqs; i++) {
+            for (size_t e = eqStart_[i]; e < eqStart_[i + 1]; e++) {
+                varEqs[pos[eqVars_[e]]++] = i;
+            }
+        }
+
+        std::vector<bool> eqVisited(nEqs, false);
+        std::vector<bool> varVisited(nVars_, false);
+        std::vector<size_t> stack;
+
+        DulmageMendelsohn dm;
+
+        /**
+         * under-determined: reachable from unassigned variables through
+         * alternating paths (variable -> equation -> assigned variable)
+         */
+        for (size_t j0 = 0; j0 < nVars_; j0++) {
+            if (varMatch_[j0] != UNMATCHED || varVisited[j0])
+                continue;
+            varVisited[j0] = true;
+            dm.underVariables.push_back(j0);
+            stack.push_back(j0);
+            while (!stack.empty()) {
+                size_t j = stack.back();
+                stack.pop_back();
+                for (size_t e = varStart[j]; e < varStart[j + 1]; e++) {
+                    size_t i = varEqs[e];
+                    if (eqVisited[i])
+                        continue;
+                    eqVisited[i] = true;
+                    dm.underEquations.push_back(i);
+                    size_t jj = eqMatch_[i];
+                    if (jj != UNMATCHED && !varVisited[jj]) {
+                        varVisited[jj] = true;
+                        dm.underVariables.push_back(jj);
+                        stack.push_back(jj);
+                    }
+                }
+            }
+        }
+
+        /**
+         * over-determined: reachable from unassigned equations through
+         * alternating paths (equation -> variable -> assigned equation)
+         */
+        for (size_t i0 = 0; i0 < nEqs; i0++) {
+            if (eqMatch_[i0] != UNMATCHED || eqVisited[i0])
+                continue;
+            eqVisited[i0] = true;
+            dm.overEquations.push_back(i0);
+            stack.push_back(i0);
+            while (!stack.empty()) {
+                size_t i = stack.back();
+                stack.pop_back();
+                for (size_t e = eqStart_[i]; e < eqStart_[i + 1]; e++) {
+                    size_t j = eqVars_[e];
+                    if (varVisited[j])
+                        continue;
+                    varVisited[j] = true;
+                    dm.overVariables.push_back(j);
+                    size_t ii = varMatch_[j];
+                    if (ii != UNMATCHED && !eqVisited[ii]) {
+                        eqVisited[ii] = true;
+                        dm.overEquations.push_back(ii);
+                        stack.push_back(ii);
+                    }
+                }
+            }
+        }
+
+        std::sort(dm.underEquations.begin(), dm.underEquations.end());
+        std::sort(dm.underVariables.begin(), dm.underVariables.end());
+        std::sort(dm.overEquations.begin(), dm.overEquations.end());
+        std::sort(dm.overVariables.begin(), dm.overVariables.end());
+
+        /**
+         * square part
+         */
+        std::vector<bool> inSquare(nEqs, false);
+        for (size_t i = 0; i < nEqs; i++) {
+            inSquare[i] = !eqVisited[i];
+        }
+        blockTriangular(inSquare, dm.square);
+
+        return dm;
+    }
+
+    /**
+     * Orders the equations into a block lower triangular form using the
+     * current matching, which must assign all equations.
+     */
+    inline BltDecomposition blockTriangular() const {
+        std::vector<bool> inSquare(equationCount(), true);
+        BltDecomposition blt;
+        blockTriangular(inSquare, blt);
+        return blt;
+    }
+
+protected:
+
+    /**
+     * Determines the distance of each equation from the unassigned
+     * equations in alternating paths (breadth-first search).
+     *
+     * @return true if there is an augmenting path
+     */
+    inline bool buildLayers() {
+        const size_t nEqs = equationCount();
+        const size_t inf = UNMATCHED;
+
+        queue_.clear();
+        for (size_t i = 0; i < nEqs; i++) {
+            if (eqMatch_[i] == UNMATCHED) {
+                dist_[i] = 0;
+                queue_.push_back(i);
+            } else {
+                dist_[i] = inf;
+            }
+        }
+
+        bool found = false;
+        for (size_t q = 0; q < queue_.size(); q++) {
+            size_t i = queue_[q];
+            for (size_t e = eqStart_[i]; e < eqStart_[i + 1]; e++) {
+                size_t k = varMatch_[eqVars_[e]];
+                if (k == UNMATCHED) {
+                    found = true;
+                } else if (dist_[k] == inf) {
+                    dist_[k] = dist_[i] + 1;
+                    queue_.push_back(k);
+                }
+            }
+        }
+
+        return found;
+    }
+
+    /**
+     * Searches for an augmenting path starting at an unassigned equation
+     * following the layers (iterative depth-first search).
+     *
+     * @return true if the path was found and the assignments were updated
+     */
+    inline bool augment(size_t root) {
+        const size_t inf = UNMATCHED;
+
+        stack_.clear();
+        stack_.push_back(root);
+
+        while (!stack_.empty()) {
+            size_t i = stack_.back();
+
+            if (next_[i] == eqStart_[i + 1]) {
+                // dead end
+                dist_[i] = inf;
+                stack_.pop_back();
+                if (!stack_.empty())
+                    next_[stack_.back()]++;
+                continue;
+            }
+
+            size_t j = eqVars_[next_[i]];
+            size_t k = varMatch_[j];
+            if (k == UNMATCHED) {
+                // flip the assignments along the path
+                for (size_t l = stack_.size(); l-- > 0;) {
+                    size_t ii = stack_[l];
+                    size_t jj = eqVars_[next_[ii]];
+                    eqMatch_[ii] = jj;
+                    varMatch_[jj] = ii;
+                }
+                return true;
+            } else if (dist_[k] != inf && dist_[k] == dist_[i] + 1) {
+                stack_.push_back(k);
+            } else {
+                next_[i]++;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * Determines the strongly connected components of the equations
+     * (Tarjan's algorithm) where equation i depends on equation k if
+     * i uses the variable assigned to k.
+     * The components are created in a valid solution order.
+     */
+    inline void blockTriangular(const std::vector<bool>& include,
+                                BltDecomposition& blt) const {
+        const size_t nEqs = equationCount();
+        const size_t none = UNMATCHED;
+
+        blt.equations.clear();
+        blt.variables.clear();
+        blt.blockStart.assign(1, 0);
+
+        std::vector<size_t> index(nEqs, none);
+        std::vector<size_t> low(nEqs, 0);
+        std::vector<bool> onStack(nEqs, false);
+        std::vector<size_t> sccStack;
+        std::vector<std::pair<size_t, size_t> > callStack; // (equation, next edge)
+        size_t counter = 0;
+
+        for (size_t i0 = 0; i0 < nEqs; i0++) {
+            if (!include[i0] || index[i0] != none)
+                continue;
+
+            CPPADCG_ASSERT_KNOWN(eqMatch_[i0] != UNMATCHED, "All equations must be assigned to a variable")
+
+            index[i0] = low[i0] = counter++;
+            sccStack.push_back(i0);
+            onStack[i0] = true;
+            callStack.emplace_back(i0, eqStart_[i0]);
+
+            while (!callStack.empty()) {
+                size_t i = callStack.back().first;
+                size_t& e = callStack.back().second;
+
+                if (e < eqStart_[i + 1]) {
+                    size_t k = varMatch_[eqVars_[e]];
+                    e++;
+                    if (k == UNMATCHED || k == i || !include[k])
+                        continue;
+
+                    if (index[k] == none) {
+                        CPPADCG_ASSERT_KNOWN(eqMatch_[k] != UNMATCHED, "All equations must be assigned to a variable")
+                        index[k] = low[k] = counter++;
+                        sccStack.push_back(k);
+                        onStack[k] = true;
+                        callStack.emplace_back(k, eqStart_[k]);
+                    } else if (onStack[k]) {
+                        low[i] = (std::min)(low[i], index[k]);
+                    }
+                    continue;
+                }
+
+                // all dependencies visited
+                callStack.pop_back();
+                if (!callStack.empty()) {
+                    size_t parent = callStack.back().first;
+                    low[parent] = (std::min)(low[parent], low[i]);
+                }
+
+                if (low[i] == index[i]) {
+                    // new block
+                    size_t k;
+                    do {
+                        k = sccStack.back();
+                        sccStack.pop_back();
+                        onStack[k] = false;
+                        blt.equations.push_back(k);
+                        blt.variables.push_back(eqMatch_[k]);
+                    } while (k != i);
+                    blt.blockStart.push_back(blt.equations.size());
+                }
+            }
+        }
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -0,0 +1,516 @@
+#ifndef CPPAD_CG_DAE_MODEL_C_SOURCE_GEN_INCLUDED
+#define CPPAD_CG_DAE_MODEL_C_SOURCE_GEN_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Ciengis
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+#include <cppad/cg/dae_index_reduction/dae_index_reduction.hpp>
+#include <cppad/cg/dae_index_reduction/bipartite_matching.hpp>
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Prepares the source code generation of a DAE system (typically the
+ * result of an index reduction) while preserving its block lower
+ * triangular (BLT) structure.
+ *
+ * The implicit equations are reordered into a BLT form where the unknowns
+ * of each equation are the states and algebraic variables, and the time
+ * derivatives are associated with their anti-derivatives (the same
+ * structure as the iteration matrix dF/dy + alpha dF/dy' of implicit
+ * integrators).
+ * Explicit equations of semi-explicit DAE systems (dx/dt = f(x, y)) are
+ * placed after the implicit equations.
+ *
+ * A model is created for the complete system with the residuals in BLT
+ * order and an additional model is created for each block with the
+ * residuals of that block and a sparse Jacobian restricted to the
+ * unknowns of the block (and their time derivatives), which can be used to
+ * solve the system block by block.
+ * Each model can also provide the iteration matrix dF/dy + alpha dF/dy'
+ * with the columns of the unknowns in BLT order.
+ * All models use the same independent variables as the original DAE.
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class DaeModelCSourceGen {
+public:
+    using CGBase = CG<Base>;
+    using ADCG = CppAD::AD<CGBase>;
+protected:
+    /**
+     * the original DAE model
+     */
+    ADFun<CGBase>& fun_;
+    /**
+     * DAE variable information
+     */
+    const std::vector<DaeVarInfo> varInfo_;
+    /**
+     * DAE equation information
+     */
+    const std::vector<DaeEquationInfo> eqInfo_;
+    /**
+     * the name of the model
+     */
+    const std::string name_;
+    /**
+     * typical values of the independent variables (used when taping)
+     */
+    std::vector<Base> x_;
+    /**
+     * whether or not to create a model for each block
+     */
+    bool createBlockModels_;
+    /**
+     * whether or not to create a sparse Jacobian for the complete system
+     */
+    bool createJacobian_;
+    /**
+     * whether or not to create the iteration matrix dF/dy + alpha dF/dy'
+     */
+    bool createIterationMatrix_;
+    /**
+     * the unknown associated with each DAE variable (-1 for the integrated
+     * variable, parameters, states of explicit equations, and time
+     * derivatives which are not differentiated)
+     */
+    std::vector<int> var2Unknown_;
+    /**
+     * the DAE variable of each unknown
+     */
+    std::vector<size_t> unknowns_;
+    /**
+     * the BLT decomposition of the implicit equations
+     */
+    BltDecomposition blt_;
+    /**
+     * the new equation order (original equation indexes)
+     */
+    std::vector<size_t> eqOrder_;
+    std::vector<DaeEquationInfo> newEqInfo_;
+    std::unique_ptr<ADFun<CGBase> > bltFun_;
+    std::unique_ptr<ModelCSourceGen<Base> > model_;
+    std::vector<std::unique_ptr<ADFun<CGBase> > > blockFun_;
+    std::vector<std::unique_ptr<ModelCSourceGen<Base> > > blockModels_;
+public:
+
+    /**
+     * Creates a new helper for the source code generation of a DAE model.
+     *
+     * @param fun the DAE model (it must be kept alive while this object is
+     *            used)
+     * @param varInfo DAE variable information
+     * @param eqInfo DAE equation information
+     * @param model the model name (also used as prefix for the block
+     *              models)
+     */
+    inline DaeModelCSourceGen(ADFun<CGBase>& fun,
+                              const std::vector<DaeVarInfo>& varInfo,
+                              const std::vector<DaeEquationInfo>& eqInfo,
+                              std::string model) :
+        fun_(fun),
+        varInfo_(varInfo),
+        eqInfo_(eqInfo),
+        name_(std::move(model)),
+        createBlockModels_(true),
+        createJacobian_(true),
+        createIterationMatrix_(true) {
+        CPPADCG_ASSERT_KNOWN(fun_.Domain() == varInfo_.size(), "The number of variables in varInfo must match the model domain")
+        CPPADCG_ASSERT_KNOWN(fun_.Range() == eqInfo_.size(), "The number of equations in eqInfo must match the model range")
+    }
+
+    DaeModelCSourceGen(const DaeModelCSourceGen& orig) = delete;
+    DaeModelCSourceGen& operator=(const DaeModelCSourceGen& rhs) = delete;
+
+    inline const std::string& getName() const {
+        return name_;
+    }
+
+    /**
+     * Defines typical values for the independent variables which are used
+     * when the models are taped (e.g. for conditional expressions).
+     *
+     * @param x the independent variable values
+     */
+    template<class VectorBase>
+    inline void setTypicalIndependentValues(const VectorBase& x) {
+        CPPADCG_ASSERT_KNOWN(x.size() == 0 || x.size() == varInfo_.size(), "Invalid independent variable vector size")
+        x_ = std::vector<Base>(x.size());
+        for (size_t j = 0; j < x_.size(); j++) {
+            x_[j] = x[j];
+        }
+    }
+
+    inline bool isCreateBlockModels() const {
+        return createBlockModels_;
+    }
+
+    /**
+     * Defines whether or not to create a model for each block of the BLT
+     * decomposition.
+     *
+     * @param create true to create the block models
+     */
+    inline void setCreateBlockModels(bool create) {
+        createBlockModels_ = create;
+    }
+
+    inline bool isCreateJacobian() const {
+        return createJacobian_;
+    }
+
+    /**
+     * Defines whether or not to create a sparse Jacobian of the complete
+     * system (relative to all unknowns and their time derivatives).
+     *
+     * @param create true to create the sparse Jacobian
+     */
+    inline void setCreateJacobian(bool create) {
+        createJacobian_ = create;
+    }
+
+    inline bool isCreateIterationMatrix() const {
+        return createIterationMatrix_;
+    }
+
+    /**
+     * Defines whether or not to create the sparse iteration matrix
+     * dF/dy + alpha dF/dy' of the complete system and of each block, where
+     * y are the unknowns in BLT order (see
+     * ModelCSourceGen::setCreateSparseIterationMatrix()).
+     *
+     * @param create true to create the iteration matrices
+     */
+    inline void setCreateIterationMatrix(bool create) {
+        createIterationMatrix_ = create;
+    }
+
+    /**
+     * Provides the BLT decomposition of the implicit equations.
+     * Equations are indexes in the original model and variables are
+     * DAE variable indexes of states and algebraic variables.
+     */
+    inline const BltDecomposition& getBlockTriangularForm() {
+        prepare();
+        return blt_;
+    }
+
+    /**
+     * Provides the equation order used by the generated models: the
+     * original index of each residual in the complete model.
+     */
+    inline const std::vector<size_t>& getEquationOrder() {
+        prepare();
+        return eqOrder_;
+    }
+
+    /**
+     * Provides the equation information in the order used by the generated
+     * models.
+     */
+    inline const std::vector<DaeEquationInfo>& getEquationInfo() {
+        prepare();
+        return newEqInfo_;
+    }
+
+    /**
+     * Provides the name of the model with the residuals of a block.
+     *
+     * @param b the block index
+     */
+    inline std::string getBlockModelName(size_t b) const {
+        return name_ + "_block" + std::to_string(b);
+    }
+
+    /**
+     * Provides the model for the complete system (residuals in BLT order).
+     */
+    inline ModelCSourceGen<Base>& getModel() {
+        prepare();
+        return *model_;
+    }
+
+    /**
+     * Provides the models for each block (empty if they are not created).
+     */
+    inline std::vector<ModelCSourceGen<Base>*> getBlockModels() {
+        prepare();
+        std::vector<ModelCSourceGen<Base>*> models(blockModels_.size());
+        for (size_t b = 0; b < blockModels_.size(); b++)
+            models[b] = blockModels_[b].get();
+        return models;
+    }
+
+    /**
+     * Adds the block models to a model library (typically created with
+     * the model from getModel()).
+     *
+     * @param library the model library source code generator
+     */
+    inline void addBlockModels(ModelLibraryCSourceGen<Base>& library) {
+        prepare();
+        for (auto& m : blockModels_)
+            library.addModel(*m);
+    }
+
+    inline virtual ~DaeModelCSourceGen() = default;
+
+protected:
+
+    /**
+     * Determines the BLT decomposition and creates the models
+     * (only once).
+     */
+    inline void prepare() {
+        if (model_ != nullptr)
+            return;
+
+        size_t n = varInfo_.size();
+        size_t m = eqInfo_.size();
+
+        /**
+         * determine the unknowns
+         */
+        std::vector<bool> explicitState(n, false);
+        for (size_t i = 0; i < m; i++) {
+            if (eqInfo_[i].isExplicit() && eqInfo_[i].getAssignedVarIndex() >= 0)
+                explicitState[eqInfo_[i].getAssignedVarIndex()] = true;
+        }
+
+        std::vector<bool> hasDerivative(n, false);
+        for (size_t j = 0; j < n; j++) {
+            int a = varInfo_[j].getAntiDerivative();
+            if (a >= 0)
+                hasDerivative[a] = true;
+        }
+
+        // time derivatives are only unknowns if they also have a time derivative
+        var2Unknown_.assign(n, -1);
+        unknowns_.clear();
+        for (size_t j = 0; j < n; j++) {
+            const DaeVarInfo& v = varInfo_[j];
+            if (v.isFunctionOfIntegrated() && !v.isIntegratedVariable() && !explicitState[j] &&
+                (v.getAntiDerivative() < 0 || hasDerivative[j])) {
+                var2Unknown_[j] = unknowns_.size();
+                unknowns_.push_back(j);
+            }
+        }
+
+        std::vector<size_t> implicitEqs;
+        std::vector<size_t> explicitEqs;
+        for (size_t i = 0; i < m; i++) {
+            if (eqInfo_[i].isExplicit())
+                explicitEqs.push_back(i);
+            else
+                implicitEqs.push_back(i);
+        }
+
+        if (implicitEqs.size() != unknowns_.size()) {
+            throw CGException("Unable to generate a BLT model: the number of implicit equations (", implicitEqs.size(),
+                              ") is different from the number of unknowns (", unknowns_.size(), ")");
+        }
+
+        /**
+         * structure of the implicit equations
+         */
+        using VectorSet = std::vector<std::set<size_t> >;
+        const VectorSet jacSparsity = jacobianSparsitySet<VectorSet, CGBase>(fun_);
+
+        BipartiteMatching matching;
+        matching.addVariables(unknowns_.size());
+        for (size_t i : implicitEqs) {
+            std::set<size_t> cols;
+            for (size_t j : jacSparsity[i]) {
+                int u = var2Unknown_[j];
+                if (u >= 0)
+                    cols.insert(u);
+                u = derivativeUnknown(j);
+                if (u >= 0)
+                    cols.insert(u);
+            }
+            matching.addEquation(cols);
+        }
+
+        if (matching.match() != implicitEqs.size()) {
+            throw CGException("Unable to generate a BLT model: the DAE system is structurally singular");
+        }
+
+        blt_ = matching.blockTriangular();
+        for (size_t& i : blt_.equations)
+            i = implicitEqs[i];
+        for (size_t& j : blt_.variables)
+            j = unknowns_[j];
+
+        eqOrder_ = blt_.equations;
+        eqOrder_.insert(eqOrder_.end(), explicitEqs.begin(), explicitEqs.end());
+
+        newEqInfo_.resize(m);
+        for (size_t i = 0; i < m; i++)
+            newEqInfo_[i] = eqInfo_[eqOrder_[i]];
+
+        /**
+         * operation graph of the original model
+         */
+        CodeHandler<Base> handler;
+
+        std::vector<CGBase> indep(n);
+        handler.makeVariables(indep);
+
+        const std::vector<CGBase> res = fun_.Forward(0, indep);
+
+        /**
+         * complete model
+         */
+        std::vector<CGBase> resBlt(m);
+        for (size_t i = 0; i < m; i++)
+            resBlt[i] = res[eqOrder_[i]];
+        bltFun_.reset(createModel(handler, resBlt));
+
+        model_.reset(new ModelCSourceGen<Base>(*bltFun_, name_));
+        if (x_.size() == n)
+            model_->setTypicalIndependentValues(x_);
+        model_->setCreateForwardZero(true);
+        if (createJacobian_) {
+            std::vector<size_t> rows, cols;
+            for (size_t i = 0; i < m; i++) {
+                for (size_t j : jacSparsity[eqOrder_[i]]) {
+                    if (var2Unknown_[j] >= 0 || derivativeUnknown(j) >= 0) {
+                        rows.push_back(i);
+                        cols.push_back(j);
+                    }
+                }
+            }
+            model_->setCreateSparseJacobian(true);
+            model_->setCustomSparseJacobianElements(rows, cols);
+        }
+
+        std::vector<int> unknownDerivative(unknowns_.size(), -1);
+        for (size_t j = 0; j < n; j++) {
+            int du = derivativeUnknown(j);
+            if (du >= 0)
+                unknownDerivative[du] = j;
+        }
+
+        auto defineIterationMatrix = [&](ModelCSourceGen<Base>& model, size_t start, size_t end) {
+            std::vector<int> columns(end - start), alphaColumns(end - start);
+            for (size_t e = start; e < end; e++) {
+                size_t j = blt_.variables[e];
+                columns[e - start] = j;
+                alphaColumns[e - start] = unknownDerivative[var2Unknown_[j]];
+            }
+            model.setCreateSparseIterationMatrix(true);
+            model.setIterationMatrixColumns(columns, alphaColumns);
+        };
+
+        if (createIterationMatrix_) {
+            defineIterationMatrix(*model_, 0, blt_.variables.size());
+        }
+
+        /**
+         * a model for each block
+         */
+        if (!createBlockModels_)
+            return;
+
+        size_t nBlocks = blt_.blockCount();
+        blockFun_.resize(nBlocks);
+        blockModels_.resize(nBlocks);
+        std::vector<bool> inBlock(unknowns_.size(), false);
+
+        for (size_t b = 0; b < nBlocks; b++) {
+            size_t start = blt_.blockStart[b];
+            size_t end = blt_.blockStart[b + 1];
+
+            std::vector<CGBase> resBlock(end - start);
+            for (size_t e = start; e < end; e++) {
+                resBlock[e - start] = res[blt_.equations[e]];
+                inBlock[var2Unknown_[blt_.variables[e]]] = true;
+            }
+            blockFun_[b].reset(createModel(handler, resBlock));
+
+            std::vector<size_t> rows, cols;
+            for (size_t e = start; e < end; e++) {
+                for (size_t j : jacSparsity[blt_.equations[e]]) {
+                    int u = var2Unknown_[j];
+                    int du = derivativeUnknown(j);
+                    if ((u >= 0 && inBlock[u]) || (du >= 0 && inBlock[du])) {
+                        rows.push_back(e - start);
+                        cols.push_back(j);
+                    }
+                }
+            }
+
+            for (size_t e = start; e < end; e++)
+                inBlock[var2Unknown_[blt_.variables[e]]] = false;
+
+            ModelCSourceGen<Base>* model = new ModelCSourceGen<Base>(*blockFun_[b], getBlockModelName(b));
+            blockModels_[b].reset(model);
+            if (x_.size() == n)
+                model->setTypicalIndependentValues(x_);
+            model->setCreateForwardZero(true);
+            model->setCreateSparseJacobian(true);
+            model->setCustomSparseJacobianElements(rows, cols);
+            if (createIterationMatrix_) {
+                defineIterationMatrix(*model, start, end);
+            }
+        }
+    }
+
+    /**
+     * Provides the unknown for which a variable is the time derivative.
+     *
+     * @param j the DAE variable index
+     * @return the unknown index or -1 if it is not the time derivative of
+     *         an unknown
+     */
+    inline int derivativeUnknown(size_t j) const {
+        int a = varInfo_[j].getAntiDerivative();
+        return a >= 0 ? var2Unknown_[a] : -1;
+    }
+
+    /**
+     * Creates a new tape for a subset of the residuals of the original
+     * model.
+     *
+     * @param handler the handler with the operation graph of the original
+     *                model
+     * @param res the residuals
+     */
+    inline ADFun<CGBase>* createModel(CodeHandler<Base>& handler,
+                                      const std::vector<CGBase>& res) const {
+        size_t n = varInfo_.size();
+
+        std::vector<ADCG> indep(n);
+        for (size_t j = 0; j < n; j++) {
+            if (x_.size() == n)
+                indep[j] = x_[j];
+            else
+                indep[j] = Base(0);
+        }
+        Independent(indep);
+
+        Evaluator<Base, CGBase> evaluator(handler);
+        std::vector<ADCG> dep = evaluator.evaluate(indep, res);
+
+        return new ADFun<CGBase>(indep, dep);
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
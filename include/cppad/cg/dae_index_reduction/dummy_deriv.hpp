@@ -37,7 +37,23 @@ class DummyDerivatives : public DaeIndexReduction<Base> {
     using VectorB = Eigen::Matrix<Base, Eigen::Dynamic, 1>;
     using VectorCB = Eigen::Matrix<std::complex<Base>, Eigen::Dynamic, 1>;
     using MatrixB = Eigen::Matrix<Base, Eigen::Dynamic, Eigen::Dynamic>;
+    using SparseMatrixB = Eigen::SparseMatrix<Base, Eigen::ColMajor, int>;
+    using JacobianMatrix = Eigen::SparseMatrix<Base, Eigen::RowMajor>;
 protected:
+    /**
+     * A set of equations and candidate variables (columns) which is
+     * independent from the remaining equations in a dummy derivative
+     * selection step
+     */
+    struct SelectionBlock {
+        // number of equations in the block
+        size_t rows;
+        // the numerical rank of the block
+        size_t rank;
+        // the variables/columns ordered by the column pivoting (linearly independent first)
+        std::vector<size_t> columns;
+    };
+
     /**
      * Method used to identify the structural index
      */
@@ -72,7 +88,7 @@ protected:
      * equations relative to the time derivatives
      * (in the new variable order).
      */
-    Eigen::SparseMatrix<Base, Eigen::RowMajor> jacobian_;
+    JacobianMatrix jacobian_;
     /**
      * Dummy derivatives
      */
@@ -98,6 +114,24 @@ protected:
      * Avoid using these variables as dummy derivatives
      */
     std::set<std::string> avoidAsDummy_;
+    /**
+     * Whether or not to use a sparse QR decomposition of independent blocks
+     * of the Jacobian to select the dummy derivatives
+     */
+    bool sparseSelection_;
+    /**
+     * Threshold used to detect linearly dependent columns in the sparse QR
+     * decomposition (a negative value uses the default threshold)
+     */
+    Base pivotThreshold_;
+    /**
+     * maximum number of threads used to select dummy derivatives
+     */
+    size_t threads_;
+    /**
+     * the time spent in each stage of the last index reduction (in seconds)
+     */
+    std::vector<std::pair<std::string, double> > stageTimes_;
 public:
 
     /**
@@ -125,7 +159,10 @@ public:
             reduceEquations_(true),
             generateSemiExplicitDae_(false),
             reorder_(true),
-            avoidConvertAlg2DifVars_(true) {
+            avoidConvertAlg2DifVars_(true),
+            sparseSelection_(false),
+            pivotThreshold_(-1),
+            threads_(1) {
 
         for (Vnode<Base>* jj : idxIdentify.getGraph().variables()) {
             if (jj->antiDerivative() != nullptr) {
@@ -236,6 +273,92 @@ public:
         return avoidAsDummy_;
     }
 
+    /**
+     * Whether or not dummy derivatives are selected using a sparse QR
+     * decomposition of each independent block of the Jacobian instead of a
+     * dense QR decomposition of all the equations differentiated the same
+     * number of times.
+     */
+    inline bool isSparseSelection() const {
+        return sparseSelection_;
+    }
+
+    /**
+     * Defines whether or not dummy derivatives are selected using a sparse
+     * QR decomposition (with column pivoting and a fill-reducing ordering)
+     * of each independent block of the Jacobian.
+     * The memory and time required by the sparse selection depend on the
+     * number of nonzeros of the Jacobian instead of the square of the
+     * number of equations, which is required for large models.
+     * The dense selection (default) always uses the columns with the
+     * largest norms first and therefore it can select a different set of
+     * dummy derivatives.
+     *
+     * @param sparse true to use the sparse selection
+     */
+    inline void setSparseSelection(bool sparse) {
+        sparseSelection_ = sparse;
+    }
+
+    /**
+     * Provides the threshold used to detect linearly dependent columns in
+     * the sparse QR decomposition.
+     *
+     * @return the threshold (a negative value means that a default threshold
+     *         is determined from the norms of the columns of each block)
+     */
+    inline Base getPivotThreshold() const {
+        return pivotThreshold_;
+    }
+
+    /**
+     * Defines the threshold used to detect linearly dependent columns in the
+     * sparse QR decomposition.
+     * Columns with a (normalized) norm below this value are considered
+     * to be linearly dependent on the previous columns.
+     *
+     * @param threshold the threshold (a negative value means that a default
+     *                  threshold is determined from the norms of the columns
+     *                  of each block)
+     */
+    inline void setPivotThreshold(Base threshold) {
+        pivotThreshold_ = threshold;
+    }
+
+    /**
+     * Provides the maximum number of threads used to select dummy
+     * derivatives.
+     */
+    inline size_t getThreadCount() const {
+        return threads_;
+    }
+
+    /**
+     * Defines the maximum number of threads used to select dummy
+     * derivatives.
+     * The independent blocks of the sparse selection (see
+     * setSparseSelection()) are factorized concurrently.
+     * The selected dummy derivatives do not depend on the number of
+     * threads.
+     *
+     * @param threads the number of threads (0 uses the number of hardware
+     *                threads)
+     */
+    inline void setThreadCount(size_t threads) {
+        if (threads == 0) {
+            threads = std::thread::hardware_concurrency();
+        }
+        threads_ = std::max<size_t>(threads, 1);
+    }
+
+    /**
+     * Provides the time spent in each stage of the last call to
+     * reduceIndex() (in seconds), in the order the stages were executed.
+     */
+    inline const std::vector<std::pair<std::string, double> >& getStageTimes() const {
+        return stageTimes_;
+    }
+
     inline std::unique_ptr<ADFun<CG<Base>>> reduceIndex(std::vector<DaeVarInfo>& newVarInfo,
                                                         std::vector<DaeEquationInfo>& newEqInfo) override {
 
@@ -248,10 +371,15 @@ public:
          */
         std::vector<DaeEquationInfo> reducedEqInfo;
 
+        stageTimes_.clear();
+        std::chrono::steady_clock::time_point stageBegin = std::chrono::steady_clock::now();
+
         reducedFun_ = idxIdentify_->reduceIndex(reducedVarInfo, reducedEqInfo);
         if (reducedFun_.get() == nullptr)
             return nullptr; //nothing to do (no index reduction required)
 
+        finishedStage("structural index reduction", stageBegin);
+
         if (this->verbosity_ >= Verbosity::Low)
             log() << "########  Dummy derivatives method  ########" << std::endl;
 
@@ -259,15 +387,20 @@ public:
         addDummyDerivatives(reducedVarInfo, reducedEqInfo, newVarInfo);
 
         if (reduceEquations_ || generateSemiExplicitDae_) {
+            stageBegin = std::chrono::steady_clock::now();
 
             matchVars2Eqs4Elimination(newVarInfo, newEqInfo);
 
+            finishedStage("variable/equation matching", stageBegin);
+
             if (reduceEquations_) {
                 std::vector<DaeVarInfo> varInfo = newVarInfo; // copy
                 std::vector<DaeEquationInfo> eqInfo = newEqInfo; // copy
                 std::unique_ptr<ADFun<CG<Base> > > funShort = reduceEquations(varInfo, newVarInfo,
                                                                               eqInfo, newEqInfo);
                 reducedFun_.swap(funShort);
+
+                finishedStage("equation reduction", stageBegin);
             }
 
             if (generateSemiExplicitDae_) {
@@ -277,16 +410,22 @@ public:
                                                                                           varInfo, newVarInfo,
                                                                                           eqInfo, newEqInfo);
                 reducedFun_.swap(semiExplicit);
+
+                finishedStage("semi-explicit DAE", stageBegin);
             }
         }
 
         if (reorder_) {
+            stageBegin = std::chrono::steady_clock::now();
+
             std::vector<DaeVarInfo> varInfo = newVarInfo; // copy
             std::vector<DaeEquationInfo> eqInfo = newEqInfo; // copy
             std::unique_ptr<ADFun<CG<Base>>> reorderedFun = reorderModelEqNVars(*reducedFun_,
                                                                                 varInfo, newVarInfo,
                                                                                 eqInfo, newEqInfo);
             reducedFun_.swap(reorderedFun);
+
+            finishedStage("reordering", stageBegin);
         }
 
         return std::unique_ptr<ADFun<CG<Base>>>(reducedFun_.release());
@@ -296,6 +435,24 @@ protected:
 
     using DaeIndexReduction<Base>::log;
 
+    /**
+     * Saves the time spent in a stage of the index reduction.
+     *
+     * @param stage the stage name
+     * @param begin the time when the stage started (it is updated to the
+     *              current time so that it can be used for the next stage)
+     */
+    inline void finishedStage(const std::string& stage,
+                              std::chrono::steady_clock::time_point& begin) {
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        double elapsed = std::chrono::duration<double>(end - begin).count();
+        stageTimes_.emplace_back(stage, elapsed);
+        begin = end;
+
+        if (this->verbosity_ >= Verbosity::Low)
+            log() << "# " << stage << ": " << elapsed << " s" << std::endl;
+    }
+
     virtual inline void addDummyDerivatives(const std::vector<DaeVarInfo>& varInfo,
                                             const std::vector<DaeEquationInfo>& eqInfo,
                                             std::vector<DaeVarInfo>& newVarInfo) {
@@ -303,8 +460,12 @@ protected:
         auto& vnodes = graph.variables();
         auto& enodes = graph.equations();
 
+        std::chrono::steady_clock::time_point stageBegin = std::chrono::steady_clock::now();
+
         determineJacobian();
 
+        finishedStage("Jacobian evaluation", stageBegin);
+
         // variables of interest
         std::vector<Vnode<Base>*> vars;
         vars.reserve(vnodes.size() - diffVarStart_);
@@ -388,6 +549,7 @@ protected:
             vars.swap(varsNew);
         }
 
+        finishedStage("dummy derivative selection", stageBegin);
 
         /**
          * Prepare the output information
@@ -1403,20 +1565,25 @@ protected:
         /**
          * Determine the columns/variables that must be removed
          */
-        std::set<size_t> excludeCols;
-        std::set<size_t> avoidCols;
+        std::vector<int> col2Var(jacobian_.cols(), -1);
         for (size_t j = 0; j < vars.size(); j++) {
-            Vnode<Base>* jj = vars[j];
-            bool notZero = false;
-            for (size_t i = 0; i < eqs.size(); i++) {
-                Enode<Base>* ii = eqs[i];
-                Base val = jacobian_.coeff(ii->index() - diffEqStart_, jj->index() - diffVarStart_);
-                if (val != Base(0.0)) {
-                    notZero = true;
-                    break;
+            col2Var[vars[j]->index() - diffVarStart_] = int(j);
+        }
+
+        std::vector<bool> nonZeroVar(vars.size(), false);
+        for (Enode<Base>* ii : eqs) {
+            for (typename JacobianMatrix::InnerIterator it(jacobian_, ii->index() - diffEqStart_); it; ++it) {
+                int j = col2Var[it.col()];
+                if (j >= 0 && it.value() != Base(0.0)) {
+                    nonZeroVar[j] = true;
                 }
             }
-            if (!notZero) {
+        }
+
+        std::set<size_t> excludeCols;
+        std::set<size_t> avoidCols;
+        for (size_t j = 0; j < vars.size(); j++) {
+            if (!nonZeroVar[j]) {
                 // all zeros: must not choose this column/variable
                 excludeCols.insert(j);
             } else if (avoidAsDummy_.find(vars[j]->name()) != avoidAsDummy_.end()) {
@@ -1434,8 +1601,7 @@ protected:
         }
 
         std::vector<Vnode<Base>* > varsLocal;
-
-        Eigen::ColPivHouseholderQR<MatrixB> qr;
+        std::vector<SelectionBlock> blocks;
 
         auto orderColumns = [&]() {
             varsLocal.reserve(vars.size() - excludeCols.size());
@@ -1445,53 +1611,16 @@ protected:
                 }
             }
 
-
-            work.setZero(eqs.size(), varsLocal.size());
-
-            // determine the rows that only contain a single nonzero (a single column)
-            for (size_t i = 0; i < eqs.size(); i++) {
-                Enode<Base>* ii = eqs[i];
-                for (size_t j = 0; j < varsLocal.size(); j++) {
-                    const Vnode<Base>* jj = varsLocal[j];
-                    Base val = jacobian_.coeff(ii->index() - diffEqStart_, jj->index() - diffVarStart_);
-                    if (val != Base(0.0)) {
-                        work(i, j) = val;
-                    }
-                }
-            }
-
-            if (this->verbosity_ >= Verbosity::High)
-                log() << "subset Jac:\n" << work << "\n";
-
-            qr.compute(work);
-
-            if (qr.info() != Eigen::Success) {
-                throw CGException("Failed to select dummy derivatives! "
-                                  "QR decomposition of a submatrix of the Jacobian failed!");
-            } else if (qr.rank() < work.rows()) {
-                throw CGException("Failed to select dummy derivatives! "
-                                  "The resulting system is probably singular for the provided data.");
+            std::fill(col2Var.begin(), col2Var.end(), -1);
+            for (size_t j = 0; j < varsLocal.size(); j++) {
+                col2Var[varsLocal[j]->index() - diffVarStart_] = int(j);
             }
 
-            using PermutationMatrix = typename Eigen::ColPivHouseholderQR<MatrixB>::PermutationType;
-            using Indices = typename PermutationMatrix::IndicesType;
-
-            const PermutationMatrix& p = qr.colsPermutation();
-            const Indices& indices = p.indices();
-
-            if (this->verbosity_ >= Verbosity::High) {
-                log() << "## matrix Q:\n";
-                MatrixB q = qr.matrixQ();
-                log() << q << "\n";
-                log() << "## matrix R:\n";
-                MatrixB r = qr.matrixR().template triangularView<Eigen::Upper>();
-                log() << r << "\n";
-                log() << "## matrix P: " << indices.transpose() << "\n";
-            }
-
-            if (indices.size() < work.rows()) {
-                throw CGException("Failed to select dummy derivatives! "
-                                  "The resulting system is probably singular for the provided data.");
+            blocks.clear();
+            if (sparseSelection_) {
+                orderColumnsSparse(eqs, varsLocal, col2Var, blocks);
+            } else {
+                orderColumnsDense(eqs, varsLocal, col2Var, work, blocks);
             }
         };
 
@@ -1514,41 +1643,45 @@ protected:
             orderColumns();
         }
 
-        const auto& p = qr.colsPermutation();
-        const auto& indices = p.indices();
-
         std::vector<Vnode<Base>* > newDummies;
-        if (avoidConvertAlg2DifVars_) {
-            auto& graph = idxIdentify_->getGraph();
-            const auto& varInfo = graph.getOriginalVariableInfo();
-
-            // add algebraic first
-            for (int i = 0; newDummies.size() < size_t(work.rows()) && i < qr.rank(); i++) {
-                Vnode<Base>* v = varsLocal[indices(i)];
-                CPPADCG_ASSERT_UNKNOWN(v->originalVariable() != nullptr);
-                size_t tape = v->originalVariable()->tapeIndex();
-                CPPADCG_ASSERT_UNKNOWN(tape < varInfo.size());
-                if (varInfo[tape].getDerivative() < 0) {
-                    // derivative of a variable which was originally algebraic only
-                    newDummies.push_back(v);
+        newDummies.reserve(eqs.size());
+
+        for (const SelectionBlock& block : blocks) {
+            const std::vector<size_t>& indices = block.columns;
+            size_t blockStart = newDummies.size();
+
+            if (avoidConvertAlg2DifVars_) {
+                auto& graph = idxIdentify_->getGraph();
+                const auto& varInfo = graph.getOriginalVariableInfo();
+
+                // add algebraic first
+                for (size_t i = 0; newDummies.size() - blockStart < block.rows && i < block.rank; i++) {
+                    Vnode<Base>* v = varsLocal[indices[i]];
+                    CPPADCG_ASSERT_UNKNOWN(v->originalVariable() != nullptr);
+                    size_t tape = v->originalVariable()->tapeIndex();
+                    CPPADCG_ASSERT_UNKNOWN(tape < varInfo.size());
+                    if (varInfo[tape].getDerivative() < 0) {
+                        // derivative of a variable which was originally algebraic only
+                        newDummies.push_back(v);
+                    }
                 }
-            }
-            // add remaining
-            for (int i = 0; newDummies.size() < size_t(work.rows()); i++) {
-                Vnode<Base>* v = varsLocal[indices(i)];
-                CPPADCG_ASSERT_UNKNOWN(v->originalVariable() != nullptr);
-                size_t tape = v->originalVariable()->tapeIndex();
-                CPPADCG_ASSERT_UNKNOWN(tape < varInfo.size());
-                if (varInfo[tape].getDerivative() >= 0) {
-                    // derivative of a variable which was already differential
-                    newDummies.push_back(v);
+                // add remaining
+                for (size_t i = 0; newDummies.size() - blockStart < block.rows; i++) {
+                    Vnode<Base>* v = varsLocal[indices[i]];
+                    CPPADCG_ASSERT_UNKNOWN(v->originalVariable() != nullptr);
+                    size_t tape = v->originalVariable()->tapeIndex();
+                    CPPADCG_ASSERT_UNKNOWN(tape < varInfo.size());
+                    if (varInfo[tape].getDerivative() >= 0) {
+                        // derivative of a variable which was already differential
+                        newDummies.push_back(v);
+                    }
                 }
-            }
 
-        } else {
-            // use order provided by the householder column pivoting
-            for (int i = 0; i < work.rows(); i++) {
-                newDummies.push_back(varsLocal[indices(i)]);
+            } else {
+                // use order provided by the householder column pivoting
+                for (size_t i = 0; i < block.rows; i++) {
+                    newDummies.push_back(varsLocal[indices[i]]);
+                }
             }
         }
 
@@ -1567,6 +1700,253 @@ protected:
         dummyD_.insert(dummyD_.end(), newDummies.begin(), newDummies.end());
     }
 
+    /**
+     * Orders the candidate columns using a dense QR decomposition with
+     * column pivoting of the Jacobian of all the provided equations.
+     */
+    inline void orderColumnsDense(const std::vector<Enode<Base>* >& eqs,
+                                  const std::vector<Vnode<Base>* >& varsLocal,
+                                  const std::vector<int>& col2Var,
+                                  MatrixB& work,
+                                  std::vector<SelectionBlock>& blocks) {
+        work.setZero(eqs.size(), varsLocal.size());
+
+        for (size_t i = 0; i < eqs.size(); i++) {
+            Enode<Base>* ii = eqs[i];
+            for (typename JacobianMatrix::InnerIterator it(jacobian_, ii->index() - diffEqStart_); it; ++it) {
+                int j = col2Var[it.col()];
+                if (j >= 0 && it.value() != Base(0.0)) {
+                    work(i, j) = it.value();
+                }
+            }
+        }
+
+        if (this->verbosity_ >= Verbosity::High)
+            log() << "subset Jac:\n" << work << "\n";
+
+        Eigen::ColPivHouseholderQR<MatrixB> qr(work);
+
+        if (qr.info() != Eigen::Success) {
+            throw CGException("Failed to select dummy derivatives! "
+                              "QR decomposition of a submatrix of the Jacobian failed!");
+        } else if (qr.rank() < work.rows()) {
+            throw CGException("Failed to select dummy derivatives! "
+                              "The resulting system is probably singular for the provided data.");
+        }
+
+        using PermutationMatrix = typename Eigen::ColPivHouseholderQR<MatrixB>::PermutationType;
+        using Indices = typename PermutationMatrix::IndicesType;
+
+        const PermutationMatrix& p = qr.colsPermutation();
+        const Indices& indices = p.indices();
+
+        if (this->verbosity_ >= Verbosity::High) {
+            log() << "## matrix Q:\n";
+            MatrixB q = qr.matrixQ();
+            log() << q << "\n";
+            log() << "## matrix R:\n";
+            MatrixB r = qr.matrixR().template triangularView<Eigen::Upper>();
+            log() << r << "\n";
+            log() << "## matrix P: " << indices.transpose() << "\n";
+        }
+
+        if (indices.size() < work.rows()) {
+            throw CGException("Failed to select dummy derivatives! "
+                              "The resulting system is probably singular for the provided data.");
+        }
+
+        blocks.resize(1);
+        SelectionBlock& block = blocks[0];
+        block.rows = eqs.size();
+        block.rank = qr.rank();
+        block.columns.resize(indices.size());
+        for (int i = 0; i < indices.size(); i++) {
+            block.columns[i] = indices(i);
+        }
+    }
+
+    /**
+     * Orders the candidate columns of each independent block of equations
+     * (connected components of the bipartite graph of the equations and the
+     * candidate variables) using a sparse QR decomposition with column
+     * pivoting.
+     * No dense matrix is ever created.
+     */
+    inline void orderColumnsSparse(const std::vector<Enode<Base>* >& eqs,
+                                   const std::vector<Vnode<Base>* >& varsLocal,
+                                   const std::vector<int>& col2Var,
+                                   std::vector<SelectionBlock>& blocks) {
+        const size_t nEqs = eqs.size();
+        const size_t nVars = varsLocal.size();
+
+        /**
+         * Determine the independent blocks (union-find on the columns)
+         */
+        std::vector<size_t> parent(nVars);
+        for (size_t j = 0; j < nVars; j++)
+            parent[j] = j;
+
+        auto findRoot = [&parent](size_t j) {
+            while (parent[j] != j) {
+                parent[j] = parent[parent[j]]; // path halving
+                j = parent[j];
+            }
+            return j;
+        };
+
+        std::vector<int> eqFirstVar(nEqs, -1);
+        for (size_t i = 0; i < nEqs; i++) {
+            for (typename JacobianMatrix::InnerIterator it(jacobian_, eqs[i]->index() - diffEqStart_); it; ++it) {
+                int j = col2Var[it.col()];
+                if (j < 0 || it.value() == Base(0.0))
+                    continue;
+
+                if (eqFirstVar[i] < 0) {
+                    eqFirstVar[i] = j;
+                } else {
+                    size_t r1 = findRoot(eqFirstVar[i]);
+                    size_t r2 = findRoot(j);
+                    if (r1 != r2)
+                        parent[r2] = r1;
+                }
+            }
+
+            if (eqFirstVar[i] < 0) {
+                throw CGException("Failed to select dummy derivatives! "
+                                  "The resulting system is probably singular for the provided data.");
+            }
+        }
+
+        std::vector<int> root2Block(nVars, -1);
+        std::vector<std::vector<size_t> > blockEqs;
+        std::vector<std::vector<size_t> > blockVars;
+        for (size_t i = 0; i < nEqs; i++) {
+            size_t r = findRoot(eqFirstVar[i]);
+            if (root2Block[r] < 0) {
+                root2Block[r] = int(blockEqs.size());
+                blockEqs.emplace_back();
+                blockVars.emplace_back();
+            }
+            blockEqs[root2Block[r]].push_back(i);
+        }
+
+        std::vector<int> var2Local(nVars, -1); // position of each variable inside its block
+        for (size_t j = 0; j < nVars; j++) {
+            int b = root2Block[findRoot(j)];
+            if (b >= 0) {
+                var2Local[j] = int(blockVars[b].size());
+                blockVars[b].push_back(j);
+            }
+            // variables in blocks without equations are never selected
+        }
+
+        if (this->verbosity_ >= Verbosity::High)
+            log() << "## independent blocks: " << blockEqs.size() << "\n";
+
+        /**
+         * Sparse QR decomposition of each block
+         */
+        using Triplet = Eigen::Triplet<Base, int>;
+
+        blocks.resize(blockEqs.size());
+        std::vector<size_t> nnz(blockEqs.size());
+
+        auto factorize = [&](size_t b,
+                             std::vector<Triplet>& triplets,
+                             SparseMatrixB& mat,
+                             Eigen::SparseQR<SparseMatrixB, Eigen::COLAMDOrdering<int> >& qr) {
+            const std::vector<size_t>& bEqs = blockEqs[b];
+            const std::vector<size_t>& bVars = blockVars[b];
+            SelectionBlock& block = blocks[b];
+            block.rows = bEqs.size();
+
+            if (bVars.size() < bEqs.size()) {
+                throw CGException("Failed to select dummy derivatives! "
+                                  "The resulting system is probably singular for the provided data.");
+            }
+
+            triplets.clear();
+            for (size_t i = 0; i < bEqs.size(); i++) {
+                for (typename JacobianMatrix::InnerIterator it(jacobian_, eqs[bEqs[i]]->index() - diffEqStart_); it; ++it) {
+                    int j = col2Var[it.col()];
+                    if (j >= 0 && it.value() != Base(0.0)) {
+                        triplets.emplace_back(int(i), var2Local[j], it.value());
+                    }
+                }
+            }
+
+            mat.resize(bEqs.size(), bVars.size());
+            mat.setFromTriplets(triplets.begin(), triplets.end());
+            mat.makeCompressed();
+            nnz[b] = mat.nonZeros();
+
+            qr.compute(mat);
+
+            if (qr.info() != Eigen::Success) {
+                throw CGException("Failed to select dummy derivatives! "
+                                  "Sparse QR decomposition of a submatrix of the Jacobian failed!");
+            } else if (size_t(qr.rank()) < bEqs.size()) {
+                throw CGException("Failed to select dummy derivatives! "
+                                  "The resulting system is probably singular for the provided data.");
+            }
+
+            const auto& indices = qr.colsPermutation().indices();
+
+            block.rank = qr.rank();
+            block.columns.resize(indices.size());
+            for (int i = 0; i < indices.size(); i++) {
+                block.columns[i] = bVars[indices(i)];
+            }
+        };
+
+        auto factorizeBlocks = [&](size_t first, size_t step) {
+            std::vector<Triplet> triplets;
+            SparseMatrixB mat;
+            Eigen::SparseQR<SparseMatrixB, Eigen::COLAMDOrdering<int> > qr;
+            if (pivotThreshold_ >= 0)
+                qr.setPivotThreshold(pivotThreshold_);
+
+            for (size_t b = first; b < blockEqs.size(); b += step) {
+                factorize(b, triplets, mat, qr);
+            }
+        };
+
+        size_t nThreads = std::min(threads_, blockEqs.size());
+        if (nThreads <= 1) {
+            factorizeBlocks(0, 1);
+        } else {
+            // blocks are independent: distribute them among the threads
+            std::vector<std::exception_ptr> errors(nThreads);
+            std::vector<std::thread> workers;
+            for (size_t t = 0; t < nThreads; t++) {
+                workers.emplace_back([&, t]() {
+                    try {
+                        factorizeBlocks(t, nThreads);
+                    } catch (...) {
+                        errors[t] = std::current_exception();
+                    }
+                });
+            }
+            for (auto& w : workers)
+                w.join();
+
+            for (const auto& e : errors) {
+                if (e != nullptr)
+                    std::rethrow_exception(e);
+            }
+        }
+
+        if (this->verbosity_ >= Verbosity::High) {
+            for (size_t b = 0; b < blocks.size(); b++) {
+                log() << "## block " << b << " (" << blockEqs[b].size() << "x" << blockVars[b].size() << ", nnz=" << nnz[b] << ")"
+                        << " column order:";
+                for (size_t j : blocks[b].columns)
+                    log() << " " << var2Local[j];
+                log() << "\n";
+            }
+        }
+    }
+
     inline static void printModel(std::ostream& out,
                                   CodeHandler<Base>& handler,
                                   const std::vector<CGBase>& res,
@@ -24,6 +24,14 @@ namespace cg {
 
 /**
  * Pantelides DAE index reduction algorithm
+ *
+ * A maximum matching (Hopcroft-Karp) can be used for the initial
+ * assignment of the original equations (see setInitialMatching()).
+ * The differentiation loop still uses the augmenting path algorithm one
+ * equation at a time, since the structurally singular subsets to be
+ * differentiated are the nodes colored by a failed path search. The
+ * speed up is therefore limited to models where most equations are
+ * assigned by the initial matching.
  */
 template<class Base>
 class Pantelides : public DaeStructuralIndexReduction<Base> {
@@ -39,6 +47,8 @@ protected:
     bool reduced_;
     AugmentPathDepthLookahead<Base> defaultAugmentPath_;
     AugmentPath<Base>* augmentPath_;
+    // whether or not to start from a maximum matching of the original model
+    bool initialMatching_;
 public:
 
     /**
@@ -58,7 +68,8 @@ public:
             DaeStructuralIndexReduction<Base>(fun, varInfo, eqName),
             x_(x),
             reduced_(false),
-            augmentPath_(&defaultAugmentPath_) {
+            augmentPath_(&defaultAugmentPath_),
+            initialMatching_(false) {
 
     }
 
@@ -76,6 +87,32 @@ public:
         augmentPath_ = &a;
     }
 
+    /**
+     * Whether or not the equations are initially assigned using a maximum
+     * matching of the original model.
+     */
+    inline bool isInitialMatching() const {
+        return initialMatching_;
+    }
+
+    /**
+     * Defines whether or not the equations are initially assigned using a
+     * maximum matching (Hopcroft-Karp) of the original model.
+     * The augmenting path algorithm is then only used for the equations
+     * which could not be assigned, which is much faster for large models
+     * where only a few equations must be differentiated.
+     * The structural index is the same, however the differentiated
+     * equations can be different since the augmenting paths start from
+     * another assignment.
+     * Equations added by differentiation are always assigned with the
+     * augmenting path algorithm (see getAugmentPath()).
+     *
+     * @param initialMatching true to start from a maximum matching
+     */
+    inline void setInitialMatching(bool initialMatching) {
+        initialMatching_ = initialMatching;
+    }
+
     inline std::unique_ptr<ADFun<CG<Base>>> reduceIndex(std::vector<DaeVarInfo>& newVarInfo,
                                                         std::vector<DaeEquationInfo>& equationInfo) override {
         if (reduced_)
@@ -116,9 +153,24 @@ protected:
         if (this->verbosity_ >= Verbosity::High)
             graph_.printDot(this->log());
 
+        if (initialMatching_) {
+            deleteDifferentiatedVariables();
+
+            BipartiteMatching matching;
+            size_t assigned = graph_.assignEquations(matching);
+
+            if (this->verbosity_ >= Verbosity::High)
+                log() << "Initial matching: " << assigned << " of " << enodes.size() << " equations assigned\n";
+        }
+
         size_t Ndash = enodes.size();
         for (size_t k = 0; k < Ndash; k++) {
             Enode<Base>* i = enodes[k];
+            // the equation might have already been differentiated while
+            // processing other equations (only with an initial matching)
+            while (i->derivative() != nullptr) {
+                i = i->derivative();
+            }
 
             if (this->verbosity_ >= Verbosity::High)
                 log() << "Outer loop: equation k = " << *i << "\n";
@@ -130,10 +182,12 @@ protected:
                  * delete all V-nodes with A!=0 and their incident edges
                  * from the graph
                  */
-                for (Vnode<Base>* jj : vnodes) {
-                    if (!jj->isDeleted() && jj->derivative() != nullptr) {
-                        jj->deleteNode(log(), this->verbosity_);
-                    }
+                deleteDifferentiatedVariables();
+
+                Vnode<Base>* assigned = i->assignmentVariable();
+                if (assigned != nullptr && !assigned->isDeleted() && assigned->assignmentEquation() == i) {
+                    // already assigned by the initial matching
+                    break;
                 }
 
                 graph_.uncolorAll();
@@ -195,6 +249,14 @@ protected:
 
     }
 
+    inline void deleteDifferentiatedVariables() {
+        for (Vnode<Base>* jj : graph_.variables()) {
+            if (!jj->isDeleted() && jj->derivative() != nullptr) {
+                jj->deleteNode(log(), this->verbosity_);
+            }
+        }
+    }
+
 };
 
 } // END cg namespace
@@ -71,6 +71,15 @@ class BidirGraph;
 template<class Base>
 class ScopePathElement;
 
+template<class Base>
+class GraphSparsity;
+
+template<class Base>
+class GraphSerializer;
+
+template<class Base>
+class TaskGraph;
+
 /***************************************************************************
  * Nodes
  **************************************************************************/
@@ -292,6 +301,24 @@ enum class JacobianADMode {
     Forward, Reverse, Automatic
 };
 
+/**
+ * Coloring strategies used to compress the directional sweeps of sparse
+ * Jacobians and Hessians in the generated source code
+ */
+enum class SparseColoring {
+    CppAD, // coloring performed internally by CppAD (one sweep per row/column when reusing directional functions)
+    Distance2, // partial distance-2 coloring (CPR)
+    Star // star coloring of symmetric matrices (Hessian only, otherwise the same as Distance2)
+};
+
+/**
+ * Methods used to determine Jacobian and Hessian sparsity patterns
+ */
+enum class SparsityEngine {
+    CppAD, // sparsity sweeps over the CppAD tape
+    OperationGraph // dependency propagation over the operation graph of a CodeHandler (see GraphSparsity)
+};
+
 /**
  * Index pattern types
  */
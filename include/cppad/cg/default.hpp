@@ -24,18 +24,22 @@ namespace cg {
 template <class Base>
 inline CG<Base>::CG() :
     node_(nullptr),
-    value_(new Base(0.0)) {
+    value_(0.0),
+    valueDefined_(true) {
 }
 
 template <class Base>
 inline CG<Base>::CG(OperationNode<Base>& node) :
-    node_(&node) {
+    node_(&node),
+    value_(),
+    valueDefined_(false) {
 }
 
 template <class Base>
 inline CG<Base>::CG(const Argument<Base>& arg) :
     node_(arg.getOperation()),
-    value_(arg.getParameter() != nullptr ? new Base(*arg.getParameter()) : nullptr) {
+    value_(arg.getParameter() != nullptr ? *arg.getParameter() : Base()),
+    valueDefined_(arg.getParameter() != nullptr) {
 
 }
 
@@ -45,25 +49,8 @@ inline CG<Base>::CG(const Argument<Base>& arg) :
 template <class Base>
 inline CG<Base>::CG(const Base &b) :
     node_(nullptr),
-    value_(new Base(b)) {
-}
-
-/**
- * Copy constructor
- */
-template <class Base>
-inline CG<Base>::CG(const CG<Base>& orig) :
-    node_(orig.node_),
-    value_(orig.value_ != nullptr ? new Base(*orig.value_) : nullptr) {
-}
-
-/**
- * Move constructor
- */
-template <class Base>
-inline CG<Base>::CG(CG<Base>&& orig):
-        node_(orig.node_),
-        value_(std::move(orig.value_)) {
+    value_(b),
+    valueDefined_(true) {
 }
 
 /**
@@ -72,48 +59,11 @@ inline CG<Base>::CG(CG<Base>&& orig):
 template <class Base>
 inline CG<Base>& CG<Base>::operator=(const Base& b) {
     node_ = nullptr;
-    if (value_ != nullptr) {
-        *value_ = b;
-    } else {
-        value_.reset(new Base(b)); // to replace with value_ = std::make_unique once c++14 is used
-    }
-    return *this;
-}
-
-template <class Base>
-inline CG<Base>& CG<Base>::operator=(const CG<Base>& rhs) {
-    if (&rhs == this) {
-        return *this;
-    }
-    node_ = rhs.node_;
-    if (rhs.value_ != nullptr) {
-        if (value_ != nullptr) {
-            *value_ = *rhs.value_;
-        } else {
-            value_.reset(new Base(*rhs.value_)); // to replace with value_ = std::make_unique once c++14 is used
-        }
-    } else {
-        value_.reset();
-    }
-
-    return *this;
-}
-
-template <class Base>
-inline CG<Base>& CG<Base>::operator=(CG<Base>&& rhs) {
-    assert(this != &rhs);
-
-    node_ = rhs.node_;
-
-    // steal the value
-    value_ = std::move(rhs.value_);
-
+    value_ = b;
+    valueDefined_ = true;
     return *this;
 }
 
-template <class Base>
-CG<Base>::~CG() = default;
-
 } // END cg namespace
 } // END CppAD namespace
 
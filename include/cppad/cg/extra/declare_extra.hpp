@@ -109,6 +109,27 @@ inline VectorSet hessianSparsitySet(ADFun<Base>& fun,
                                     size_t i,
                                     bool transpose = false);
 
+/***********************************************************************
+ * Coloring
+ **********************************************************************/
+
+template<class VectorSet, class VectorSize>
+inline size_t colorDistanceTwo(const VectorSet& sparsity,
+                               size_t nCols,
+                               const VectorSize& row,
+                               const VectorSize& col,
+                               std::vector<size_t>& color);
+
+template<class VectorSet>
+inline size_t colorStar(const VectorSet& sparsity,
+                        std::vector<size_t>& color);
+
+template<class VectorSet>
+inline std::pair<size_t, size_t> starColoringSource(const VectorSet& sparsity,
+                                                    const std::vector<size_t>& color,
+                                                    size_t i,
+                                                    size_t j);
+
 /***********************************************************************
  * Sparsity conversion
  **********************************************************************/
@@ -0,0 +1,223 @@
+#ifndef CPPAD_CG_SPARSE_COLORING_INCLUDED
+#define CPPAD_CG_SPARSE_COLORING_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Ciengis
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Determines a partial distance-2 coloring of the columns of a sparse
+ * matrix so that the requested elements can be recovered from a compressed
+ * matrix (CPR approach).
+ * Two columns j and k cannot share a color if there is a row i with a
+ * requested element (i, j) and a non-zero (i, k) in the sparsity pattern.
+ * Columns are visited in a largest-first order.
+ *
+ * @param sparsity The sparsity pattern (one set of column indexes per row)
+ * @param nCols The number of columns in the matrix
+ * @param row The row indexes of the requested elements
+ * @param col The column indexes of the requested elements
+ * @param color The color of each column (output). Columns without any
+ *              requested element are assigned the color
+ *              std::numeric_limits<size_t>::max()
+ * @return the number of colors
+ */
+template<class VectorSet, class VectorSize>
+inline size_t colorDistanceTwo(const VectorSet& sparsity,
+                               size_t nCols,
+                               const VectorSize& row,
+                               const VectorSize& col,
+                               std::vector<size_t>& color) {
+    const size_t mRows = sparsity.size();
+    const size_t noColor = (std::numeric_limits<size_t>::max)();
+    CPPADCG_ASSERT_KNOWN(row.size() == col.size(), "The number of row and column indexes must be the same")
+
+    // requested columns per row and requested rows per column
+    std::vector<std::set<size_t> > reqRow(mRows);
+    std::vector<std::set<size_t> > reqCol(nCols);
+    for (size_t e = 0; e < row.size(); e++) {
+        CPPADCG_ASSERT_KNOWN(row[e] < mRows && col[e] < nCols, "Invalid element index")
+        reqRow[row[e]].insert(col[e]);
+        reqCol[col[e]].insert(row[e]);
+    }
+
+    std::vector<std::set<size_t> > sparsityT(nCols);
+    for (size_t i = 0; i < mRows; i++) {
+        for (size_t k : sparsity[i]) {
+            sparsityT[k].insert(i);
+        }
+    }
+
+    // largest-first ordering
+    std::vector<size_t> order;
+    order.reserve(nCols);
+    for (size_t j = 0; j < nCols; j++) {
+        if (!reqCol[j].empty())
+            order.push_back(j);
+    }
+    std::stable_sort(order.begin(), order.end(), [&](size_t j1, size_t j2) {
+        return sparsityT[j1].size() > sparsityT[j2].size();
+    });
+
+    color.assign(nCols, noColor);
+    std::vector<size_t> forbidden; // forbidden[c] == j when color c is not allowed for column j
+    size_t nColors = 0;
+
+    for (size_t j : order) {
+        for (size_t i : reqCol[j]) {
+            for (size_t k : sparsity[i]) {
+                if (color[k] != noColor)
+                    forbidden[color[k]] = j;
+            }
+        }
+        for (size_t i : sparsityT[j]) {
+            for (size_t k : reqRow[i]) {
+                if (color[k] != noColor)
+                    forbidden[color[k]] = j;
+            }
+        }
+
+        size_t c = 0;
+        while (c < nColors && forbidden[c] == j)
+            c++;
+
+        if (c == nColors) {
+            nColors++;
+            forbidden.push_back(noColor);
+        }
+        color[j] = c;
+    }
+
+    return nColors;
+}
+
+/**
+ * Determines a star coloring of the adjacency graph of a symmetric sparse
+ * matrix (e.g. a Hessian) using the greedy algorithm from
+ * Gebremedhin, Manne and Pothen (2005), "What color is your Jacobian?
+ * Graph coloring for computing derivatives".
+ * Every path with four vertices uses at least three colors which allows
+ * each non-zero element to be directly recovered from a compressed matrix
+ * by exploiting symmetry (see starColoringSource()).
+ *
+ * @param sparsity The symmetric sparsity pattern (both triangles must be
+ *                 provided)
+ * @param color The color of each column (output). Columns without any
+ *              non-zero element are assigned the color
+ *              std::numeric_limits<size_t>::max()
+ * @return the number of colors
+ */
+template<class VectorSet>
+inline size_t colorStar(const VectorSet& sparsity,
+                        std::vector<size_t>& color) {
+    const size_t n = sparsity.size();
+    const size_t noColor = (std::numeric_limits<size_t>::max)();
+
+    // largest-first ordering
+    std::vector<size_t> order;
+    order.reserve(n);
+    for (size_t j = 0; j < n; j++) {
+        if (!sparsity[j].empty())
+            order.push_back(j);
+    }
+    std::stable_sort(order.begin(), order.end(), [&](size_t j1, size_t j2) {
+        return sparsity[j1].size() > sparsity[j2].size();
+    });
+
+    color.assign(n, noColor);
+    std::vector<size_t> forbidden;
+    size_t nColors = 0;
+
+    for (size_t v : order) {
+        for (size_t w : sparsity[v]) {
+            if (w == v)
+                continue;
+
+            if (color[w] != noColor)
+                forbidden[color[w]] = v;
+
+            for (size_t x : sparsity[w]) {
+                if (x == w || x == v || color[x] == noColor)
+                    continue;
+
+                if (color[w] == noColor) {
+                    forbidden[color[x]] = v;
+                } else {
+                    for (size_t y : sparsity[x]) {
+                        if (y != x && y != w && color[y] == color[w]) {
+                            forbidden[color[x]] = v;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        size_t c = 0;
+        while (c < nColors && forbidden[c] == v)
+            c++;
+
+        if (c == nColors) {
+            nColors++;
+            forbidden.push_back(noColor);
+        }
+        color[v] = c;
+    }
+
+    return nColors;
+}
+
+/**
+ * Determines where an element of a symmetric matrix can be read from in
+ * the compressed matrix B = H S, where S is the seed matrix defined by a
+ * star coloring (or any other symmetric coloring).
+ *
+ * @param sparsity The symmetric sparsity pattern
+ * @param color The color of each column
+ * @param i The element row
+ * @param j The element column
+ * @return the pair (row in B, color) holding the value of element (i, j)
+ * @throws CGException if the element cannot be directly recovered
+ */
+template<class VectorSet>
+inline std::pair<size_t, size_t> starColoringSource(const VectorSet& sparsity,
+                                                    const std::vector<size_t>& color,
+                                                    size_t i,
+                                                    size_t j) {
+    // value in B(i, color[j]) if no other column with the same color has a non-zero in row i
+    bool direct = true;
+    for (size_t k : sparsity[i]) {
+        if (k != j && color[k] == color[j]) {
+            direct = false;
+            break;
+        }
+    }
+    if (direct)
+        return std::make_pair(i, color[j]);
+
+    // use symmetry: B(j, color[i])
+    for (size_t k : sparsity[j]) {
+        if (k != i && color[k] == color[i]) {
+            throw CGException("Unable to recover element (", i, ", ", j, ") from the compressed matrix");
+        }
+    }
+    return std::make_pair(j, color[i]);
+}
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -0,0 +1,646 @@
+#ifndef CPPAD_CG_GRAPH_SERIALIZER_INCLUDED
+#define CPPAD_CG_GRAPH_SERIALIZER_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Ciengis
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Saves and loads the operation graph of a CodeHandler in a compact binary
+ * format, so that taped and differentiated models (e.g. Jacobians and
+ * Hessians) can be reused to generate source code without re-taping.
+ *
+ * Only the operations which affect the dependent variables are saved.
+ * The file contains a fixed size header followed by sections of fixed size
+ * records (all 8-byte aligned) which can be read directly from a memory
+ * mapped file:
+ *  - header
+ *  - nodes (the independent variables first, in their original order)
+ *  - node information (NodeRecord::info)
+ *  - node arguments
+ *  - dependent variables
+ *  - atomic function references (matched by name when loaded)
+ *  - parameter values
+ *  - strings (node names and print texts)
+ *
+ * Numbers are stored in the byte order of the machine which saved the
+ * graph and loading is refused if it does not match.
+ * Loops (index operations) are not supported.
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class GraphSerializer {
+public:
+    using Node = OperationNode<Base>;
+    using Arg = Argument<Base>;
+    using CGB = CG<Base>;
+    using AtomicMap = std::map<std::string, CGAbstractAtomicFun<Base>*>;
+    /**
+     * current version of the binary format
+     */
+    static const uint32_t VERSION = 1;
+protected:
+    static const uint32_t ENDIANNESS = 0x01020304;
+    static const uint64_t NONE = (std::numeric_limits<uint64_t>::max)();
+    static const uint32_t NO_NAME = (std::numeric_limits<uint32_t>::max)();
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t endianness;
+        uint32_t baseSize;
+        uint32_t reserved;
+        uint64_t nIndependents;
+        uint64_t nNodes;
+        uint64_t nDependents;
+        uint64_t nInfo;
+        uint64_t nArgs;
+        uint64_t nAtomics;
+        uint64_t nParameters;
+        uint64_t stringBytes;
+    };
+
+    struct NodeRecord {
+        /// offset of the first element in the information section
+        /// (print nodes save the offsets and lengths of their texts here)
+        uint64_t info;
+        /// offset of the first element in the argument section
+        uint64_t args;
+        /// offset of the name in the string section
+        uint64_t name;
+        uint32_t op;
+        uint32_t nInfo;
+        uint32_t nArgs;
+        /// length of the name (NO_NAME if the node has no name)
+        uint32_t nameLength;
+    };
+
+    struct ArgRecord {
+        /// node index (NONE for parameters)
+        uint64_t node;
+        /// parameter index (NONE for variables)
+        uint64_t parameter;
+    };
+
+    struct AtomicRecord {
+        uint64_t id;
+        uint64_t name;
+        uint64_t nameLength;
+    };
+
+    static_assert(sizeof(Header) % 8 == 0, "unexpected header size");
+    static_assert(sizeof(NodeRecord) % 8 == 0, "unexpected node record size");
+    static_assert(std::is_trivially_copyable<Base>::value,
+                  "Only operation graphs with trivially copyable base types can be serialized");
+public:
+
+    /**
+     * Saves the operations required to evaluate the dependent variables.
+     *
+     * @param out where the graph is written to (must be a binary stream)
+     * @param indep the independent variables (all of them are saved even
+     *              if they are not used)
+     * @param dep the dependent variables
+     * @throws CGException if the graph cannot be saved (e.g. it contains
+     *                     loops or variables from several handlers)
+     */
+    template<class VectorCG>
+    static inline void save(std::ostream& out,
+                            const VectorCG& indep,
+                            const VectorCG& dep) {
+        Writer w;
+
+        const CodeHandler<Base>* handler = nullptr;
+        auto checkHandler = [&](const Node& node) {
+            if (handler == nullptr)
+                handler = node.getCodeHandler();
+            else if (node.getCodeHandler() != handler)
+                throw CGException("Unable to save an operation graph with variables from different code handlers");
+        };
+
+        for (size_t j = 0; j < indep.size(); j++) {
+            const Node* node = indep[j].getOperationNode();
+            if (node == nullptr || node->getOperationType() != CGOpCode::Inv) {
+                throw CGException("Invalid independent variable ", j);
+            }
+            checkHandler(*node);
+            w.addNode(*node);
+        }
+
+        for (size_t i = 0; i < dep.size(); i++) {
+            if (dep[i].getOperationNode() != nullptr)
+                checkHandler(*dep[i].getOperationNode());
+        }
+
+        if (handler != nullptr)
+            w.visited.resize(handler->getManagedNodesCount(), NONE);
+        for (size_t j = 0; j < w.nodes.size(); j++) {
+            w.visited[w.nodePtrs[j]->getHandlerPosition()] = j;
+        }
+
+        w.header.nDependents = dep.size();
+        for (size_t i = 0; i < dep.size(); i++) {
+            if (dep[i].isVariable()) {
+                w.addNodes(*dep[i].getOperationNode());
+                w.dependents.push_back(w.makeArgRecord(Arg(*dep[i].getOperationNode())));
+            } else {
+                w.dependents.push_back(w.makeArgRecord(Arg(dep[i].getValue())));
+            }
+        }
+
+        w.header.nIndependents = indep.size();
+        w.write(out);
+
+        if (out.fail()) {
+            throw CGException("Failed to save the operation graph");
+        }
+    }
+
+    /**
+     * Saves the operations required to evaluate the dependent variables
+     * into a file.
+     *
+     * @throws CGException if the graph cannot be saved
+     */
+    template<class VectorCG>
+    static inline void save(const std::string& file,
+                            const VectorCG& indep,
+                            const VectorCG& dep) {
+        std::ofstream out(file.c_str(), std::ios::binary);
+        if (!out.is_open()) {
+            throw CGException("Failed to open file '", file, "'");
+        }
+        save(out, indep, dep);
+        out.close();
+        if (out.fail()) {
+            throw CGException("Failed to save the operation graph to '", file, "'");
+        }
+    }
+
+    /**
+     * Creates the operations of a previously saved graph in a code handler.
+     *
+     * @param data the saved graph (e.g. a memory mapped file)
+     * @param size the number of bytes in data
+     * @param handler where the new operations are created
+     * @param indep the new independent variables
+     * @param dep the new dependent variables
+     * @param atomics the atomic functions used by the graph (by name)
+     * @throws CGException if the data is not a valid graph, it was saved
+     *                     with a newer format or a different base type, or
+     *                     an atomic function is missing
+     */
+    static inline void load(const char* data,
+                            size_t size,
+                            CodeHandler<Base>& handler,
+                            std::vector<CGB>& indep,
+                            std::vector<CGB>& dep,
+                            const AtomicMap& atomics = AtomicMap()) {
+        Reader r(data, size);
+        const Header& h = r.header;
+
+        /**
+         * atomic functions
+         */
+        std::map<uint64_t, size_t> atomicIds;
+        for (size_t k = 0; k < h.nAtomics; k++) {
+            AtomicRecord a = r.template record<AtomicRecord>(r.atomicStart, h.nAtomics, k);
+            std::string name = r.string(a.name, a.nameLength);
+            auto it = atomics.find(name);
+            if (it == atomics.end() || it->second == nullptr) {
+                throw CGException("Missing atomic function '", name, "' required by the operation graph");
+            }
+            handler.registerAtomicFunction(*it->second);
+            atomicIds[a.id] = it->second->getId();
+        }
+
+        /**
+         * nodes
+         */
+        std::vector<Node*> nodes(h.nNodes);
+        indep.resize(h.nIndependents);
+
+        for (size_t i = 0; i < h.nNodes; i++) {
+            NodeRecord nr = r.template record<NodeRecord>(r.nodeStart, h.nNodes, i);
+            if (nr.op >= uint32_t(CGOpCode::NumberOp)) {
+                throw CGException("Invalid operation graph: unknown operation type ", nr.op);
+            }
+            CGOpCode op = CGOpCode(nr.op);
+
+            if (i < h.nIndependents) {
+                if (op != CGOpCode::Inv)
+                    throw CGException("Invalid operation graph: independent variable ", i, " is not an independent");
+                handler.makeVariable(indep[i]);
+                nodes[i] = indep[i].getOperationNode();
+            } else {
+                if (op == CGOpCode::Inv)
+                    throw CGException("Invalid operation graph: unexpected independent variable");
+
+                std::vector<Arg> args(nr.nArgs);
+                for (size_t a = 0; a < nr.nArgs; a++) {
+                    args[a] = r.argument(r.template record<ArgRecord>(r.argStart, h.nArgs, nr.args + a), nodes, i);
+                }
+
+                std::vector<size_t> info(nr.nInfo);
+                for (size_t k = 0; k < nr.nInfo; k++) {
+                    info[k] = r.template record<uint64_t>(r.infoStart, h.nInfo, nr.info + k);
+                }
+
+                if (op == CGOpCode::Pri) {
+                    if (nr.nArgs != 1 || nr.nInfo != 4)
+                        throw CGException("Invalid operation graph: invalid print operation");
+                    nodes[i] = handler.makePrintNode(r.string(info[0], info[1]), args[0], r.string(info[2], info[3]));
+                } else {
+                    if (op == CGOpCode::AtomicForward || op == CGOpCode::AtomicReverse) {
+                        auto it = info.empty() ? atomicIds.end() : atomicIds.find(info[0]);
+                        if (it == atomicIds.end())
+                            throw CGException("Invalid operation graph: unknown atomic function");
+                        info[0] = it->second;
+                    }
+                    nodes[i] = handler.makeNode(op, std::move(info), std::move(args));
+                }
+            }
+
+            if (nr.nameLength != NO_NAME) {
+                nodes[i]->setName(r.string(nr.name, nr.nameLength));
+            }
+        }
+
+        /**
+         * dependents
+         */
+        dep.resize(h.nDependents);
+        for (size_t i = 0; i < h.nDependents; i++) {
+            Arg a = r.argument(r.template record<ArgRecord>(r.depStart, h.nDependents, i), nodes, nodes.size());
+            dep[i] = handler.createCG(a);
+        }
+    }
+
+    /**
+     * Creates the operations of a previously saved graph in a code handler.
+     *
+     * @param in where the graph is read from (must be a binary stream)
+     * @throws CGException if the data is not a valid graph
+     */
+    static inline void load(std::istream& in,
+                            CodeHandler<Base>& handler,
+                            std::vector<CGB>& indep,
+                            std::vector<CGB>& dep,
+                            const AtomicMap& atomics = AtomicMap()) {
+        std::vector<char> data((std::istreambuf_iterator<char>(in)),
+                               std::istreambuf_iterator<char>());
+        load(data.data(), data.size(), handler, indep, dep, atomics);
+    }
+
+    /**
+     * Creates the operations of a graph previously saved to a file in a
+     * code handler.
+     *
+     * @throws CGException if the file cannot be read or is not a valid graph
+     */
+    static inline void load(const std::string& file,
+                            CodeHandler<Base>& handler,
+                            std::vector<CGB>& indep,
+                            std::vector<CGB>& dep,
+                            const AtomicMap& atomics = AtomicMap()) {
+        std::ifstream in(file.c_str(), std::ios::binary);
+        if (!in.is_open()) {
+            throw CGException("Failed to open file '", file, "'");
+        }
+        load(in, handler, indep, dep, atomics);
+    }
+
+protected:
+
+    static inline uint64_t padding(uint64_t bytes) {
+        return (8 - bytes % 8) % 8;
+    }
+
+    /**
+     * Collects the sections of the graph before writing them
+     */
+    class Writer {
+    public:
+        Header header;
+        std::vector<NodeRecord> nodes;
+        std::vector<const Node*> nodePtrs;
+        std::vector<uint64_t> info;
+        std::vector<ArgRecord> args;
+        std::vector<ArgRecord> dependents;
+        std::vector<AtomicRecord> atomics;
+        std::vector<Base> parameters;
+        std::string strings;
+        /// the index of each saved node (by handler position)
+        std::vector<uint64_t> visited;
+    public:
+
+        inline Writer() {
+            std::memset(&header, 0, sizeof(Header));
+            std::memcpy(header.magic, "CPPADCGG", 8);
+            header.version = VERSION;
+            header.endianness = ENDIANNESS;
+            header.baseSize = sizeof(Base);
+        }
+
+        inline uint64_t addString(const std::string& s) {
+            uint64_t pos = strings.size();
+            strings += s;
+            return pos;
+        }
+
+        inline ArgRecord makeArgRecord(const Arg& a) {
+            ArgRecord r;
+            if (a.getOperation() != nullptr) {
+                r.node = visited[a.getOperation()->getHandlerPosition()];
+                r.parameter = NONE;
+            } else {
+                r.node = NONE;
+                r.parameter = parameters.size();
+                parameters.push_back(*a.getParameter());
+            }
+            return r;
+        }
+
+        /**
+         * Adds a node whose arguments have already been added
+         */
+        inline void addNode(const Node& node) {
+            CGOpCode op = node.getOperationType();
+            switch (op) {
+                case CGOpCode::IndexDeclaration:
+                case CGOpCode::Index:
+                case CGOpCode::IndexAssign:
+                case CGOpCode::LoopStart:
+                case CGOpCode::LoopIndexedIndep:
+                case CGOpCode::LoopIndexedDep:
+                case CGOpCode::LoopIndexedTmp:
+                case CGOpCode::LoopEnd:
+                case CGOpCode::TmpDcl:
+                case CGOpCode::Tmp:
+                case CGOpCode::IndexCondExpr:
+                    throw CGException("Unable to save operation graphs with loops (found operation ", op, ")");
+                default:
+                    break;
+            }
+
+            NodeRecord r;
+            r.op = uint32_t(op);
+            r.info = info.size();
+            r.args = args.size();
+
+            if (op == CGOpCode::Pri) {
+                const auto& print = static_cast<const PrintOperationNode<Base>&>(node);
+                info.push_back(addString(print.getBeforeString()));
+                info.push_back(print.getBeforeString().size());
+                info.push_back(addString(print.getAfterString()));
+                info.push_back(print.getAfterString().size());
+            } else {
+                const std::vector<size_t>& nodeInfo = node.getInfo();
+                info.insert(info.end(), nodeInfo.begin(), nodeInfo.end());
+                if ((op == CGOpCode::AtomicForward || op == CGOpCode::AtomicReverse) && !nodeInfo.empty())
+                    addAtomic(node, nodeInfo[0]);
+            }
+            r.nInfo = uint32_t(info.size() - r.info);
+
+            for (const Arg& a : node.getArguments()) {
+                args.push_back(makeArgRecord(a));
+            }
+            r.nArgs = uint32_t(node.getArguments().size());
+
+            const std::string* name = node.getName();
+            if (name != nullptr) {
+                r.name = addString(*name);
+                r.nameLength = uint32_t(name->size());
+            } else {
+                r.name = 0;
+                r.nameLength = NO_NAME;
+            }
+
+            nodes.push_back(r);
+            nodePtrs.push_back(&node);
+        }
+
+        /**
+         * Adds a node and all the nodes it depends on (in a topological
+         * order)
+         */
+        inline void addNodes(const Node& root) {
+            if (visited[root.getHandlerPosition()] != NONE)
+                return;
+
+            // depth-first search without recursion (graphs can be very deep)
+            std::vector<std::pair<const Node*, size_t> > stack;
+            stack.emplace_back(&root, 0);
+            while (!stack.empty()) {
+                const Node* node = stack.back().first;
+                size_t& a = stack.back().second;
+                const std::vector<Arg>& nodeArgs = node->getArguments();
+
+                for (; a < nodeArgs.size(); a++) {
+                    const Node* arg = nodeArgs[a].getOperation();
+                    if (arg != nullptr && visited[arg->getHandlerPosition()] == NONE)
+                        break;
+                }
+
+                if (a < nodeArgs.size()) {
+                    stack.emplace_back(nodeArgs[a].getOperation(), 0);
+                } else {
+                    if (node->getOperationType() == CGOpCode::Inv) {
+                        throw CGException("Unable to save the operation graph: an independent variable was not provided");
+                    }
+                    visited[node->getHandlerPosition()] = nodes.size();
+                    addNode(*node);
+                    stack.pop_back();
+                }
+            }
+        }
+
+        inline void addAtomic(const Node& node,
+                              size_t id) {
+            for (const AtomicRecord& a : atomics) {
+                if (a.id == id)
+                    return;
+            }
+            std::string name = node.getCodeHandler()->getAtomicFunctionName(id);
+            if (name.empty()) {
+                throw CGException("Unable to save the operation graph: unknown atomic function with ID ", id);
+            }
+            AtomicRecord a;
+            a.id = id;
+            a.name = addString(name);
+            a.nameLength = name.size();
+            atomics.push_back(a);
+        }
+
+        inline void write(std::ostream& out) {
+            header.nNodes = nodes.size();
+            header.nInfo = info.size();
+            header.nArgs = args.size();
+            header.nAtomics = atomics.size();
+            header.nParameters = parameters.size();
+            header.stringBytes = strings.size();
+
+            static const char zeros[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+
+            out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+            writeSection(out, nodes);
+            writeSection(out, info);
+            writeSection(out, args);
+            writeSection(out, dependents);
+            writeSection(out, atomics);
+            writeSection(out, parameters);
+            out.write(zeros, padding(parameters.size() * sizeof(Base)));
+            out.write(strings.data(), strings.size());
+            out.write(zeros, padding(strings.size()));
+        }
+
+        template<class T>
+        static inline void writeSection(std::ostream& out,
+                                        const std::vector<T>& v) {
+            if (!v.empty())
+                out.write(reinterpret_cast<const char*>(v.data()), v.size() * sizeof(T));
+        }
+    };
+
+    /**
+     * Validates and provides access to the sections of a saved graph
+     */
+    class Reader {
+    public:
+        const char* data;
+        size_t size;
+        Header header;
+        size_t nodeStart;
+        size_t infoStart;
+        size_t argStart;
+        size_t depStart;
+        size_t atomicStart;
+        size_t paramStart;
+        size_t stringStart;
+    public:
+
+        inline Reader(const char* d,
+                      size_t s) :
+            data(d),
+            size(s) {
+            if (size < sizeof(Header)) {
+                throw CGException("Invalid operation graph: too small");
+            }
+            std::memcpy(&header, data, sizeof(Header));
+
+            if (std::memcmp(header.magic, "CPPADCGG", 8) != 0) {
+                throw CGException("Invalid operation graph: unknown format");
+            }
+            if (header.version > VERSION) {
+                throw CGException("Unsupported operation graph version ", header.version, " (the newest supported version is ", VERSION, ")");
+            }
+            if (header.endianness != ENDIANNESS) {
+                throw CGException("Unable to load an operation graph saved in a machine with a different byte order");
+            }
+            if (header.baseSize != sizeof(Base)) {
+                throw CGException("Unable to load an operation graph saved with a different base type");
+            }
+            if (header.nIndependents > header.nNodes) {
+                throw CGException("Invalid operation graph: invalid number of independent variables");
+            }
+
+            size_t pos = sizeof(Header);
+            nodeStart = section(pos, header.nNodes, sizeof(NodeRecord));
+            infoStart = section(pos, header.nInfo, sizeof(uint64_t));
+            argStart = section(pos, header.nArgs, sizeof(ArgRecord));
+            depStart = section(pos, header.nDependents, sizeof(ArgRecord));
+            atomicStart = section(pos, header.nAtomics, sizeof(AtomicRecord));
+            paramStart = section(pos, header.nParameters, sizeof(Base));
+            stringStart = section(pos, header.stringBytes, 1);
+        }
+
+        template<class T>
+        inline T record(size_t start,
+                        uint64_t n,
+                        uint64_t index) const {
+            if (index >= n) {
+                throw CGException("Invalid operation graph: index out of range");
+            }
+            T r;
+            std::memcpy(&r, data + start + index * sizeof(T), sizeof(T));
+            return r;
+        }
+
+        inline std::string string(uint64_t offset,
+                                  uint64_t length) const {
+            if (offset > header.stringBytes || length > header.stringBytes - offset) {
+                throw CGException("Invalid operation graph: string out of range");
+            }
+            return std::string(data + stringStart + offset, length);
+        }
+
+        /**
+         * @param nodes the already created nodes
+         * @param maxNode the number of nodes which can be referenced
+         */
+        inline Arg argument(const ArgRecord& a,
+                            const std::vector<Node*>& nodes,
+                            size_t maxNode) const {
+            if (a.node != NONE) {
+                if (a.node >= maxNode) {
+                    throw CGException("Invalid operation graph: invalid argument");
+                }
+                return Arg(*nodes[a.node]);
+            } else {
+                if (a.parameter >= header.nParameters) {
+                    throw CGException("Invalid operation graph: invalid parameter");
+                }
+                Base p;
+                std::memcpy(&p, data + paramStart + a.parameter * sizeof(Base), sizeof(Base));
+                return Arg(p);
+            }
+        }
+
+    private:
+
+        inline size_t section(size_t& pos,
+                              uint64_t n,
+                              size_t elSize) const {
+            size_t start = pos;
+            if (n > (size - pos) / elSize) {
+                throw CGException("Invalid operation graph: truncated data");
+            }
+            uint64_t bytes = n * elSize;
+            pos += bytes + padding(bytes);
+            if (pos > size)
+                pos = size; // the padding of the last section is optional
+            return start;
+        }
+    };
+};
+
+template<class Base>
+const uint32_t GraphSerializer<Base>::VERSION;
+
+template<class Base>
+const uint32_t GraphSerializer<Base>::ENDIANNESS;
+
+template<class Base>
+const uint64_t GraphSerializer<Base>::NONE;
+
+template<class Base>
+const uint32_t GraphSerializer<Base>::NO_NAME;
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -0,0 +1,534 @@
+#ifndef CPPAD_CG_GRAPH_SPARSITY_INCLUDED
+#define CPPAD_CG_GRAPH_SPARSITY_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Ciengis
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Determines Jacobian and Hessian sparsity patterns by propagating
+ * dependencies directly over the operation graph of a CodeHandler
+ * (without any CppAD sweep).
+ *
+ * Dependency patterns are stored as sorted index vectors which are shared
+ * between nodes whenever an operation does not add new dependencies (e.g.
+ * unary operations or additions where one pattern contains the other).
+ * Hessian patterns are determined using the non-linear interactions of each
+ * operation (edge pushing) and can be evaluated with several threads.
+ *
+ * Loops (index operations) are not supported and atomic functions are
+ * handled conservatively (dense in all of their arguments).
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class GraphSparsity {
+public:
+    using Node = OperationNode<Base>;
+    using VectorSet = std::vector<std::set<size_t> >;
+    using Pattern = std::vector<size_t>;
+protected:
+    /**
+     * how an operation propagates dependencies
+     */
+    enum class OpKind {
+        Linear, // derivatives are constant
+        NonLinearUnary, // non-linear function of a single argument
+        Mul,
+        Div,
+        Pow,
+        Zero, // zero derivatives
+        CondExp, // only the true and false cases are differentiable
+        NonLinear // non-linear in all arguments (conservative)
+    };
+    static const size_t NONE;
+protected:
+    CodeHandler<Base>& handler_;
+    /**
+     * independent variable index of each node (by handler position)
+     */
+    std::vector<size_t> indepIndex_;
+    /**
+     * the dependent nodes (nullptr for parameters)
+     */
+    std::vector<const Node*> dep_;
+    /**
+     * number of independent variables
+     */
+    size_t n_;
+    /**
+     * maximum number of threads used to determine Hessian sparsities
+     */
+    size_t threads_;
+    /**
+     * shared dependency patterns (index 0 is the empty pattern)
+     */
+    std::vector<Pattern> patterns_;
+    /**
+     * the pattern index for each node (by handler position)
+     */
+    std::vector<size_t> nodePattern_;
+    /**
+     * whether or not the dependency patterns were already determined
+     */
+    bool prepared_;
+public:
+
+    /**
+     * @param handler The code handler with the operation graph
+     * @param indep The independent variables (must belong to handler)
+     * @param dep The dependent variables
+     */
+    template<class VectorCG>
+    inline GraphSparsity(CodeHandler<Base>& handler,
+                         const VectorCG& indep,
+                         const VectorCG& dep) :
+        handler_(handler),
+        n_(indep.size()),
+        threads_(1),
+        prepared_(false) {
+
+        indepIndex_.resize(handler_.getManagedNodesCount(), NONE);
+        for (size_t j = 0; j < indep.size(); j++) {
+            const Node* node = indep[j].getOperationNode();
+            if (node == nullptr || node->getOperationType() != CGOpCode::Inv || node->getCodeHandler() != &handler_) {
+                throw CGException("Invalid independent variable ", j);
+            }
+            indepIndex_[node->getHandlerPosition()] = j;
+        }
+
+        dep_.resize(dep.size());
+        for (size_t i = 0; i < dep.size(); i++) {
+            dep_[i] = dep[i].getOperationNode();
+            if (dep_[i] != nullptr && dep_[i]->getCodeHandler() != &handler_) {
+                throw CGException("Dependent variable ", i, " does not belong to the provided handler");
+            }
+        }
+    }
+
+    GraphSparsity(const GraphSparsity&) = delete;
+    GraphSparsity& operator=(const GraphSparsity&) = delete;
+
+    virtual ~GraphSparsity() = default;
+
+    /**
+     * Provides the maximum number of threads used to determine Hessian
+     * sparsities.
+     */
+    inline size_t getThreadCount() const {
+        return threads_;
+    }
+
+    /**
+     * Defines the maximum number of threads used to determine Hessian
+     * sparsities.
+     *
+     * @param threads the number of threads (0 uses the number of hardware
+     *                threads)
+     */
+    inline void setThreadCount(size_t threads) {
+        if (threads == 0) {
+            threads = std::thread::hardware_concurrency();
+        }
+        threads_ = std::max<size_t>(threads, 1);
+    }
+
+    /**
+     * Determines the Jacobian sparsity pattern.
+     *
+     * @return the column indexes for each row of the Jacobian
+     */
+    inline VectorSet jacobianSparsity() {
+        prepare();
+
+        VectorSet jac(dep_.size());
+        for (size_t i = 0; i < dep_.size(); i++) {
+            if (dep_[i] != nullptr) {
+                const Pattern& p = patterns_[nodePattern_[dep_[i]->getHandlerPosition()]];
+                jac[i].insert(p.begin(), p.end());
+            }
+        }
+        return jac;
+    }
+
+    /**
+     * Determines the sparsity pattern of the Hessian of the sum of all
+     * dependents.
+     *
+     * @return the column indexes for each row of the Hessian
+     */
+    inline VectorSet hessianSparsity() {
+        std::vector<size_t> eqs(dep_.size());
+        for (size_t i = 0; i < eqs.size(); i++)
+            eqs[i] = i;
+        return hessianSparsity(eqs);
+    }
+
+    /**
+     * Determines the sparsity pattern of the Hessian of the sum of some
+     * dependents.
+     *
+     * @param eqs The dependent indexes
+     * @return the column indexes for each row of the Hessian
+     */
+    template<class VectorSize>
+    inline VectorSet hessianSparsity(const VectorSize& eqs) {
+        prepare();
+
+        /**
+         * nodes which can affect the selected dependents
+         */
+        const size_t nNodes = nodePattern_.size();
+        std::vector<bool> used(nNodes, false);
+        for (size_t i : eqs) {
+            CPPADCG_ASSERT_KNOWN(i < dep_.size(), "Invalid dependent index")
+            if (dep_[i] != nullptr)
+                used[dep_[i]->getHandlerPosition()] = true;
+        }
+
+        const std::vector<Node*>& nodes = handler_.getManagedNodes();
+        std::vector<const Node*> nonLinear;
+        for (size_t p = nNodes; p-- > 0;) {
+            if (!used[p])
+                continue;
+            const Node& node = *nodes[p];
+            OpKind kind = getOpKind(node);
+            if (kind != OpKind::Linear && kind != OpKind::Zero && kind != OpKind::CondExp)
+                nonLinear.push_back(&node);
+
+            forEachDiffArgument(node, kind, [&](const Node& a) {
+                used[a.getHandlerPosition()] = true;
+            });
+        }
+
+        /**
+         * add the non-linear interactions
+         */
+        size_t nThreads = std::min(threads_, nonLinear.size() / 1024 + 1);
+        if (nThreads <= 1) {
+            VectorSet hess(n_);
+            for (const Node* node : nonLinear)
+                addNonLinearInteractions(*node, hess);
+            return hess;
+        }
+
+        std::vector<VectorSet> partial(nThreads, VectorSet(n_));
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < nThreads; t++) {
+            workers.emplace_back([&, t]() {
+                for (size_t k = t; k < nonLinear.size(); k += nThreads)
+                    addNonLinearInteractions(*nonLinear[k], partial[t]);
+            });
+        }
+        for (auto& w : workers)
+            w.join();
+
+        VectorSet& hess = partial[0];
+        for (size_t t = 1; t < nThreads; t++) {
+            for (size_t j = 0; j < n_; j++) {
+                hess[j].insert(partial[t][j].begin(), partial[t][j].end());
+            }
+        }
+        return std::move(hess);
+    }
+
+    /**
+     * Determines the Hessian sparsity pattern of each dependent.
+     * Dependents are distributed among the available threads.
+     *
+     * @return the Hessian sparsity pattern for each dependent
+     */
+    inline std::vector<VectorSet> hessianSparsities() {
+        prepare();
+
+        const size_t m = dep_.size();
+        std::vector<VectorSet> hess(m);
+
+        size_t nThreads = std::min(threads_, m);
+        if (nThreads <= 1) {
+            std::vector<size_t> visited(nodePattern_.size(), NONE);
+            for (size_t i = 0; i < m; i++) {
+                hess[i] = equationHessianSparsity(i, visited);
+            }
+            return hess;
+        }
+
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < nThreads; t++) {
+            workers.emplace_back([&, t]() {
+                std::vector<size_t> visited(nodePattern_.size(), NONE);
+                for (size_t i = t; i < m; i += nThreads) {
+                    hess[i] = equationHessianSparsity(i, visited);
+                }
+            });
+        }
+        for (auto& w : workers)
+            w.join();
+
+        return hess;
+    }
+
+protected:
+
+    /**
+     * Determines the dependency pattern of every node in a single pass
+     * over the nodes in the order they were created (a topological order).
+     */
+    inline void prepare() {
+        if (prepared_)
+            return;
+
+        const std::vector<Node*>& nodes = handler_.getManagedNodes();
+        const size_t nNodes = nodes.size();
+
+        patterns_.clear();
+        patterns_.emplace_back(); // empty pattern
+        nodePattern_.assign(nNodes, 0);
+
+        Pattern merged;
+
+        for (size_t p = 0; p < nNodes; p++) {
+            const Node& node = *nodes[p];
+
+            if (node.getOperationType() == CGOpCode::Inv) {
+                if (p < indepIndex_.size() && indepIndex_[p] != NONE) {
+                    nodePattern_[p] = patterns_.size();
+                    patterns_.push_back(Pattern(1, indepIndex_[p]));
+                }
+                continue;
+            }
+
+            size_t current = 0;
+            forEachDiffArgument(node, getOpKind(node), [&](const Node& a) {
+                size_t pa = a.getHandlerPosition();
+                if (pa >= p) {
+                    throw CGException("Unable to determine sparsity: operation nodes are not in a topological order");
+                }
+                size_t other = nodePattern_[pa];
+                if (other == current || other == 0) {
+                    return;
+                } else if (current == 0) {
+                    current = other;
+                    return;
+                }
+
+                const Pattern& pc = patterns_[current];
+                const Pattern& po = patterns_[other];
+                merged.clear();
+                std::set_union(pc.begin(), pc.end(), po.begin(), po.end(), std::back_inserter(merged));
+                if (merged.size() == pc.size()) {
+                    return; // po is contained in pc
+                } else if (merged.size() == po.size()) {
+                    current = other; // pc is contained in po
+                } else {
+                    current = patterns_.size();
+                    patterns_.push_back(merged);
+                }
+            });
+
+            nodePattern_[p] = current;
+        }
+
+        prepared_ = true;
+    }
+
+    /**
+     * Determines the Hessian sparsity of a single dependent.
+     *
+     * @param i the dependent index
+     * @param visited the last dependent which visited each node
+     */
+    inline VectorSet equationHessianSparsity(size_t i,
+                                             std::vector<size_t>& visited) const {
+        VectorSet hess(n_);
+        if (dep_[i] == nullptr)
+            return hess;
+
+        std::vector<const Node*> stack;
+        stack.push_back(dep_[i]);
+        visited[dep_[i]->getHandlerPosition()] = i;
+
+        while (!stack.empty()) {
+            const Node& node = *stack.back();
+            stack.pop_back();
+
+            OpKind kind = getOpKind(node);
+            if (kind != OpKind::Linear && kind != OpKind::Zero && kind != OpKind::CondExp)
+                addNonLinearInteractions(node, hess);
+
+            forEachDiffArgument(node, kind, [&](const Node& a) {
+                size_t pa = a.getHandlerPosition();
+                if (visited[pa] != i) {
+                    visited[pa] = i;
+                    stack.push_back(&a);
+                }
+            });
+        }
+
+        return hess;
+    }
+
+    /**
+     * Adds the second order interactions of an operation to a Hessian
+     * sparsity pattern.
+     */
+    inline void addNonLinearInteractions(const Node& node,
+                                         VectorSet& hess) const {
+        const std::vector<Argument<Base> >& args = node.getArguments();
+
+        switch (getOpKind(node)) {
+            case OpKind::Mul:
+                CPPADCG_ASSERT_UNKNOWN(args.size() == 2)
+                addCross(pattern(args[0]), pattern(args[1]), hess);
+                addCross(pattern(args[1]), pattern(args[0]), hess);
+                break;
+            case OpKind::Div:
+                CPPADCG_ASSERT_UNKNOWN(args.size() == 2)
+                addCross(pattern(args[0]), pattern(args[1]), hess);
+                addCross(pattern(args[1]), pattern(args[0]), hess);
+                addCross(pattern(args[1]), pattern(args[1]), hess);
+                break;
+            case OpKind::NonLinearUnary:
+                CPPADCG_ASSERT_UNKNOWN(args.size() == 1)
+                addCross(pattern(args[0]), pattern(args[0]), hess);
+                break;
+            case OpKind::Pow:
+            case OpKind::NonLinear: {
+                std::set<size_t> all;
+                for (const auto& a : args) {
+                    const Pattern& pa = pattern(a);
+                    all.insert(pa.begin(), pa.end());
+                }
+                for (size_t j : all) {
+                    hess[j].insert(all.begin(), all.end());
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    inline const Pattern& pattern(const Argument<Base>& a) const {
+        if (a.getOperation() == nullptr)
+            return patterns_[0];
+        return patterns_[nodePattern_[a.getOperation()->getHandlerPosition()]];
+    }
+
+    static inline void addCross(const Pattern& rows,
+                                const Pattern& cols,
+                                VectorSet& hess) {
+        if (cols.empty())
+            return;
+        for (size_t j : rows) {
+            hess[j].insert(cols.begin(), cols.end());
+        }
+    }
+
+    /**
+     * Calls a function for each argument of an operation which can have a
+     * non-zero derivative.
+     */
+    template<class Function>
+    static inline void forEachDiffArgument(const Node& node,
+                                           OpKind kind,
+                                           Function f) {
+        const std::vector<Argument<Base> >& args = node.getArguments();
+        if (kind == OpKind::Zero)
+            return;
+
+        size_t start = 0;
+        if (kind == OpKind::CondExp) {
+            CPPADCG_ASSERT_UNKNOWN(args.size() == 4)
+            start = 2; // the comparison does not affect derivatives
+        }
+
+        for (size_t a = start; a < args.size(); a++) {
+            const Node* arg = args[a].getOperation();
+            if (arg != nullptr)
+                f(*arg);
+        }
+    }
+
+    static inline OpKind getOpKind(const Node& node) {
+        switch (node.getOperationType()) {
+            case CGOpCode::Assign:
+            case CGOpCode::Abs:
+            case CGOpCode::Add:
+            case CGOpCode::Alias:
+            case CGOpCode::ArrayCreation:
+            case CGOpCode::SparseArrayCreation:
+            case CGOpCode::ArrayElement:
+            case CGOpCode::Pri:
+            case CGOpCode::Sub:
+            case CGOpCode::UnMinus:
+            case CGOpCode::DependentRefRhs:
+                return OpKind::Linear;
+
+            case CGOpCode::Acos:
+            case CGOpCode::Acosh:
+            case CGOpCode::Asin:
+            case CGOpCode::Asinh:
+            case CGOpCode::Atan:
+            case CGOpCode::Atanh:
+            case CGOpCode::Cosh:
+            case CGOpCode::Cos:
+            case CGOpCode::Erf:
+            case CGOpCode::Erfc:
+            case CGOpCode::Exp:
+            case CGOpCode::Expm1:
+            case CGOpCode::Log:
+            case CGOpCode::Log1p:
+            case CGOpCode::Sinh:
+            case CGOpCode::Sin:
+            case CGOpCode::Sqrt:
+            case CGOpCode::Tanh:
+            case CGOpCode::Tan:
+                return OpKind::NonLinearUnary;
+
+            case CGOpCode::Mul:
+                return OpKind::Mul;
+            case CGOpCode::Div:
+                return OpKind::Div;
+            case CGOpCode::Pow:
+                return OpKind::Pow;
+
+            case CGOpCode::Inv:
+            case CGOpCode::Sign:
+                return OpKind::Zero;
+
+            case CGOpCode::ComLt:
+            case CGOpCode::ComLe:
+            case CGOpCode::ComEq:
+            case CGOpCode::ComGe:
+            case CGOpCode::ComGt:
+            case CGOpCode::ComNe:
+                return OpKind::CondExp;
+
+            default:
+                // atomic functions and any other operation
+                return OpKind::NonLinear;
+        }
+    }
+};
+
+template<class Base>
+const size_t GraphSparsity<Base>::NONE = (std::numeric_limits<size_t>::max)();
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -0,0 +1,357 @@
+#ifndef CPPAD_CG_JOB_PROFILER_INCLUDED
+#define CPPAD_CG_JOB_PROFILER_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Ciengis
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Records the nested jobs reported by a JobTimer (source generation,
+ * sparsity determination, compilation, ...) together with the memory
+ * usage of the process and the metrics reported for each job (e.g. the
+ * number of operation nodes).
+ * The results can be saved in JSON or in the Chrome trace event format
+ * (which can be opened with chrome://tracing or Perfetto).
+ *
+ * Usage:
+ * @code
+ * JobProfiler profiler;
+ * libSourceGen.addListener(profiler);
+ * ...
+ * profiler.saveChromeTrace("trace.json");
+ * @endcode
+ *
+ * @author Joao Leal
+ */
+class JobProfiler : public JobListener {
+public:
+    using clock = std::chrono::steady_clock;
+
+    /**
+     * A completed or running job
+     */
+    struct Record {
+        /// job name
+        std::string name;
+        /// the action name of the job type
+        std::string action;
+        /// index of the enclosing job (-1 for top level jobs)
+        int parent;
+        /// nesting level
+        size_t depth;
+        /// starting time relative to the creation of the profiler (in microseconds)
+        double begin;
+        /// elapsed time (in microseconds, negative while running)
+        double elapsed;
+        /// resident set size when the job started (in bytes)
+        size_t rssBegin;
+        /// resident set size when the job ended (in bytes)
+        size_t rssEnd;
+        /// highest resident set size of the process when the job ended (in bytes)
+        size_t peakRss;
+        /// whether or not the process peak resident set size increased during the job
+        bool newPeak;
+        /// trace thread (1 for the main thread and a unique value for each background job)
+        size_t thread;
+        /// metrics reported for the job
+        std::vector<std::pair<std::string, double> > info;
+    };
+protected:
+    clock::time_point _start;
+    std::vector<Record> _records;
+    /// indexes of the running jobs
+    std::vector<size_t> _running;
+    /// whether or not the memory usage is recorded
+    bool _memory;
+    /// peak resident set size at the beginning of each running job
+    std::vector<size_t> _peakBegin;
+    /// the number of jobs completed by other threads
+    size_t _backgroundJobs;
+public:
+
+    inline JobProfiler() :
+        _start(clock::now()),
+        _memory(true),
+        _backgroundJobs(0) {
+    }
+
+    /**
+     * @return the recorded jobs in the order they started
+     */
+    inline const std::vector<Record>& getRecords() const {
+        return _records;
+    }
+
+    inline bool isRecordMemory() const {
+        return _memory;
+    }
+
+    /**
+     * Defines whether or not the memory usage of the process is recorded
+     * at the beginning and at the end of each job.
+     */
+    inline void setRecordMemory(bool memory) {
+        _memory = memory;
+    }
+
+    /**
+     * Discards all the recorded jobs.
+     */
+    inline void reset() {
+        _records.clear();
+        _running.clear();
+        _peakBegin.clear();
+        _backgroundJobs = 0;
+        _start = clock::now();
+    }
+
+    void jobStarted(const std::vector<Job>& job) override {
+        const Job& j = job.back();
+
+        Record r;
+        r.name = j.name();
+        r.action = j.getType().getActionName();
+        r.parent = _running.empty() ? -1 : int(_running.back());
+        r.depth = _running.size();
+        r.begin = toMicroseconds(j.beginTime() - _start);
+        r.elapsed = -1;
+        r.newPeak = false;
+        size_t peak = 0;
+        readMemory(r.rssBegin, peak);
+        r.rssEnd = 0;
+        r.peakRss = 0;
+        r.thread = 1;
+
+        _running.push_back(_records.size());
+        _peakBegin.push_back(peak);
+        _records.push_back(std::move(r));
+    }
+
+    void jobEndended(const std::vector<Job>& job,
+                     duration elapsed) override {
+        if (_running.empty())
+            return; // started before the profiler was registered
+
+        Record& r = _records[_running.back()];
+        r.elapsed = toMicroseconds(elapsed);
+        if (job.back().isBackground()) {
+            // the job started before it was reported
+            r.begin = toMicroseconds(job.back().beginTime() - _start);
+            r.thread = 2 + _backgroundJobs++;
+        }
+        readMemory(r.rssEnd, r.peakRss);
+        r.newPeak = r.peakRss > _peakBegin.back();
+
+        _running.pop_back();
+        _peakBegin.pop_back();
+    }
+
+    void jobInfo(const std::vector<Job>& job,
+                 const std::string& name,
+                 double value) override {
+        if (_running.empty())
+            return;
+
+        _records[_running.back()].info.emplace_back(name, value);
+    }
+
+    /**
+     * Saves the recorded jobs in the Chrome trace event format.
+     * Each job is a complete event and the memory usage is provided as
+     * a counter.
+     */
+    inline void saveChromeTrace(std::ostream& out) const {
+        OStreamConfigRestore osr(out);
+        out << std::fixed << std::setprecision(3);
+
+        out << "{\"traceEvents\": [";
+        bool first = true;
+        for (const Record& r : _records) {
+            if (r.elapsed < 0)
+                continue;
+
+            out << (first ? "\n" : ",\n");
+            first = false;
+
+            out << "  {\"name\": ";
+            printString(out, r.name.empty() ? r.action : r.name);
+            out << ", \"cat\": ";
+            printString(out, r.action);
+            out << ", \"ph\": \"X\", \"pid\": 1, \"tid\": " << r.thread
+                << ", \"ts\": " << r.begin
+                << ", \"dur\": " << r.elapsed
+                << ", \"args\": {";
+            printArgs(out, r);
+            out << "}}";
+
+            if (_memory && r.thread == 1) {
+                // the memory of background jobs is only read when they are reported
+                out << ",\n  {\"name\": \"memory\", \"ph\": \"C\", \"pid\": 1, \"ts\": " << r.begin
+                    << ", \"args\": {\"rss_MiB\": " << toMiB(r.rssBegin) << "}}";
+                out << ",\n  {\"name\": \"memory\", \"ph\": \"C\", \"pid\": 1, \"ts\": " << r.begin + r.elapsed
+                    << ", \"args\": {\"rss_MiB\": " << toMiB(r.rssEnd) << "}}";
+            }
+        }
+        out << "\n], \"displayTimeUnit\": \"ms\"}\n";
+    }
+
+    /**
+     * Saves the recorded jobs in the Chrome trace event format.
+     *
+     * @throws CGException if the file could not be saved
+     */
+    inline void saveChromeTrace(const std::string& file) const {
+        std::ofstream out(file.c_str());
+        saveChromeTrace(out);
+        out.close();
+        if (out.fail()) {
+            throw CGException("Failed to save trace file '", file, "'");
+        }
+    }
+
+    /**
+     * Saves the recorded jobs as a JSON array with one object per job
+     * (nested jobs reference their parent by index).
+     */
+    inline void saveJson(std::ostream& out) const {
+        OStreamConfigRestore osr(out);
+        out << std::fixed << std::setprecision(3);
+
+        out << "[";
+        for (size_t i = 0; i < _records.size(); i++) {
+            const Record& r = _records[i];
+
+            out << (i == 0 ? "\n" : ",\n");
+            out << "  {\"index\": " << i
+                << ", \"parent\": " << r.parent
+                << ", \"depth\": " << r.depth
+                << ", \"name\": ";
+            printString(out, r.name);
+            out << ", \"action\": ";
+            printString(out, r.action);
+            out << ", \"begin_us\": " << r.begin
+                << ", \"elapsed_us\": " << r.elapsed;
+            printArgs(out, r, true);
+            out << "}";
+        }
+        out << "\n]\n";
+    }
+
+    /**
+     * Saves the recorded jobs as a JSON array.
+     *
+     * @throws CGException if the file could not be saved
+     */
+    inline void saveJson(const std::string& file) const {
+        std::ofstream out(file.c_str());
+        saveJson(out);
+        out.close();
+        if (out.fail()) {
+            throw CGException("Failed to save profiling file '", file, "'");
+        }
+    }
+
+protected:
+
+    inline void readMemory(size_t& rss,
+                           size_t& peak) const {
+        if (!_memory || !system::getMemoryUsage(rss, peak)) {
+            rss = 0;
+            peak = 0;
+        }
+    }
+
+    /**
+     * Prints the memory usage and the additional information of a job as
+     * JSON object members.
+     *
+     * @param separator whether or not to print a separator before the
+     *                  first member (only if there is a member)
+     */
+    inline void printArgs(std::ostream& out,
+                          const Record& r,
+                          bool separator = false) const {
+        bool first = !separator;
+        if (_memory) {
+            if (!first)
+                out << ", ";
+            out << "\"rss_begin_MiB\": " << toMiB(r.rssBegin)
+                << ", \"rss_end_MiB\": " << toMiB(r.rssEnd)
+                << ", \"peak_rss_MiB\": " << toMiB(r.peakRss)
+                << ", \"new_peak\": " << (r.newPeak ? "true" : "false");
+            first = false;
+        }
+        for (const auto& p : r.info) {
+            if (!first)
+                out << ", ";
+            first = false;
+            printString(out, p.first);
+            out << ": ";
+            printNumber(out, p.second);
+        }
+    }
+
+    static inline double toMicroseconds(duration d) {
+        return std::chrono::duration<double, std::micro>(d).count();
+    }
+
+    /**
+     * Prints a number (JSON has no representation for NaN or infinity)
+     */
+    static inline void printNumber(std::ostream& out,
+                                   double value) {
+        if (std::isfinite(value))
+            out << value;
+        else
+            out << "null";
+    }
+
+    static inline double toMiB(size_t bytes) {
+        return bytes / (1024.0 * 1024.0);
+    }
+
+    static inline void printString(std::ostream& out,
+                                   const std::string& s) {
+        out << '"';
+        for (char c : s) {
+            switch (c) {
+                case '"':
+                    out << "\\\"";
+                    break;
+                case '\\':
+                    out << "\\\\";
+                    break;
+                case '\n':
+                    out << "\\n";
+                    break;
+                case '\t':
+                    out << "\\t";
+                    break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                        out << ' ';
+                    else
+                        out << c;
+            }
+        }
+        out << '"';
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
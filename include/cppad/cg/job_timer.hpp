@@ -77,6 +77,11 @@ public:
     static const JobType STATIC_MODEL_LIBRARY;
     static const JobType ASSEMBLE_STATIC_LIBRARY;
     static const JobType JIT_MODEL_LIBRARY;
+    static const JobType PROFILE_TRAINING;
+    static const JobType PROFILE_MERGE;
+    static const JobType PROFILE_USE;
+    static const JobType SPARSITY;
+    static const JobType STAGE;
 };
 
 template<int T>
@@ -115,6 +120,21 @@ const JobType JobTypeHolder<T>::ASSEMBLE_STATIC_LIBRARY("assembling static libra
 template<int T>
 const JobType JobTypeHolder<T>::JIT_MODEL_LIBRARY("preparing JIT library", "prepared JIT library");
 
+template<int T>
+const JobType JobTypeHolder<T>::PROFILE_TRAINING("evaluating instrumented library", "evaluated instrumented library");
+
+template<int T>
+const JobType JobTypeHolder<T>::PROFILE_MERGE("merging profile data", "merged profile data");
+
+template<int T>
+const JobType JobTypeHolder<T>::PROFILE_USE("optimizing library with profile data", "optimized library with profile data");
+
+template<int T>
+const JobType JobTypeHolder<T>::SPARSITY("determining sparsity of", "determined sparsity of");
+
+template<int T>
+const JobType JobTypeHolder<T>::STAGE("stage", "stage");
+
 /**
  * Represents a task for which the execution time will be determined
  */
@@ -136,14 +156,26 @@ private:
      * Whether or not there are/were other jobs inside
      */
     bool _nestedJobs;
+    /**
+     * Whether or not the job is only reported to listeners (not printed)
+     */
+    bool _silent;
+    /**
+     * Whether or not the job was performed by another thread
+     * (see JobTimer::completedJob())
+     */
+    bool _background;
 public:
 
     inline Job(const JobType& type,
-               const std::string& name) :
+               const std::string& name,
+               bool silent = false) :
         _type(&type),
         _name(name),
         _beginTime(std::chrono::steady_clock::now()),
-        _nestedJobs(false) {
+        _nestedJobs(false),
+        _silent(silent),
+        _background(false) {
     }
 
     inline const JobType& getType()const {
@@ -158,6 +190,22 @@ public:
         return _beginTime;
     }
 
+    /**
+     * @return true if the job is not printed in verbose mode
+     *         (see JobTimer::startingStage())
+     */
+    inline bool isSilent() const {
+        return _silent;
+    }
+
+    /**
+     * @return true if the job was completed by another thread and only
+     *         registered afterwards (see JobTimer::completedJob())
+     */
+    inline bool isBackground() const {
+        return _background;
+    }
+
     inline virtual ~Job() {
     }
 
@@ -175,6 +223,21 @@ public:
 
     virtual void jobEndended(const std::vector<Job>& job,
                              duration elapsed) = 0;
+
+    /**
+     * Called when a metric is reported for the currently running job
+     * (e.g. the number of operation nodes).
+     *
+     * @param job the currently running jobs (the last one is the innermost)
+     * @param name the metric name
+     * @param value the metric value
+     */
+    virtual void jobInfo(const std::vector<Job>& job,
+                         const std::string& name,
+                         double value) {
+    }
+
+    inline virtual ~JobListener() = default;
 };
 
 /**
@@ -263,7 +326,7 @@ public:
 
         _jobs.push_back(Job(type, jobName));
 
-        if (_verbose) {
+        if (_verbose && !isInSilentJob()) {
             OStreamConfigRestore osr(std::cout);
 
             Job& job = _jobs.back();
@@ -295,6 +358,56 @@ public:
         }
     }
 
+    /**
+     * Starts a fine grained job which is only reported to the listeners
+     * (it is never printed).
+     * It must be terminated with finishedJob().
+     *
+     * @param stageName the stage name
+     */
+    inline void startingStage(const std::string& stageName) {
+        _jobs.push_back(Job(JobTypeHolder<>::STAGE, stageName, true));
+
+        for (JobListener* l : _listeners) {
+            l->jobStarted(_jobs);
+        }
+    }
+
+    /**
+     * Reports a metric of the currently running job to the listeners
+     * (e.g. the number of operation nodes).
+     *
+     * @param name the metric name
+     * @param value the metric value
+     */
+    inline void reportJobInfo(const std::string& name,
+                              double value) {
+        CPPADCG_ASSERT_UNKNOWN(_jobs.size() > 0);
+
+        for (JobListener* l : _listeners) {
+            l->jobInfo(_jobs, name, value);
+        }
+    }
+
+    /**
+     * Registers a job which has already been completed elsewhere
+     * (e.g. by a background thread).
+     *
+     * @param jobName the job name
+     * @param type the job type
+     * @param elapsed the time it took to complete the job
+     * @param prefix a prefix used for printing
+     */
+    inline void completedJob(const std::string& jobName,
+                             const JobType& type,
+                             std::chrono::steady_clock::duration elapsed,
+                             const std::string& prefix = "") {
+        startingJob(jobName, type, prefix);
+        _jobs.back()._beginTime -= elapsed;
+        _jobs.back()._background = true;
+        finishedJob();
+    }
+
     inline void finishedJob() {
         using namespace std::chrono;
 
@@ -304,7 +417,7 @@ public:
 
         std::chrono::steady_clock::duration elapsed = steady_clock::now() - job.beginTime();
 
-        if (_verbose) {
+        if (_verbose && !isInSilentJob()) {
             OStreamConfigRestore osr(std::cout);
 
             if (job._nestedJobs) {
@@ -329,6 +442,16 @@ public:
         _jobs.pop_back();
     }
 
+private:
+
+    inline bool isInSilentJob() const {
+        for (const Job& j : _jobs) {
+            if (j._silent)
+                return true;
+        }
+        return false;
+    }
+
 };
 
 } // END cg namespace
@@ -68,6 +68,13 @@ struct LangCAtomicFun {
                    const Array tx[],
                    Array* px,
                    const Array py[]);
+
+    /**
+     * Memory used by the compiled code to hold temporary variables
+     * (only used if the source code was generated with a workspace for
+     * temporary variables, it can be null otherwise).
+     */
+    void* workspace;
 };
 
 }
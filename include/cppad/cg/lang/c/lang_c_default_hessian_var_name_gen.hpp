@@ -110,6 +110,16 @@ public:
         return _nameGen->generateTemporary(variable, id);
     }
 
+    bool isCompactTemporaryNames() const override {
+        return _nameGen->isCompactTemporaryNames();
+    }
+
+    void appendTemporary(std::string& out,
+                         const OperationNode<Base>& variable,
+                         size_t id) override {
+        _nameGen->appendTemporary(out, variable, id);
+    }
+
     std::string generateTemporaryArray(const OperationNode<Base>& variable,
                                        size_t id) override {
         return _nameGen->generateTemporaryArray(variable, id);
@@ -47,6 +47,8 @@ protected:
     size_t _maxTemporaryArrayID;
     // the highest ID used for the temporary sparse array variables
     size_t _maxTemporarySparseArrayID;
+    // whether or not temporary variable names are only created in the source code
+    bool _compactTemporaryNames;
 public:
 
     inline explicit LangCDefaultVariableNameGenerator(std::string depName = "y",
@@ -62,7 +64,8 @@ public:
         _minTemporaryID(0), // not really required (but it avoids warnings)
         _maxTemporaryID(0), // not really required (but it avoids warnings)
         _maxTemporaryArrayID(0), // not really required (but it avoids warnings)
-        _maxTemporarySparseArrayID(0) { // not really required (but it avoids warnings)
+        _maxTemporarySparseArrayID(0), // not really required (but it avoids warnings)
+        _compactTemporaryNames(false) {
 
         this->_independent.push_back(FuncArgument(_indepName));
         this->_dependent.push_back(FuncArgument(_depName));
@@ -73,6 +76,46 @@ public:
 
     inline virtual ~LangCDefaultVariableNameGenerator() = default;
 
+    /**
+     * Defines whether or not temporary variables are saved in an array.
+     * When disabled, each temporary variable is declared as a local scalar
+     * (e.g. v5) which allows the C compiler to keep it in a register.
+     * Local scalars cannot be shared between functions and therefore the
+     * generated source code is never split into several functions.
+     *
+     * @param array true to use an array for the temporary variables
+     */
+    inline void setTemporaryArray(bool array) {
+        this->_temporary[0].array = array;
+    }
+
+    /**
+     * Whether or not temporary variables are saved in an array.
+     */
+    inline bool isTemporaryArray() const {
+        return this->_temporary[0].array;
+    }
+
+    /**
+     * Defines whether or not the names of temporary variables are written
+     * directly into the source code instead of being saved in each
+     * operation node.
+     * The (array, index) pair of a temporary is obtained from its variable
+     * ID only when it is used, which avoids one string allocation per
+     * temporary variable in very large models.
+     * Subclasses which change generateTemporary() must also change
+     * appendTemporary() before enabling this option.
+     *
+     * @param compact true to avoid saving temporary variable names
+     */
+    inline void setCompactTemporaryNames(bool compact) {
+        _compactTemporaryNames = compact;
+    }
+
+    inline bool isCompactTemporaryNames() const override {
+        return _compactTemporaryNames;
+    }
+
     inline size_t getMinTemporaryVariableID() const override {
         return _minTemporaryID;
     }
@@ -122,6 +165,19 @@ public:
         return _ss.str();
     }
 
+    inline void appendTemporary(std::string& out,
+                                const OperationNode<Base>& variable,
+                                size_t id) override {
+        out += _tmpName;
+        if (this->_temporary[0].array) {
+            out += '[';
+            out += std::to_string(id - this->_minTemporaryID);
+            out += ']';
+        } else {
+            out += std::to_string(id);
+        }
+    }
+
     std::string generateTemporaryArray(const OperationNode<Base>& variable,
                                        size_t id) override {
         _ss.clear();
@@ -227,14 +283,14 @@ public:
                                           size_t idFirst,
                                           const OperationNode<Base>& varSecond,
                                           size_t idSecond) override {
-        return idFirst + 1 == idSecond;
+        return this->_temporary[0].array && idFirst + 1 == idSecond;
     }
 
     bool isInSameTemporaryVarArray(const OperationNode<Base>& var1,
                                    size_t id1,
                                    const OperationNode<Base>& var2,
                                    size_t id2) override {
-        return true;
+        return this->_temporary[0].array;
     }
 
 protected:
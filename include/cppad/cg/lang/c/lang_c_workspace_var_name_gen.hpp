@@ -0,0 +1,103 @@
+#ifndef CPPAD_CG_LANG_C_WORKSPACE_VAR_NAME_GEN_INCLUDED
+#define CPPAD_CG_LANG_C_WORKSPACE_VAR_NAME_GEN_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Ciengis
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Creates variables names for source code where the independent variables
+ * registered after the original independents are read from arbitrary
+ * positions of a second input array (a workspace shared by several
+ * functions).
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class LangCWorkspaceVarNameGenerator : public LangCDefaultReverse2VarNameGenerator<Base> {
+protected:
+    using Super = LangCDefaultReverse2VarNameGenerator<Base>;
+protected:
+    // position in the workspace of each additional independent variable
+    const std::vector<size_t> _positions;
+public:
+
+    /**
+     * @param nameGen the name generator used for the original independents
+     *                and for all other variables
+     * @param n the number of original independent variables
+     * @param workspaceName the array name of the workspace
+     * @param positions the position in the workspace of each independent
+     *                  variable registered after the original ones
+     */
+    LangCWorkspaceVarNameGenerator(VariableNameGenerator<Base>* nameGen,
+                                   size_t n,
+                                   const std::string& workspaceName,
+                                   std::vector<size_t> positions) :
+        Super(nameGen, n, workspaceName, positions.size(), workspaceName + "_"),
+        _positions(std::move(positions)) {
+        this->_independent.pop_back(); // there is no second level
+    }
+
+    inline virtual ~LangCWorkspaceVarNameGenerator() = default;
+
+    std::string generateIndependent(const OperationNode<Base>& independent,
+                                    size_t id) override {
+        if (id < this->_minLevel1ID) {
+            return this->_nameGen->generateIndependent(independent, id);
+        } else {
+            this->_ss.clear();
+            this->_ss.str("");
+            this->_ss << this->_level1Name << "[" << position(id) << "]";
+            return this->_ss.str();
+        }
+    }
+
+    size_t getIndependentArrayIndex(const OperationNode<Base>& indep,
+                                    size_t id) override {
+        if (id < this->_minLevel1ID)
+            return this->_nameGen->getIndependentArrayIndex(indep, id);
+        else
+            return position(id);
+    }
+
+    bool isConsecutiveInIndepArray(const OperationNode<Base>& indepFirst,
+                                   size_t id1,
+                                   const OperationNode<Base>& indepSecond,
+                                   size_t id2) override {
+        if ((id1 < this->_minLevel1ID) != (id2 < this->_minLevel1ID))
+            return false;
+
+        if (id1 < this->_minLevel1ID)
+            return this->_nameGen->isConsecutiveInIndepArray(indepFirst, id1, indepSecond, id2);
+
+        return position(id1) + 1 == position(id2);
+    }
+
+protected:
+
+    inline size_t position(size_t id) const {
+        CPPADCG_ASSERT_KNOWN(id >= this->_minLevel1ID && id - this->_minLevel1ID < _positions.size(),
+                             "Invalid workspace variable ID")
+        return _positions[id - this->_minLevel1ID];
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
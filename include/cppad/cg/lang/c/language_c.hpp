@@ -38,6 +38,7 @@ public:
 public:
     static const std::string U_INDEX_TYPE;
     static const std::string ATOMICFUN_STRUCT_DEFINITION;
+    static const size_t WORKSPACE_ALIGNMENT;
 protected:
     static const std::string _C_COMP_OP_LT;
     static const std::string _C_COMP_OP_LE;
@@ -72,6 +73,10 @@ protected:
     std::ostringstream _code;
     // creates the variable names
     VariableNameGenerator<Base>* _nameGen;
+    // whether or not the names of temporary variables are not saved in the operation nodes
+    bool _compactTemporaryNames;
+    // auxiliary string used for the names of temporary variables which are not saved
+    std::string _nameBuffer;
     // auxiliary string stream
     std::ostringstream _ss;
     //
@@ -95,6 +100,8 @@ protected:
     std::string _functionName;
     // the maximum number of assignments (~lines) per local function
     size_t _maxAssignmentsPerFunction;
+    // whether or not local functions are created by partitioning the operation graph
+    bool _functionGraphPartitioning;
     // the maximum number of operations per variable assignment
     size_t _maxOperationsPerAssignment;
     //  maps file names to with their contents
@@ -110,6 +117,14 @@ protected:
     std::vector<const LoopStartOperationNode<Base>*> _currentLoops;
     // the maximum precision used to print values
     size_t _parameterPrecision;
+    // whether or not the temporary arrays are placed in the workspace of the atomic functions argument
+    bool _temporaryWorkspace;
+    // the maximum number of bytes of the workspace required by the generated functions (not owned)
+    size_t* _workspaceSize;
+    // whether or not to generate restrict pointers and loop vectorization hints
+    bool _vectorizationHints;
+    // loops whose iterations are independent from each other
+    std::set<const LoopStartOperationNode<Base>*> _independentLoops;
 private:
     std::vector<std::string> funcArgDcl_;
     std::vector<std::string> localFuncArgDcl_;
@@ -133,6 +148,7 @@ public:
         _outArgName("out"),
         _atomicArgName("atomicFun"),
         _nameGen(nullptr),
+        _compactTemporaryNames(false),
         _streamStack(_code),
         _independentSize(0), // not really required (but it avoids warnings)
         _minTemporaryVarID(0), // not really required (but it avoids warnings)
@@ -140,9 +156,13 @@ public:
         _depAssignOperation("="),
         _ignoreZeroDepAssign(false),
         _maxAssignmentsPerFunction(0),
+        _functionGraphPartitioning(false),
         _maxOperationsPerAssignment((std::numeric_limits<size_t>::max)()),
         _sources(nullptr),
-        _parameterPrecision(std::numeric_limits<Base>::digits10) {
+        _parameterPrecision(std::numeric_limits<Base>::digits10),
+        _temporaryWorkspace(false),
+        _workspaceSize(nullptr),
+        _vectorizationHints(false) {
     }
 
     inline virtual ~LanguageC() = default;
@@ -238,6 +258,39 @@ public:
         _parameterPrecision = p;
     }
 
+    /**
+     * Writes a constant value as it is printed in the generated source
+     * code (NaN and infinity use the macros from math.h).
+     *
+     * @param value the constant value
+     * @param output where the value is written to
+     */
+    template<class Output>
+    void writeParameter(const Base& value, Output& output) {
+        if (value != value) {
+            output << "NAN";
+            return;
+        } else if (std::numeric_limits<Base>::has_infinity && std::abs(value) == std::numeric_limits<Base>::infinity()) {
+            output << (value > Base(0) ? "INFINITY" : "(-INFINITY)");
+            return;
+        }
+
+        // make sure all digits of floating point values are printed
+        std::ostringstream os;
+        os << std::setprecision(_parameterPrecision) << value;
+
+        std::string number = os.str();
+        output << number;
+
+        if (std::abs(value) > Base(0) && value != Base(1) && value != Base(-1)) {
+            if (number.find('.') == std::string::npos && number.find('e') == std::string::npos) {
+                // also make sure there is always a '.' after the number in
+                // order to avoid integer overflows
+                output << '.';
+            }
+        }
+    }
+
     /**
      * Defines the maximum number of assignment per generated function.
      * Zero means it is disabled (no limit).
@@ -255,6 +308,94 @@ public:
         _sources = sources;
     }
 
+    /**
+     * Whether or not the temporary arrays of the generated functions are
+     * placed in a workspace provided by the caller instead of the stack.
+     *
+     * @return true if the temporary arrays are placed in the workspace
+     */
+    inline bool isTemporaryWorkspace() const {
+        return _temporaryWorkspace;
+    }
+
+    /**
+     * Defines whether or not the temporary arrays of the generated functions
+     * are placed in a workspace provided by the caller (the field
+     * workspace of the atomic functions argument) instead of the stack.
+     * The workspace must be aligned to WORKSPACE_ALIGNMENT bytes.
+     *
+     * @param workspace true to place the temporary arrays in the workspace
+     * @param workspaceSize if not null, it is updated with the maximum
+     *                      number of bytes of the workspace required by the
+     *                      generated functions
+     */
+    inline void setTemporaryWorkspace(bool workspace,
+                                      size_t* workspaceSize = nullptr) {
+        _temporaryWorkspace = workspace;
+        _workspaceSize = workspaceSize;
+    }
+
+    /**
+     * Whether or not the local functions (see setMaxAssignmentsPerFunction())
+     * are created by partitioning the operation graph instead of splitting
+     * the assignments after a fixed number of assignments.
+     *
+     * @return true if the operation graph is partitioned
+     */
+    inline bool isFunctionGraphPartitioning() const {
+        return _functionGraphPartitioning;
+    }
+
+    /**
+     * Defines whether or not the local functions (see
+     * setMaxAssignmentsPerFunction()) are created by partitioning the
+     * operation graph instead of splitting the assignments after a fixed
+     * number of assignments.
+     * The number of local functions is the same, however each function has
+     * a similar number of operations (compilation cost) and the operations
+     * are reordered so that fewer temporary variables are shared between
+     * functions.
+     * The partitioning is only applied to operation graphs without loops,
+     * conditional scopes, atomic functions, or array operations.
+     *
+     * @param partition whether or not to partition the operation graph
+     */
+    inline void setFunctionGraphPartitioning(bool partition) {
+        _functionGraphPartitioning = partition;
+    }
+
+    /**
+     * Whether or not restrict pointers and loop vectorization hints are
+     * used in the generated source code.
+     */
+    inline bool isVectorizationHints() const {
+        return _vectorizationHints;
+    }
+
+    /**
+     * Defines whether or not to generate source code which is easier to
+     * vectorize by the compiler:
+     *  - independent and dependent arrays are accessed through restrict
+     *    pointers (input and output arrays must not overlap);
+     *  - temporary arrays in the workspace are declared as aligned
+     *    (GCC and Clang);
+     *  - loops whose iterations are independent are preceded by a
+     *    pragma which allows their vectorization (GCC and Clang).
+     * Only loops without conditions, atomic functions, arrays, and
+     * indexed temporary variables, and which only assign (not add) to
+     * dependent variables are considered independent. The temporary
+     * variables must also be local variables (see
+     * LangCDefaultVariableNameGenerator::setTemporaryArray()), otherwise
+     * the pragmas are only used for loops which copy arrays into
+     * dependent variables.
+     * Other C compilers ignore the GCC/Clang specific hints.
+     *
+     * @param hints whether or not to use vectorization hints
+     */
+    inline void setVectorizationHints(bool hints) {
+        _vectorizationHints = hints;
+    }
+
     /**
      * The maximum number of operations per variable assignment.
      *
@@ -321,27 +462,34 @@ public:
         /**
          * temporary variables
          */
+        size_t wsOffset = 0; // position in the workspace (bytes)
         if (tmpArg[0].array) {
             size_t size = _nameGen->getMaxTemporaryVariableID() + 1 - _nameGen->getMinTemporaryVariableID();
             if (size > 0 || isWrapperFunction) {
-                _ss << _spaces << _baseTypeName << " " << tmpArg[0].name << "[" << size << "];\n";
+                printTemporaryArrayDeclaration(_baseTypeName, tmpArg[0].name, size, sizeof(Base), wsOffset);
             }
         } else if (_temporary.size() > 0) {
+            _ss << _spaces << _baseTypeName << " ";
+
+            bool first = true;
             for (const std::pair<size_t, Node*>& p : _temporary) {
                 Node* var = p.second;
-                if (var->getName() == nullptr) {
+                if (!first) {
+                    _ss << ", ";
+                }
+                first = false;
+
+                if (var->getName() != nullptr) {
+                    _ss << *var->getName();
+                } else if (_compactTemporaryNames) {
+                    _nameBuffer.clear();
+                    _nameGen->appendTemporary(_nameBuffer, *var, getVariableID(*var));
+                    _ss << _nameBuffer;
+                } else {
                     var->setName(_nameGen->generateTemporary(*var, getVariableID(*var)));
+                    _ss << *var->getName();
                 }
             }
-
-            Node* var1 = _temporary.begin()->second;
-            const std::string& varName1 = *var1->getName();
-            _ss << _spaces << _baseTypeName << " " << varName1;
-
-            typename std::map<size_t, Node*>::const_iterator it = _temporary.begin();
-            for (it++; it != _temporary.end(); ++it) {
-                _ss << ", " << *it->second->getName();
-            }
             _ss << ";\n";
         }
 
@@ -350,7 +498,7 @@ public:
          */
         size_t arraySize = _nameGen->getMaxTemporaryArrayVariableID();
         if (arraySize > 0 || isWrapperFunction) {
-            _ss << _spaces << _baseTypeName << " " << tmpArg[1].name << "[" << arraySize << "];\n";
+            printTemporaryArrayDeclaration(_baseTypeName, tmpArg[1].name, arraySize, sizeof(Base), wsOffset);
         }
 
         /**
@@ -358,8 +506,12 @@ public:
          */
         size_t sArraySize = _nameGen->getMaxTemporarySparseArrayVariableID();
         if (sArraySize > 0 || isWrapperFunction) {
-            _ss << _spaces << _baseTypeName << " " << tmpArg[2].name << "[" << sArraySize << "];\n";
-            _ss << _spaces << U_INDEX_TYPE << " " << _C_SPARSE_INDEX_ARRAY << "[" << sArraySize << "];\n";
+            printTemporaryArrayDeclaration(_baseTypeName, tmpArg[2].name, sArraySize, sizeof(Base), wsOffset);
+            printTemporaryArrayDeclaration(U_INDEX_TYPE, _C_SPARSE_INDEX_ARRAY, sArraySize, sizeof(unsigned long), wsOffset);
+        }
+
+        if (_temporaryWorkspace && _workspaceSize != nullptr) {
+            *_workspaceSize = std::max<size_t>(*_workspaceSize, wsOffset);
         }
 
         if (!isWrapperFunction) {
@@ -386,6 +538,46 @@ public:
         return code;
     }
 
+    /**
+     * Declares a temporary array either in the stack or, when the workspace
+     * is used, as a pointer to the next (aligned) region of the workspace.
+     *
+     * @param typeName the type of the array elements
+     * @param name the array name
+     * @param size the number of array elements
+     * @param elementSize the number of bytes of each array element
+     * @param wsOffset the current position in the workspace (bytes) which
+     *                 is updated to the end of the array
+     */
+    inline void printTemporaryArrayDeclaration(const std::string& typeName,
+                                               const std::string& name,
+                                               size_t size,
+                                               size_t elementSize,
+                                               size_t& wsOffset) {
+        if (!_temporaryWorkspace) {
+            _ss << _spaces << typeName << " " << name << "[" << size << "];\n";
+            return;
+        }
+
+        if (_vectorizationHints) {
+            // same compilers as printVectorizationHint()
+            _ss << "#if defined(__clang__) || defined(__GNUC__)\n";
+            _ss << _spaces << typeName << "* restrict " << name << " = (" << typeName << "*) "
+                << "__builtin_assume_aligned((char*) " << _atomicArgName << ".workspace + " << wsOffset << ", "
+                << WORKSPACE_ALIGNMENT << ");\n";
+            _ss << "#else\n";
+            _ss << _spaces << typeName << "* restrict " << name << " = (" << typeName << "*) "
+                << "((char*) " << _atomicArgName << ".workspace + " << wsOffset << ");\n";
+            _ss << "#endif\n";
+        } else {
+            _ss << _spaces << typeName << "* " << name << " = (" << typeName << "*) "
+                << "((char*) " << _atomicArgName << ".workspace + " << wsOffset << ");\n";
+        }
+
+        size_t bytes = size * elementSize;
+        wsOffset += (bytes + WORKSPACE_ALIGNMENT - 1) / WORKSPACE_ALIGNMENT * WORKSPACE_ALIGNMENT;
+    }
+
     inline void generateArrayContainersDeclaration(std::ostringstream& ss,
                                                    const std::vector<int>& atomicMaxForward,
                                                    const std::vector<int>& atomicMaxReverse) {
@@ -421,7 +613,7 @@ public:
 
         _ss << _spaces << "//dependent variables\n";
         for (size_t i = 0; i < depArg.size(); i++) {
-            _ss << _spaces << argumentDeclaration(depArg[i]) << " = " << _outArgName << "[" << i << "];\n";
+            _ss << _spaces << restrictArgumentDeclaration(depArg[i]) << " = " << _outArgName << "[" << i << "];\n";
         }
 
         std::string code = _ss.str();
@@ -436,7 +628,7 @@ public:
 
         _ss << _spaces << "//independent variables\n";
         for (size_t i = 0; i < indArg.size(); i++) {
-            _ss << _spaces << "const " << argumentDeclaration(indArg[i]) << " = " << _inArgName << "[" << i << "];\n";
+            _ss << _spaces << "const " << restrictArgumentDeclaration(indArg[i]) << " = " << _inArgName << "[" << i << "];\n";
         }
 
         std::string code = _ss.str();
@@ -664,7 +856,10 @@ protected:
                             std::unique_ptr<LanguageGenerationData<Base> > info) override {
 
         const bool createFunction = !_functionName.empty();
-        const bool multiFunction = createFunction && _maxAssignmentsPerFunction > 0 && _sources != nullptr;
+        // local functions share the temporary variables through an array
+        const std::vector<FuncArgument>& tmpArgs = info->nameGen.getTemporary();
+        const bool multiFunction = createFunction && _maxAssignmentsPerFunction > 0 && _sources != nullptr &&
+                                   !tmpArgs.empty() && tmpArgs[0].array;
 
         // clean up
         _code.str("");
@@ -676,6 +871,7 @@ protected:
         localFuncArgs_ = "";
         auxArrayName_ = "";
         _currentLoops.clear();
+        _independentLoops.clear();
         _atomicFuncArrays.clear();
         _streamStack.clear();
         _dependentIDs.clear();
@@ -685,6 +881,7 @@ protected:
         _independentSize = _info->independent.size();
         _dependent = &_info->dependent;
         _nameGen = &_info->nameGen;
+        _compactTemporaryNames = _nameGen->isCompactTemporaryNames();
         _minTemporaryVarID = _info->minTemporaryVarID;
         const ArrayView<CG<Base> >& dependent = _info->dependent;
         const std::vector<Node*>& variableOrder = _info->variableOrder;
@@ -694,6 +891,10 @@ protected:
         _tmpSparseArrayValues.resize(_nameGen->getMaxTemporarySparseArrayVariableID());
         std::fill(_tmpSparseArrayValues.begin(), _tmpSparseArrayValues.end(), nullptr);
 
+        if (_vectorizationHints) {
+            findIndependentLoops(variableOrder);
+        }
+
         /**
          * generate index array names (might be used for variable names)
          */
@@ -796,7 +997,11 @@ protected:
                 if (!isDependent(*node) && op != CGOpCode::IndexDeclaration) {
                     // variable names for temporaries must always be created since they might have been used before with a different name/id
                     if (requiresVariableName(*node) && op != CGOpCode::ArrayCreation && op != CGOpCode::SparseArrayCreation) {
-                        node->setName(_nameGen->generateTemporary(*node, getVariableID(*node)));
+                        if (_compactTemporaryNames && isCompactTemporary(*node)) {
+                            node->clearName(); // the name is only created in the source code
+                        } else {
+                            node->setName(_nameGen->generateTemporary(*node, getVariableID(*node)));
+                        }
                     } else if (op == CGOpCode::ArrayCreation) {
                         node->setName(_nameGen->generateTemporaryArray(*node, getVariableID(*node)));
                     } else if (op == CGOpCode::SparseArrayCreation) {
@@ -823,12 +1028,26 @@ protected:
                 }
             }
 
+            const std::vector<size_t>& partitionStarts = _info->partitionStarts;
+            size_t nextPartition = 0;
+
             size_t assignCount = 0;
             for (size_t i = 0; i < variableOrder.size(); ++i) {
                 Node* it = variableOrder[i];
 
                 // check if a new function should start
-                if (assignCount >= _maxAssignmentsPerFunction && multiFunction && _currentLoops.empty()) {
+                if (!partitionStarts.empty()) {
+                    // the operation graph was partitioned
+                    if (nextPartition < partitionStarts.size() && partitionStarts[nextPartition] <= i) {
+                        while (nextPartition < partitionStarts.size() && partitionStarts[nextPartition] <= i)
+                            nextPartition++;
+
+                        if (assignCount > 0 && multiFunction && _currentLoops.empty()) {
+                            assignCount = 0;
+                            saveLocalFunction(localFuncNames, localFuncNames.empty() && _info->zeroDependents);
+                        }
+                    }
+                } else if (assignCount >= _maxAssignmentsPerFunction && multiFunction && _currentLoops.empty()) {
                     assignCount = 0;
                     saveLocalFunction(localFuncNames, localFuncNames.empty() && _info->zeroDependents);
                 }
@@ -1009,7 +1228,7 @@ protected:
     }
 
     inline virtual void pushAssignmentStart(Node& op) {
-        pushAssignmentStart(op, createVariableName(op), isDependent(op));
+        pushAssignmentStart(op, getVariableName(op), isDependent(op));
     }
 
     inline virtual void pushAssignmentStart(Node& node,
@@ -1045,6 +1264,17 @@ protected:
         return dcl + " " + funcArg.name;
     }
 
+    /**
+     * Declares a variable for an independent or dependent argument which
+     * is restrict qualified when vectorization hints are used.
+     */
+    inline std::string restrictArgumentDeclaration(const FuncArgument& funcArg) const {
+        if (_vectorizationHints && funcArg.array) {
+            return _baseTypeName + "* restrict " + funcArg.name;
+        }
+        return argumentDeclaration(funcArg);
+    }
+
     virtual void saveLocalFunction(std::vector<std::string>& localFuncNames,
                                    bool zeroDependentArray) {
         _ss << _functionName << "__" << (localFuncNames.size() + 1);
@@ -1228,10 +1458,54 @@ protected:
         return *var.getName();
     }
 
+    /**
+     * Provides the name of a variable without saving the names of
+     * temporary variables in the operation nodes when compact temporary
+     * names are used (see VariableNameGenerator::isCompactTemporaryNames()).
+     * The returned reference can be invalidated by the next call.
+     *
+     * @param var the variable
+     * @return the variable name
+     */
+    inline const std::string& getVariableName(Node& var) {
+        if (_compactTemporaryNames && var.getName() == nullptr && isCompactTemporary(var)) {
+            _nameBuffer.clear();
+            _nameGen->appendTemporary(_nameBuffer, var, getVariableID(var));
+            return _nameBuffer;
+        }
+        return createVariableName(var);
+    }
+
+    /**
+     * Whether or not the name of a variable is only defined by its ID and
+     * can be created by VariableNameGenerator::appendTemporary()
+     * (it must match the last case in createVariableName()).
+     */
+    inline bool isCompactTemporary(const Node& var) const {
+        CGOpCode op = var.getOperationType();
+        return getVariableID(var) >= _minTemporaryVarID &&
+               op != CGOpCode::ArrayCreation &&
+               op != CGOpCode::SparseArrayCreation &&
+               op != CGOpCode::LoopIndexedDep &&
+               op != CGOpCode::LoopIndexedIndep &&
+               op != CGOpCode::Pri &&
+               op != CGOpCode::LoopIndexedTmp &&
+               op != CGOpCode::Tmp &&
+               op != CGOpCode::TmpDcl; // the name is used directly by pushTmpVar()
+    }
+
     bool requiresVariableDependencies() const override {
         return false;
     }
 
+    size_t getOperationPartitionSize() const override {
+        if (_functionGraphPartitioning && _maxAssignmentsPerFunction > 0 && _sources != nullptr &&
+            !_functionName.empty()) {
+            return _maxAssignmentsPerFunction;
+        }
+        return 0;
+    }
+
     virtual void pushIndependentVariableName(Node& op) {
         CPPADCG_ASSERT_KNOWN(op.getArguments().size() == 0, "Invalid number of arguments for independent variable")
 
@@ -1252,7 +1526,7 @@ protected:
     virtual unsigned pushExpression(Node& op) {
         if (getVariableID(op) > 0) {
             // use variable name
-            _streamStack << createVariableName(op);
+            _streamStack << getVariableName(op);
             return 1;
         } else {
             // print expression code
@@ -1917,6 +2191,10 @@ protected:
             iterationCount = oss.str();
         }
 
+        if (_independentLoops.find(&lnode) != _independentLoops.end()) {
+            printVectorizationHint();
+        }
+
         _streamStack << _spaces << "for("
                      << jj << " = 0; "
                      << jj << " < " << iterationCount << "; "
@@ -1941,6 +2219,10 @@ protected:
     virtual size_t printLoopIndexedDepsUsingLoop(const std::vector<Node*>& variableOrder,
                                                  size_t starti);
 
+    inline void printVectorizationHint();
+
+    virtual void findIndependentLoops(const std::vector<Node*>& variableOrder);
+
     virtual void pushLoopIndexedDep(Node& node);
 
     virtual void pushLoopIndexedIndep(Node& node) {
@@ -2088,24 +2370,6 @@ protected:
         writeParameter(value, _streamStack);
     }
 
-    template<class Output>
-    void writeParameter(const Base& value, Output& output) {
-        // make sure all digits of floating point values are printed
-        std::ostringstream os;
-        os << std::setprecision(_parameterPrecision) << value;
-
-        std::string number = os.str();
-        output << number;
-
-        if (std::abs(value) > Base(0) && value != Base(1) && value != Base(-1)) {
-            if (number.find('.') == std::string::npos && number.find('e') == std::string::npos) {
-                // also make sure there is always a '.' after the number in
-                // order to avoid integer overflows
-                output << '.';
-            }
-        }
-    }
-
     virtual const std::string& getComparison(enum CGOpCode op) const {
         switch (op) {
             case CGOpCode::ComLt:
@@ -2231,6 +2495,9 @@ const std::string LanguageC<Base>::_ATOMIC_PX = "apx"; // NOLINT(cert-err58-cpp)
 template<class Base>
 const std::string LanguageC<Base>::_ATOMIC_PY = "apy"; // NOLINT(cert-err58-cpp)
 
+template<class Base>
+const size_t LanguageC<Base>::WORKSPACE_ALIGNMENT = 64;
+
 template<class Base>
 const std::string LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION = // NOLINT(cert-err58-cpp)
 "typedef struct Array {\n"
@@ -2255,6 +2522,7 @@ const std::string LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION = // NOLINT(cert-
 "                   const Array tx[],\n"
 "                   Array* px,\n"
 "                   const Array py[]);\n"
+"    void* workspace;\n"
 "};";
 
 } // END cg namespace
@@ -287,6 +287,12 @@ inline std::string LanguageC<Base>::linearIndexPattern2String(const LinearIndexP
     long b = lip.getLinearConstantTerm();
     long xOffset = lip.getXOffset();
 
+    if (dx == 1 && xOffset != 0) {
+        // (x - xOffset) * dy + b  is  x * dy + (b - xOffset * dy)
+        b -= xOffset * dy;
+        xOffset = 0;
+    }
+
     std::stringstream ss;
     if (dy != 0) {
         if (xOffset != 0) {
@@ -308,9 +314,12 @@ inline std::string LanguageC<Base>::linearIndexPattern2String(const LinearIndexP
     }
 
     if (b != 0) {
-        if (dy != 0)
-            ss << " + ";
-        ss << b;
+        if (dy == 0)
+            ss << b;
+        else if (b > 0)
+            ss << " + " << b;
+        else
+            ss << " - " << -b;
     }
     return ss.str();
 }
@@ -152,6 +152,9 @@ inline size_t LanguageC<Base>::printLoopIndexedDepsUsingLoop(const std::vector<O
      * print the loop
      */
     size_t depVarCount = i - starti;
+    if (_vectorizationHints) {
+        printVectorizationHint(); // each iteration assigns a different element
+    }
     _streamStack << _indentation << "for(i = 0; i < " << depVarCount << "; i++) ";
     _streamStack << rightAssign.str() << " ";
     if (refAssignOrAdd == 1) {
@@ -172,6 +175,84 @@ inline size_t LanguageC<Base>::printLoopIndexedDepsUsingLoop(const std::vector<O
     return i - 1;
 }
 
+template<class Base>
+inline void LanguageC<Base>::printVectorizationHint() {
+    _streamStack << "#if defined(__clang__)\n"
+                    "#pragma clang loop vectorize(assume_safety)\n"
+                    "#elif defined(__GNUC__)\n"
+                    "#pragma GCC ivdep\n"
+                    "#endif\n";
+}
+
+template<class Base>
+void LanguageC<Base>::findIndependentLoops(const std::vector<OperationNode<Base>*>& variableOrder) {
+    const std::vector<FuncArgument>& tmpArg = _nameGen->getTemporary();
+    bool tmpArray = !tmpArg.empty() && tmpArg[0].array;
+
+    const LoopStartOperationNode<Base>* loop = nullptr;
+    size_t depth = 0;
+    bool independent = false;
+
+    for (OperationNode<Base>* node : variableOrder) {
+        CGOpCode op = node->getOperationType();
+
+        if (op == CGOpCode::LoopStart) {
+            if (depth == 0) {
+                loop = static_cast<const LoopStartOperationNode<Base>*> (node);
+                independent = true;
+            } else {
+                independent = false; // nested loops are not considered
+            }
+            depth++;
+            continue;
+        } else if (op == CGOpCode::LoopEnd) {
+            CPPADCG_ASSERT_UNKNOWN(depth > 0)
+            depth--;
+            if (depth == 0) {
+                if (independent)
+                    _independentLoops.insert(loop);
+                loop = nullptr;
+            }
+            continue;
+        }
+
+        if (loop == nullptr || !independent)
+            continue;
+
+        switch (op) {
+            case CGOpCode::LoopIndexedDep:
+                // different iterations could add to the same element
+                independent = node->getInfo()[1] == 0;
+                break;
+            case CGOpCode::LoopIndexedIndep:
+            case CGOpCode::Index:
+            case CGOpCode::IndexAssign:
+                break;
+            case CGOpCode::LoopIndexedTmp:
+            case CGOpCode::Tmp:
+            case CGOpCode::TmpDcl:
+            case CGOpCode::IndexCondExpr:
+            case CGOpCode::StartIf:
+            case CGOpCode::ElseIf:
+            case CGOpCode::Else:
+            case CGOpCode::EndIf:
+            case CGOpCode::CondResult:
+            case CGOpCode::ArrayCreation:
+            case CGOpCode::SparseArrayCreation:
+            case CGOpCode::ArrayElement:
+            case CGOpCode::AtomicForward:
+            case CGOpCode::AtomicReverse:
+            case CGOpCode::Pri:
+                independent = false;
+                break;
+            default:
+                // a temporary variable in a shared array is reused by all iterations
+                independent = !tmpArray;
+                break;
+        }
+    }
+}
+
 
 } // END cg namespace
 } // END CppAD namespace
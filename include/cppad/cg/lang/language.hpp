@@ -106,6 +106,12 @@ public:
      * executing the operation graph
      */
     const bool zeroDependents;
+    /**
+     * the positions in variableOrder where each part of the operation
+     * graph starts (except the first part) when the operations were
+     * partitioned (see Language::getOperationPartitionSize())
+     */
+    const std::vector<size_t>& partitionStarts;
 public:
 
     LanguageGenerationData(const std::vector<Node *>& ind,
@@ -127,7 +133,8 @@ public:
                            const CodeHandlerVector<Base, size_t>& totalUseCount,
                            const CodeHandlerVector<Base, ScopeIDType>& scope,
                            IndexOperationNode<Base>& auxIterationIndexOp,
-                           bool zero) :
+                           bool zero,
+                           const std::vector<size_t>& partitionStarts) :
         independent(ind),
         dependent(dep),
         minTemporaryVarID(minTempVID),
@@ -147,7 +154,8 @@ public:
         totalUseCount(totalUseCount),
         scope(scope),
         auxIterationIndexOp(auxIterationIndexOp),
-        zeroDependents(zero) {
+        zeroDependents(zero),
+        partitionStarts(partitionStarts) {
     }
 };
 
@@ -186,6 +194,18 @@ protected:
      */
     virtual bool requiresVariableDependencies() const = 0;
 
+    /**
+     * The average number of assignments per part when the operations
+     * should be partitioned into parts which are evaluated consecutively
+     * (e.g. by different functions) before the source code generation.
+     *
+     * @return the average number of assignments per part (zero means that
+     *         operations are not partitioned)
+     */
+    virtual size_t getOperationPartitionSize() const {
+        return 0;
+    }
+
 };
 
 } // END cg namespace
@@ -23,10 +23,19 @@ template<class Base>
 class AtomicExternalFunctionWrapper : public ExternalFunctionWrapper<Base> {
 private:
     atomic_base<Base>* atomic_;
+    /**
+     * Used to call the compiled model of a CGAtomicGenericModel directly
+     * without copying the arrays into CppAD vectors
+     */
+    std::unique_ptr<GenericModelExternalFunctionWrapper<Base> > model_;
 public:
 
     inline AtomicExternalFunctionWrapper(atomic_base<Base>& atomic) :
         atomic_(&atomic) {
+        auto* modelAtomic = dynamic_cast<CGAtomicGenericModel<Base>*> (&atomic);
+        if (modelAtomic != nullptr) {
+            model_.reset(new GenericModelExternalFunctionWrapper<Base>(modelAtomic->getModel()));
+        }
     }
 
     inline virtual ~AtomicExternalFunctionWrapper() = default;
@@ -36,6 +45,10 @@ public:
                  int p,
                  const Array tx[],
                  Array& ty) override {
+        if (model_ != nullptr && model_->isForwardAvailable(p)) {
+            return model_->forward(libModel, q, p, tx, ty);
+        }
+
         size_t m = ty.size;
         size_t n = tx[0].size;
 
@@ -60,6 +73,10 @@ public:
                  const Array tx[],
                  Array& px,
                  const Array py[]) override {
+        if (model_ != nullptr && model_->isReverseAvailable(p)) {
+            return model_->reverse(libModel, p, tx, px, py);
+        }
+
         size_t m = py[0].size;
         size_t n = tx[0].size;
 
@@ -44,6 +44,13 @@ public:
 
     virtual ~CGAtomicGenericModel() = default;
 
+    /**
+     * Provides the compiled model used by this atomic function.
+     */
+    inline GenericModel<Base>& getModel() const {
+        return model_;
+    }
+
     template <class ADVector>
     void operator()(const ADVector& ax, ADVector& ay, size_t id = 0) {
         this->atomic_base<Base>::operator()(ax, ay, id);
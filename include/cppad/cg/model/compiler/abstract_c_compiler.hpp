@@ -135,6 +135,40 @@ public:
         _verbose = verbose;
     }
 
+    /**
+     * Adds the compiler and linker flags required to create an
+     * instrumented library which collects profile data when it is
+     * evaluated (first stage of a profile-guided optimization).
+     * The profile data is saved when the library is unloaded.
+     *
+     * @param profileFolder the folder where the profile data is saved
+     */
+    virtual void addProfileGenerateFlags(const std::string& profileFolder) {
+        throw CGException("Profile-guided optimization is not supported by this compiler");
+    }
+
+    /**
+     * Prepares the profile data collected by an instrumented library so
+     * that it can be used by the compiler (e.g. by merging raw profiles).
+     *
+     * @param profileFolder the folder where the profile data was saved
+     */
+    virtual void mergeProfileData(const std::string& profileFolder,
+                                  JobTimer* timer = nullptr) {
+        // nothing to do by default
+    }
+
+    /**
+     * Adds the compiler flags required to optimize the generated code
+     * using previously collected profile data (last stage of a
+     * profile-guided optimization).
+     *
+     * @param profileFolder the folder where the profile data was saved
+     */
+    virtual void addProfileUseFlags(const std::string& profileFolder) {
+        throw CGException("Profile-guided optimization is not supported by this compiler");
+    }
+
     /**
      * Compiles the provided C source code.
      *
@@ -159,8 +193,6 @@ public:
         if (sources.empty())
             return; // nothing to do
 
-        system::createFolder(this->_tmpFolder);
-
         // determine the maximum file name length
         size_t maxsize = 0;
         std::map<std::string, std::string>::const_iterator it;
@@ -184,9 +216,7 @@ public:
 
         std::ostringstream os;
 
-        if (_saveToDiskFirst) {
-            system::createFolder(_sourcesFolder);
-        }
+        prepareFolders();
 
         // compile each source code file into a different object file
         for (it = sources.begin(); it != sources.end(); ++it) {
@@ -215,20 +245,7 @@ public:
                 std::cout.fill(f); // restore fill character
             }
 
-            if (_saveToDiskFirst) {
-                // save a new source file to disk
-                std::ofstream sourceFile;
-                std::string srcfile = system::createPath(_sourcesFolder, it->first);
-                sourceFile.open(srcfile.c_str());
-                sourceFile << it->second;
-                sourceFile.close();
-
-                // compile the file
-                compileFile(srcfile, file, posIndepCode);
-            } else {
-                 // compile without saving the source code to disk
-                compileSource(it->second, file, posIndepCode);
-            }
+            compileSingle(it->first, it->second, file, posIndepCode);
 
             if (timer != nullptr) {
                 timer->finishedJob();
@@ -243,6 +260,74 @@ public:
 
     }
 
+    /**
+     * Creates the folders required to compile source files.
+     */
+    void prepareFolders() {
+        system::createFolder(this->_tmpFolder);
+
+        if (_saveToDiskFirst) {
+            system::createFolder(_sourcesFolder);
+        }
+    }
+
+    /**
+     * Compiles a single source file into an object file without
+     * registering it in the list of object files of this compiler.
+     * It does not change the state of this object and therefore it can be
+     * called concurrently from several threads as long as the compiler
+     * configuration is not modified (prepareFolders() must be called
+     * first). Each compiler process only inherits its own pipes
+     * (see system::callExecutable()).
+     *
+     * @param name the source file name
+     * @param source the content of the source file
+     * @param output the compiled output file name (the object file path)
+     * @param posIndepCode whether or not to create position-independent
+     *                     code for dynamic linking
+     */
+    void compileSingle(const std::string& name,
+                       const std::string& source,
+                       const std::string& output,
+                       bool posIndepCode) {
+        if (_saveToDiskFirst) {
+            // save a new source file to disk
+            std::ofstream sourceFile;
+            std::string srcfile = system::createPath(_sourcesFolder, name);
+            sourceFile.open(srcfile.c_str());
+            sourceFile << source;
+            sourceFile.close();
+
+            // compile the file
+            compileFile(srcfile, output, posIndepCode);
+        } else {
+            // compile without saving the source code to disk
+            compileSource(source, output, posIndepCode);
+        }
+    }
+
+    /**
+     * Provides the path of the object file created for a source file.
+     *
+     * @param name the source file name
+     */
+    std::string getObjectFilePath(const std::string& name) const {
+        return system::createPath(this->_tmpFolder, name + ".o");
+    }
+
+    /**
+     * Registers an object file compiled with compileSingle() so that it
+     * is included in the library.
+     *
+     * @param name the source file name
+     * @param output the object file path
+     */
+    void addObjectFile(const std::string& name,
+                       const std::string& output) {
+        _sfiles.insert(name);
+        _ofiles.insert(output);
+    }
+
     /**
      * Creates a dynamic library from a set of object files
      *
@@ -29,10 +29,12 @@ class ClangCompiler : public AbstractCCompiler<Base> {
 protected:
     std::set<std::string> _bcfiles; // bitcode files
     std::string _version;
+    std::string _profDataPath; // the path to the llvm-profdata executable
 public:
 
     ClangCompiler(const std::string& clangPath = "/usr/bin/clang") :
-        AbstractCCompiler<Base>(clangPath) {
+        AbstractCCompiler<Base>(clangPath),
+        _profDataPath("/usr/bin/llvm-profdata") {
 
         this->_compileFlags.push_back("-O2"); // Optimization level
         this->_compileLibFlags.push_back("-O2"); // Optimization level
@@ -65,6 +67,57 @@ public:
         return _version;
     }
 
+    /**
+     * @return the path to the llvm-profdata executable used to merge the
+     *         profile data of instrumented libraries
+     */
+    const std::string& getProfDataPath() const {
+        return _profDataPath;
+    }
+
+    /**
+     * Defines the path to the llvm-profdata executable used to merge the
+     * profile data of instrumented libraries.
+     *
+     * @param path the path to the llvm-profdata executable
+     */
+    void setProfDataPath(const std::string& path) {
+        _profDataPath = path;
+    }
+
+    void addProfileGenerateFlags(const std::string& profileFolder) override {
+        std::string flag = "-fprofile-instr-generate=" + system::createPath(profileFolder, "cppadcg.profraw");
+        this->_compileFlags.push_back(flag);
+        this->_compileLibFlags.push_back(flag); // link with the profile runtime
+    }
+
+    void mergeProfileData(const std::string& profileFolder,
+                          JobTimer* timer = nullptr) override {
+        std::string raw = system::createPath(profileFolder, "cppadcg.profraw");
+        if (!system::isFile(raw)) {
+            throw CGException("No profile data found in '", raw, "' (the instrumented library was not evaluated)");
+        }
+
+        if (timer != nullptr) {
+            timer->startingJob("'" + raw + "'", JobTimer::PROFILE_MERGE);
+        } else if (this->_verbose) {
+            std::cout << "merging profile data '" << raw << "'" << std::endl;
+        }
+
+        std::vector<std::string> args {"merge",
+                                       "-output=" + system::createPath(profileFolder, "cppadcg.profdata"),
+                                       raw};
+        system::callExecutable(_profDataPath, args);
+
+        if (timer != nullptr) {
+            timer->finishedJob();
+        }
+    }
+
+    void addProfileUseFlags(const std::string& profileFolder) override {
+        this->_compileFlags.push_back("-fprofile-instr-use=" + system::createPath(profileFolder, "cppadcg.profdata"));
+    }
+
     virtual const std::set<std::string>& getBitCodeFiles() const {
         return _bcfiles;
     }
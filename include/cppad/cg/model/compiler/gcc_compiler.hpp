@@ -40,6 +40,18 @@ public:
     GccCompiler(const GccCompiler& orig) = delete;
     GccCompiler& operator=(const GccCompiler& rhs) = delete;
 
+    void addProfileGenerateFlags(const std::string& profileFolder) override {
+        std::string flag = "-fprofile-generate=" + profileFolder;
+        this->_compileFlags.push_back(flag);
+        this->_compileFlags.push_back("-fprofile-update=prefer-atomic"); // models might use several threads
+        this->_compileLibFlags.push_back(flag); // link with gcov
+    }
+
+    void addProfileUseFlags(const std::string& profileFolder) override {
+        this->_compileFlags.push_back("-fprofile-use=" + profileFolder);
+        this->_compileFlags.push_back("-fprofile-correction"); // inconsistent counters from several threads
+    }
+
     /**
      * Creates a dynamic library from a set of object files
      *
@@ -40,6 +40,21 @@ protected:
      * System dependent custom options
      */
     std::map<std::string, std::string> _options;
+    /**
+     * Whether or not the model source files are compiled as soon as they
+     * are generated (instead of keeping all of them in memory)
+     */
+    bool _streamSources;
+    /**
+     * The number of threads used to compile source files while the
+     * generation of other source files continues (0 to disable)
+     */
+    size_t _compilationThreads;
+    /**
+     * The folder where the profile data of instrumented libraries is saved
+     * (profile-guided optimization)
+     */
+    std::string _profileFolder;
 public:
 
     /**
@@ -53,7 +68,10 @@ public:
     inline explicit DynamicModelLibraryProcessor(ModelLibraryCSourceGen <Base>& modelLibGen,
                                                  std::string libraryName = "cppad_cg_model") :
             ModelLibraryProcessor<Base>(modelLibGen),
-            _libraryName(std::move(libraryName)) {
+            _libraryName(std::move(libraryName)),
+            _streamSources(false),
+            _compilationThreads(0),
+            _profileFolder("cppadcg_profile") {
     }
 
     virtual ~DynamicModelLibraryProcessor() = default;
@@ -114,6 +132,77 @@ public:
         return _options;
     }
 
+    /**
+     * Whether or not the source files of each model are compiled as soon
+     * as they are generated.
+     */
+    inline bool isStreamSources() const {
+        return _streamSources;
+    }
+
+    /**
+     * Defines whether or not the source files of each model are compiled
+     * as soon as they are generated.
+     * The source code of the models is then not kept in memory which
+     * considerably reduces the memory requirements for large models
+     * (see ModelCSourceGen::setSourceSink()).
+     *
+     * @param stream true to compile each source file right after its
+     *               generation
+     */
+    inline void setStreamSources(bool stream) {
+        _streamSources = stream;
+    }
+
+    /**
+     * The number of threads used to compile source files while the
+     * generation of other source files continues.
+     *
+     * @return the number of compilation threads (0 if generation and
+     *         compilation are not performed simultaneously)
+     */
+    inline size_t getCompilationThreads() const {
+        return _compilationThreads;
+    }
+
+    /**
+     * Defines the number of threads used to compile source files while
+     * the generation of other source files continues.
+     * Each source file is provided to a compilation thread as soon as it
+     * is generated, so that the library creation time approaches the
+     * maximum of the generation and compilation times instead of their
+     * sum.
+     * This option is only used with compilers derived from
+     * AbstractCCompiler and implies setStreamSources(true).
+     *
+     * @param threads the number of compilation threads
+     *                (0 to generate all sources before compiling them)
+     */
+    inline void setCompilationThreads(size_t threads) {
+        _compilationThreads = threads;
+    }
+
+    /**
+     * @return the folder where the profile data of instrumented libraries
+     *         is saved
+     */
+    inline const std::string& getProfileFolder() const {
+        return _profileFolder;
+    }
+
+    /**
+     * Defines the folder where the profile data of instrumented libraries
+     * is saved (see createDynamicLibraryPGO()).
+     * The folder is not deleted after the library is created.
+     *
+     * @param profileFolder the path to the profile data folder
+     */
+    inline void setProfileFolder(const std::string& profileFolder) {
+        CPPADCG_ASSERT_KNOWN(!profileFolder.empty(), "Profile folder cannot be empty")
+
+        _profileFolder = profileFolder;
+    }
+
     /**
      * Compiles all models and generates a dynamic library.
      * 
@@ -129,21 +218,8 @@ public:
 
         this->modelLibraryHelper_->startingJob("", JobTimer::DYNAMIC_MODEL_LIBRARY);
 
-        const std::map<std::string, ModelCSourceGen < Base>*>&models = this->modelLibraryHelper_->getModels();
         try {
-            for (const auto& p : models) {
-                const std::map<std::string, std::string>& modelSources = this->getSources(*p.second);
-
-                this->modelLibraryHelper_->startingJob("", JobTimer::COMPILING_FOR_MODEL);
-                compiler.compileSources(modelSources, true, this->modelLibraryHelper_);
-                this->modelLibraryHelper_->finishedJob();
-            }
-
-            const std::map<std::string, std::string>& sources = this->getLibrarySources();
-            compiler.compileSources(sources, true, this->modelLibraryHelper_);
-
-            const std::map<std::string, std::string>& customSource = this->modelLibraryHelper_->getCustomSources();
-            compiler.compileSources(customSource, true, this->modelLibraryHelper_);
+            compileAllSources(compiler, true);
 
             std::string libname = _libraryName;
             if (_customLibExtension != nullptr)
@@ -167,6 +243,87 @@ public:
             return std::unique_ptr<DynamicLib<Base>> (nullptr);
     }
 
+    /**
+     * Compiles all models and generates a dynamic library using
+     * profile-guided optimization.
+     * An instrumented library is created first and provided to the
+     * training function, which should evaluate the models with
+     * representative inputs.
+     * The profile data is saved in the profile folder when the
+     * instrumented library is unloaded (right after the training function
+     * returns, therefore models created from it must be deleted before).
+     * The library is then compiled again using the collected profile data.
+     * Since the model sources are compiled twice, they are kept in memory
+     * (the source streaming and the compilation threads options are not
+     * used).
+     *
+     * @param compiler The compiler used to compile the sources and create
+     *                 the dynamic library
+     * @param training The function which evaluates the models of the
+     *                 instrumented library
+     * @param loadLib Whether or not to load the optimized dynamic library
+     * @return The dynamic library if loadLib is true, nullptr otherwise
+     */
+    std::unique_ptr<DynamicLib<Base>> createDynamicLibraryPGO(AbstractCCompiler<Base>& compiler,
+                                                              const std::function<void(DynamicLib<Base>&)>& training,
+                                                              bool loadLib = true) {
+        // the flags are restored after each stage
+        const std::vector<std::string> compileFlags = compiler.getCompileFlags();
+        const std::vector<std::string> compileLibFlags = compiler.getCompileLibFlags();
+        bool streamSources = _streamSources;
+        size_t compilationThreads = _compilationThreads;
+
+        auto restore = [&]() {
+            compiler.setCompileFlags(compileFlags);
+            compiler.setCompileLibFlags(compileLibFlags);
+            _streamSources = streamSources;
+            _compilationThreads = compilationThreads;
+        };
+
+        _streamSources = false;
+        _compilationThreads = 0;
+
+        try {
+            system::createFolder(_profileFolder);
+
+            /**
+             * instrumented library
+             */
+            compiler.addProfileGenerateFlags(_profileFolder);
+            {
+                std::unique_ptr<DynamicLib<Base>> lib = createDynamicLibrary(compiler, true);
+
+                this->modelLibraryHelper_->startingJob("", JobTimer::PROFILE_TRAINING);
+                try {
+                    training(*lib);
+                } catch (...) {
+                    this->modelLibraryHelper_->finishedJob();
+                    throw;
+                }
+                this->modelLibraryHelper_->finishedJob();
+            } // profile data is saved when the library is unloaded
+            compiler.setCompileFlags(compileFlags);
+            compiler.setCompileLibFlags(compileLibFlags);
+
+            compiler.mergeProfileData(_profileFolder, this->modelLibraryHelper_);
+
+            /**
+             * optimized library
+             */
+            compiler.addProfileUseFlags(_profileFolder);
+            this->modelLibraryHelper_->startingJob("", JobTimer::PROFILE_USE);
+            std::unique_ptr<DynamicLib<Base>> lib = createDynamicLibrary(compiler, loadLib);
+            this->modelLibraryHelper_->finishedJob();
+
+            restore();
+
+            return lib;
+        } catch (...) {
+            restore();
+            throw;
+        }
+    }
+
     /**
      * Compiles all models and generates a static library.
      * 
@@ -186,21 +343,8 @@ public:
 
         this->modelLibraryHelper_->startingJob("", JobTimer::STATIC_MODEL_LIBRARY);
 
-        const std::map<std::string, ModelCSourceGen<Base>*>& models = this->modelLibraryHelper_->getModels();
         try {
-            for (const auto& p : models) {
-                const std::map<std::string, std::string>& modelSources = this->getSources(*p.second);
-
-                this->modelLibraryHelper_->startingJob("", JobTimer::COMPILING_FOR_MODEL);
-                compiler.compileSources(modelSources, posIndepCode, this->modelLibraryHelper_);
-                this->modelLibraryHelper_->finishedJob();
-            }
-
-            const std::map<std::string, std::string>& sources = this->getLibrarySources();
-            compiler.compileSources(sources, posIndepCode, this->modelLibraryHelper_);
-
-            const std::map<std::string, std::string>& customSource = this->modelLibraryHelper_->getCustomSources();
-            compiler.compileSources(customSource, posIndepCode, this->modelLibraryHelper_);
+            compileAllSources(compiler, posIndepCode);
 
             std::string libname = _libraryName;
             if (_customLibExtension != nullptr)
@@ -221,6 +365,96 @@ public:
 
 protected:
 
+    /**
+     * Generates and compiles the source code of all models and of the
+     * library.
+     */
+    virtual void compileAllSources(CCompiler<Base>& compiler,
+                                   bool posIndepCode) {
+        const std::map<std::string, ModelCSourceGen<Base>*>& models = this->modelLibraryHelper_->getModels();
+
+        AbstractCCompiler<Base>* abstractCompiler = nullptr;
+        if (_compilationThreads > 0) {
+            abstractCompiler = dynamic_cast<AbstractCCompiler<Base>*> (&compiler);
+        }
+
+        if (abstractCompiler != nullptr) {
+            /**
+             * pipelined generation and compilation
+             */
+            PipelinedCompilerSourceSink<Base> sink(*abstractCompiler, posIndepCode, _compilationThreads,
+                                                   this->modelLibraryHelper_);
+
+            for (const auto& p : models) {
+                ModelCSourceGen<Base>& model = *p.second;
+                SourceSink* previous = model.getSourceSink();
+                model.setSourceSink(&sink);
+                try {
+                    // sources generated before are still in memory
+                    addSources(sink, this->getSources(model));
+                } catch (...) {
+                    model.setSourceSink(previous);
+                    throw;
+                }
+                model.setSourceSink(previous);
+            }
+
+            addSources(sink, this->getLibrarySources());
+            addSources(sink, this->modelLibraryHelper_->getCustomSources());
+
+            sink.finish();
+
+        } else {
+            for (const auto& p : models) {
+                compileModelSources(*p.second, compiler, posIndepCode);
+            }
+
+            const std::map<std::string, std::string>& sources = this->getLibrarySources();
+            compiler.compileSources(sources, posIndepCode, this->modelLibraryHelper_);
+
+            const std::map<std::string, std::string>& customSource = this->modelLibraryHelper_->getCustomSources();
+            compiler.compileSources(customSource, posIndepCode, this->modelLibraryHelper_);
+        }
+    }
+
+    static inline void addSources(SourceSink& sink,
+                                  const std::map<std::string, std::string>& sources) {
+        for (const auto& it : sources) {
+            std::string source = it.second;
+            sink.addSource(it.first, std::move(source));
+        }
+    }
+
+    /**
+     * Generates and compiles the source code of a model.
+     */
+    virtual void compileModelSources(ModelCSourceGen<Base>& model,
+                                     CCompiler<Base>& compiler,
+                                     bool posIndepCode) {
+        if (_streamSources) {
+            CompilerSourceSink<Base> sink(compiler, posIndepCode, this->modelLibraryHelper_);
+
+            SourceSink* previous = model.getSourceSink();
+            model.setSourceSink(&sink);
+            try {
+                // sources generated before are still in memory
+                const std::map<std::string, std::string>& modelSources = this->getSources(model);
+                compiler.compileSources(modelSources, posIndepCode, this->modelLibraryHelper_);
+            } catch (...) {
+                model.setSourceSink(previous);
+                throw;
+            }
+            model.setSourceSink(previous);
+
+        } else {
+            const std::map<std::string, std::string>& modelSources = this->getSources(model);
+
+            this->modelLibraryHelper_->startingJob("", JobTimer::COMPILING_FOR_MODEL);
+            compiler.compileSources(modelSources, posIndepCode, this->modelLibraryHelper_);
+            this->modelLibraryHelper_->finishedJob();
+        }
+    }
+
     virtual std::unique_ptr<DynamicLib<Base>> loadDynamicLibrary();
 
 };
@@ -45,6 +45,10 @@ protected:
     std::vector<const Base*> _inHess;
     std::vector<Base*> _out;
     LangCAtomicFun _atomicFuncArg;
+    // the number of bytes of the workspace for temporary variables
+    size_t _workspaceSize;
+    // the workspace owned by this model (allocated with additional space for the alignment)
+    std::vector<char> _workspaceBuffer;
     std::vector<std::string> _atomicNames; // names of the atomic/external functions required by this model
     std::vector<ExternalFunctionWrapper<Base>* > _atomic;
     size_t _missingAtomicFunctions;
@@ -89,6 +93,12 @@ protected:
             unsigned long const** row,
             unsigned long const** col,
             unsigned long * nnz);
+    // sparse iteration matrix function in the dynamic library
+    void (*_sparseIterationMatrix)(Base const*const*, Base * const*, LangCAtomicFun);
+    // iteration matrix sparsity function in the dynamic library
+    void (*_iterationMatrixSparsity)(unsigned long const** row,
+            unsigned long const** col,
+            unsigned long * nnz);
     void (*_atomicFunctions)(const char*** names,
             unsigned long * n);
 
@@ -103,7 +113,9 @@ public:
             _in(std::move(other._in)),
             _inHess(std::move(other._inHess)),
             _out(std::move(other._out)),
-            _atomicFuncArg{this, &atomicForward, &atomicReverse},
+            _atomicFuncArg{this, &atomicForward, &atomicReverse, other._atomicFuncArg.workspace},
+            _workspaceSize(other._workspaceSize),
+            _workspaceBuffer(std::move(other._workspaceBuffer)),
             _atomicNames(std::move(other._atomicNames)),
             _atomic(std::move(other._atomic)),
             _missingAtomicFunctions(other._missingAtomicFunctions),
@@ -124,6 +136,8 @@ public:
             _jacobianSparsity(other._jacobianSparsity),
             _hessianSparsity(other._hessianSparsity),
             _hessianSparsity2(other._hessianSparsity2),
+            _sparseIterationMatrix(other._sparseIterationMatrix),
+            _iterationMatrixSparsity(other._iterationMatrixSparsity),
             _atomicFunctions(other._atomicFunctions) {
 
         other._isLibraryReady = false;
@@ -146,6 +160,31 @@ public:
         return _atomicNames;
     }
 
+    size_t getWorkspaceSize() const override {
+        return _workspaceSize;
+    }
+
+    void setWorkspace(void* workspace) override {
+        const size_t align = LanguageC<Base>::WORKSPACE_ALIGNMENT;
+
+        if (workspace != nullptr) {
+            if (reinterpret_cast<std::uintptr_t>(workspace) % align != 0)
+                throw CGException("The workspace is not properly aligned");
+            std::vector<char>().swap(_workspaceBuffer);
+            _atomicFuncArg.workspace = workspace;
+
+        } else if (_workspaceSize == 0) {
+            std::vector<char>().swap(_workspaceBuffer);
+            _atomicFuncArg.workspace = nullptr;
+
+        } else {
+            _workspaceBuffer.resize(_workspaceSize + align - 1);
+            std::uintptr_t p = reinterpret_cast<std::uintptr_t>(_workspaceBuffer.data());
+            p = (p + align - 1) / align * align;
+            _atomicFuncArg.workspace = reinterpret_cast<void*>(p);
+        }
+    }
+
     bool addAtomicFunction(atomic_base<Base>& atomic) override {
         return addExternalFunction<atomic_base<Base>, AtomicExternalFunctionWrapper<Base> >
                 (atomic, atomic.atomic_name());
@@ -756,6 +795,88 @@ public:
         }
     }
 
+    bool isSparseIterationMatrixAvailable() override {
+        return _iterationMatrixSparsity != nullptr && _sparseIterationMatrix != nullptr;
+    }
+
+    void IterationMatrixSparsity(std::vector<size_t>& rows,
+                                 std::vector<size_t>& cols) override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_iterationMatrixSparsity != nullptr, "No iteration matrix sparsity function defined in the dynamic library")
+
+        unsigned long const* drow;
+        unsigned long const* dcol;
+        unsigned long nnz;
+        (*_iterationMatrixSparsity)(&drow, &dcol, &nnz);
+
+        rows.resize(nnz);
+        cols.resize(nnz);
+
+        std::copy(drow, drow + nnz, rows.begin());
+        std::copy(dcol, dcol + nnz, cols.begin());
+    }
+
+    void SparseIterationMatrix(const std::vector<Base>& x,
+                               Base alpha,
+                               std::vector<Base>& mat,
+                               std::vector<size_t>& row,
+                               std::vector<size_t>& col) override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_sparseIterationMatrix != nullptr, "No sparse iteration matrix function defined in the dynamic library")
+        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+                             " please use the variable size methods")
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
+        CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
+
+        unsigned long const* drow;
+        unsigned long const* dcol;
+        unsigned long nnz;
+        (*_iterationMatrixSparsity)(&drow, &dcol, &nnz);
+
+        mat.resize(nnz);
+        row.resize(nnz);
+        col.resize(nnz);
+
+        if (nnz > 0) {
+            _inHess[0] = &x[0];
+            _inHess[1] = &alpha;
+            _out[0] = &mat[0];
+
+            (*_sparseIterationMatrix)(&_inHess[0], &_out[0], _atomicFuncArg);
+            std::copy(drow, drow + nnz, row.begin());
+            std::copy(dcol, dcol + nnz, col.begin());
+        }
+    }
+
+    void SparseIterationMatrix(ArrayView<const Base> x,
+                               Base alpha,
+                               ArrayView<Base> mat,
+                               size_t const** row,
+                               size_t const** col) override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_sparseIterationMatrix != nullptr, "No sparse iteration matrix function defined in the dynamic library")
+        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+                             " please use the variable size methods")
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
+        CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
+
+        unsigned long const* drow;
+        unsigned long const* dcol;
+        unsigned long nnz;
+        (*_iterationMatrixSparsity)(&drow, &dcol, &nnz);
+        CPPADCG_ASSERT_KNOWN(nnz == mat.size(), "Invalid number of non-zero elements in the iteration matrix")
+        *row = drow;
+        *col = dcol;
+
+        if (nnz > 0) {
+            _inHess[0] = x.data();
+            _inHess[1] = &alpha;
+            _out[0] = mat.data();
+
+            (*_sparseIterationMatrix)(&_inHess[0], &_out[0], _atomicFuncArg);
+        }
+    }
+
     bool isSparseHessianAvailable() override {
         return _hessianSparsity != nullptr && _sparseHessian != nullptr;
     }
@@ -896,6 +1017,7 @@ protected:
         _m(0),
         _n(0),
         _atomicFuncArg{nullptr}, // not really required
+        _workspaceSize(0),
         _missingAtomicFunctions(0),
         _zero(nullptr),
         _forwardOne(nullptr),
@@ -914,6 +1036,8 @@ protected:
         _jacobianSparsity(nullptr),
         _hessianSparsity(nullptr),
         _hessianSparsity2(nullptr),
+        _sparseIterationMatrix(nullptr),
+        _iterationMatrixSparsity(nullptr),
         _atomicFunctions(nullptr) {
 
     }
@@ -933,7 +1057,7 @@ protected:
         /**
          * Check the data type
          */
-        void (*infoFunc)(const char** baseName, unsigned long*, unsigned long*, unsigned int*, unsigned int*);
+        void (*infoFunc)(const char** baseName, unsigned long*, unsigned long*, unsigned int*, unsigned int*, unsigned long*);
         infoFunc = reinterpret_cast<decltype(infoFunc)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_INFO));
 
         // local
@@ -944,7 +1068,8 @@ protected:
         const char* dynamicLibBaseName = nullptr;
         unsigned int inSize = 0;
         unsigned int outSize = 0;
-        (*infoFunc)(&dynamicLibBaseName, &_m, &_n, &inSize, &outSize);
+        unsigned long workspaceSize = 0;
+        (*infoFunc)(&dynamicLibBaseName, &_m, &_n, &inSize, &outSize, &workspaceSize);
 
         _in.resize(inSize);
         _inHess.resize(inSize + 1);
@@ -958,6 +1083,9 @@ protected:
         CPPADCG_ASSERT_KNOWN(outSize > 0,
                              "Invalid dimension received from the dynamic library.")
 
+        _workspaceSize = workspaceSize;
+        setWorkspace(nullptr);
+
         _isLibraryReady = true;
     }
 
@@ -979,6 +1107,8 @@ protected:
         _jacobianSparsity = reinterpret_cast<decltype(_jacobianSparsity)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_JACOBIAN_SPARSITY, false));
         _hessianSparsity = reinterpret_cast<decltype(_hessianSparsity)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_HESSIAN_SPARSITY, false));
         _hessianSparsity2 = reinterpret_cast<decltype(_hessianSparsity2)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_HESSIAN_SPARSITY2, false));
+        _sparseIterationMatrix = reinterpret_cast<decltype(_sparseIterationMatrix)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_SPARSE_ITERATION_MATRIX, false));
+        _iterationMatrixSparsity = reinterpret_cast<decltype(_iterationMatrixSparsity)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_ITERATION_MATRIX_SPARSITY, false));
         _atomicFunctions = reinterpret_cast<decltype(_atomicFunctions)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_ATOMIC_FUNC_NAMES, true));
 
         CPPADCG_ASSERT_KNOWN((_sparseForwardOne == nullptr) == (_forwardOneSparsity == nullptr), "Missing functions in the dynamic library")
@@ -989,6 +1119,7 @@ protected:
         CPPADCG_ASSERT_KNOWN((_sparseReverseTwo == nullptr) == (_reverseTwo == nullptr), "Missing functions in the dynamic library")
         CPPADCG_ASSERT_KNOWN((_sparseJacobian == nullptr) || (_jacobianSparsity != nullptr), "Missing functions in the dynamic library")
         CPPADCG_ASSERT_KNOWN((_sparseHessian == nullptr) || (_hessianSparsity != nullptr), "Missing functions in the dynamic library")
+        CPPADCG_ASSERT_KNOWN((_sparseIterationMatrix == nullptr) == (_iterationMatrixSparsity == nullptr), "Missing functions in the dynamic library")
 
         /**
          * Prepare the atomic functions argument
@@ -1069,6 +1200,8 @@ protected:
         _jacobianSparsity = nullptr;
         _hessianSparsity = nullptr;
         _hessianSparsity2 = nullptr;
+        _sparseIterationMatrix = nullptr;
+        _iterationMatrixSparsity = nullptr;
     }
 
 private:
@@ -1091,6 +1224,36 @@ private:
         return false;
     }
 
+    /**
+     * Calls the generated zero order forward mode function without going
+     * through the GenericModel interface and without changing the
+     * internal input/output pointer arrays.
+     * Used when this model is an external function of another compiled
+     * model.
+     *
+     * @return false if the model was compiled with several independent
+     *         variable arrays
+     */
+    inline bool forwardZeroDirect(ArrayView<const Base> x,
+                                  ArrayView<Base> y) {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_zero != nullptr, "No zero order forward function defined in the dynamic library")
+        CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
+
+        if (_in.size() != 1)
+            return false;
+
+        CPPADCG_ASSERT_KNOWN(x.size() >= _n, "Invalid independent array size")
+        CPPADCG_ASSERT_KNOWN(y.size() >= _m, "Invalid dependent array size")
+
+        const Base* in[1] = {x.data()};
+        Base* out[1] = {y.data()};
+
+        (*_zero)(in, out, _atomicFuncArg);
+
+        return true;
+    }
+
     static int atomicForward(void* libModelIn,
                              int atomicIndex,
                              int q,
@@ -1118,6 +1281,7 @@ private:
     friend class LinuxDynamicLib<Base>;
 #endif
     friend class AtomicExternalFunctionWrapper<Base>;
+    friend class GenericModelExternalFunctionWrapper<Base>;
 };
 
 } // END cg namespace
@@ -42,6 +42,9 @@ protected:
     float (*_getThreadPoolGuidedMaxWork)();
     void (*_setThreadPoolNumberOfTimeMeas)(unsigned int n);
     unsigned int (*_getThreadPoolNumberOfTimeMeas)();
+    void (*_setHostExecutor)(void*, HostExecutorSubmit, HostExecutorWait);
+    int (*_getThreadPoolProfile)(int, const char**, int*, unsigned int*, const float**, const int**);
+    void (*_setThreadPoolProfile)(const char*, int, unsigned int, const float*, const int*);
 public:
 
     inline FunctorModelLibrary(FunctorModelLibrary&& other) noexcept:
@@ -59,7 +62,10 @@ public:
             _setThreadPoolGuidedMaxWork(other._setThreadPoolGuidedMaxWork),
             _getThreadPoolGuidedMaxWork(other._getThreadPoolGuidedMaxWork),
             _setThreadPoolNumberOfTimeMeas(other._setThreadPoolNumberOfTimeMeas),
-            _getThreadPoolNumberOfTimeMeas(other._getThreadPoolNumberOfTimeMeas) {
+            _getThreadPoolNumberOfTimeMeas(other._getThreadPoolNumberOfTimeMeas),
+            _setHostExecutor(other._setHostExecutor),
+            _getThreadPoolProfile(other._getThreadPoolProfile),
+            _setThreadPoolProfile(other._setThreadPoolProfile) {
         other._onClose = nullptr;
     }
 
@@ -184,6 +190,75 @@ public:
         return 0;
     }
 
+    bool setHostExecutor(void* executor,
+                         HostExecutorSubmit submit,
+                         HostExecutorWait wait) override {
+        if (_setHostExecutor != nullptr) {
+            (*_setHostExecutor)(executor, submit, wait);
+            return true;
+        }
+        return false;
+    }
+
+    std::string getThreadPoolProfile() const override {
+        std::ostringstream out;
+        if (_getThreadPoolProfile == nullptr)
+            return out.str();
+
+        out << "cppadcg_thpool_profile 1\n";
+        out << std::setprecision(9);
+
+        const char* name;
+        int nJobs;
+        unsigned int nMeas;
+        const float* refElapsed;
+        const int* order;
+        for (int p = 0; (*_getThreadPoolProfile)(p, &name, &nJobs, &nMeas, &refElapsed, &order); ++p) {
+            out << name << " " << nJobs << " " << nMeas;
+            for (int i = 0; i < nJobs; ++i)
+                out << " " << refElapsed[i];
+            for (int i = 0; i < nJobs; ++i)
+                out << " " << order[i];
+            out << "\n";
+        }
+
+        return out.str();
+    }
+
+    void setThreadPoolProfile(const std::string& profile) override {
+        std::istringstream in(profile);
+        std::string line;
+
+        if (!std::getline(in, line) || line != "cppadcg_thpool_profile 1")
+            throw CGException("Invalid or unsupported thread pool profile");
+
+        std::vector<float> refElapsed;
+        std::vector<int> order;
+        for (size_t l = 2; std::getline(in, line); ++l) {
+            if (line.empty())
+                continue;
+
+            std::istringstream ls(line);
+            std::string name;
+            int nJobs;
+            unsigned int nMeas;
+            if (!(ls >> name >> nJobs >> nMeas) || nJobs <= 0)
+                throw CGException("Invalid thread pool profile entry at line ", l);
+
+            refElapsed.resize(nJobs);
+            order.resize(nJobs);
+            for (int i = 0; i < nJobs; ++i)
+                ls >> refElapsed[i];
+            for (int i = 0; i < nJobs; ++i)
+                ls >> order[i];
+            if (ls.fail())
+                throw CGException("Invalid thread pool profile entry at line ", l);
+
+            if (_setThreadPoolProfile != nullptr)
+                (*_setThreadPoolProfile)(name.c_str(), nJobs, nMeas, refElapsed.data(), order.data());
+        }
+    }
+
     inline virtual ~FunctorModelLibrary() = default;
 
 protected:
@@ -201,7 +276,10 @@ protected:
             _setThreadPoolGuidedMaxWork(nullptr),
             _getThreadPoolGuidedMaxWork(nullptr),
             _setThreadPoolNumberOfTimeMeas(nullptr),
-            _getThreadPoolNumberOfTimeMeas(nullptr) {
+            _getThreadPoolNumberOfTimeMeas(nullptr),
+            _setHostExecutor(nullptr),
+            _getThreadPoolProfile(nullptr),
+            _setThreadPoolProfile(nullptr) {
     }
 
     inline void validate() {
@@ -251,10 +329,22 @@ protected:
         _getThreadPoolGuidedMaxWork = reinterpret_cast<decltype(_getThreadPoolGuidedMaxWork)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLGUIDEDMAXGROUPWORK, false));
         _setThreadPoolNumberOfTimeMeas = reinterpret_cast<decltype(_setThreadPoolNumberOfTimeMeas)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_SETTHREADPOOLNUMBEROFTIMEMEAS, false));
         _getThreadPoolNumberOfTimeMeas = reinterpret_cast<decltype(_getThreadPoolNumberOfTimeMeas)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLNUMBEROFTIMEMEAS, false));
+        _setHostExecutor = reinterpret_cast<decltype(_setHostExecutor)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_SETHOSTEXECUTOR, false));
+        _getThreadPoolProfile = reinterpret_cast<decltype(_getThreadPoolProfile)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLPROFILE, false));
+        _setThreadPoolProfile = reinterpret_cast<decltype(_setThreadPoolProfile)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_SETTHREADPOOLPROFILE, false));
 
         if(_setThreads != nullptr) {
             (*_setThreads)(std::thread::hardware_concurrency());
         }
+
+        /**
+         * Job timing profile embedded in the library
+         */
+        const char* (*defaultProfile)();
+        defaultProfile = reinterpret_cast<decltype(defaultProfile)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLDEFAULTPROFILE, false));
+        if (defaultProfile != nullptr) {
+            setThreadPoolProfile((*defaultProfile)());
+        }
     }
 };
 
@@ -171,6 +171,31 @@ public:
      */
     virtual bool addExternalModel(GenericModel<Base>& atomic) = 0;
 
+    /**
+     * Provides the number of bytes of the workspace used by the compiled
+     * code to hold temporary variables
+     * (see ModelCSourceGen::setTemporaryWorkspace()).
+     *
+     * @return the workspace size in bytes (zero if the compiled code does
+     *         not use a workspace)
+     */
+    virtual size_t getWorkspaceSize() const = 0;
+
+    /**
+     * Defines the workspace used by the compiled code to hold temporary
+     * variables.
+     * By default, each model allocates its own workspace which is reused
+     * by all evaluations. A workspace must not be used concurrently by
+     * more than one model evaluation.
+     *
+     * @param workspace a buffer with at least getWorkspaceSize() bytes
+     *                  aligned to LanguageC::WORKSPACE_ALIGNMENT bytes
+     *                  (it must only be deleted after the model) or
+     *                  nullptr to use a workspace owned by the model
+     * @throws CGException if the workspace is not properly aligned
+     */
+    virtual void setWorkspace(void* workspace) = 0;
+
     /**
      * Defines whether or not to evaluate a forward mode of an atomic 
      * functions during a reverse sweep so that CppAD checks validate OK.
@@ -769,6 +794,56 @@ public:
                                 size_t const** row,
                                 size_t const** col) = 0;
 
+    /***********************************************************************
+     *                     Sparse iteration matrix
+     **********************************************************************/
+
+    /**
+     * Determines whether or not the sparse iteration matrix evaluation
+     * methods can be called.
+     *
+     * @see ModelCSourceGen::setCreateSparseIterationMatrix()
+     *
+     * @return true if it is possible to evaluate the sparse iteration matrix
+     */
+    virtual bool isSparseIterationMatrixAvailable() = 0;
+
+    /**
+     * Provides the sparsity pattern of the iteration matrix.
+     *
+     * @param rows The row indices (dependents)
+     * @param cols The column indices (iteration matrix columns)
+     */
+    virtual void IterationMatrixSparsity(std::vector<size_t>& rows,
+                                         std::vector<size_t>& cols) = 0;
+
+    /**
+     * Calculates the sparse iteration matrix, a linear combination of
+     * Jacobian columns:
+     *  \f[ M_{i,k} = \frac{\partial F_i}{\partial x_{c_k}} + \alpha \frac{\partial F_i}{\partial x_{a_k}} \f]
+     *
+     * @param x independent variable vector
+     * @param alpha the coefficient of the second block of columns
+     * @param mat The values of the iteration matrix in the order provided by
+     *            row and col
+     * @param row The row indices of the values
+     * @param col The column indices of the values
+     */
+    virtual void SparseIterationMatrix(const std::vector<Base>& x,
+                                       Base alpha,
+                                       std::vector<Base>& mat,
+                                       std::vector<size_t>& row,
+                                       std::vector<size_t>& col) = 0;
+
+    /**
+     * @copydoc GenericModel::SparseIterationMatrix(const std::vector<Base>&, Base, std::vector<Base>&, std::vector<size_t>&, std::vector<size_t>&)
+     */
+    virtual void SparseIterationMatrix(ArrayView<const Base> x,
+                                       Base alpha,
+                                       ArrayView<Base> mat,
+                                       size_t const** row,
+                                       size_t const** col) = 0;
+
     /***********************************************************************
      *                        Sparse Hessians
      **********************************************************************/
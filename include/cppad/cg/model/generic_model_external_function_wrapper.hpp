@@ -18,19 +18,56 @@
 namespace CppAD {
 namespace cg {
 
+/**
+ * Calls a compiled model from the generated code of another model.
+ * The arrays provided by the generated code are passed to the model as
+ * ArrayViews (no copies are performed).
+ */
 template<class Base>
 class GenericModelExternalFunctionWrapper : public ExternalFunctionWrapper<Base> {
 private:
     GenericModel<Base>* model_;
+    /**
+     * The same model when it was also created by CppADCodeGen
+     * (allows calling the generated functions directly)
+     */
+    FunctorGenericModel<Base>* functor_;
 public:
 
     inline GenericModelExternalFunctionWrapper(GenericModel<Base>& model) :
-        model_(&model) {
+        model_(&model),
+        functor_(dynamic_cast<FunctorGenericModel<Base>*> (&model)) {
     }
 
     inline virtual ~GenericModelExternalFunctionWrapper() {
     }
 
+    /**
+     * Whether or not the model provides the functions required to
+     * determine forward mode results of order p.
+     */
+    inline bool isForwardAvailable(int p) {
+        if (p == 0) {
+            return model_->isForwardZeroAvailable();
+        } else if (p == 1) {
+            return model_->isSparseForwardOneAvailable();
+        }
+        return false;
+    }
+
+    /**
+     * Whether or not the model provides the functions required to
+     * determine reverse mode results of order p.
+     */
+    inline bool isReverseAvailable(int p) {
+        if (p == 0) {
+            return model_->isSparseReverseOneAvailable();
+        } else if (p == 1) {
+            return model_->isSparseReverseTwoAvailable();
+        }
+        return false;
+    }
+
     virtual bool forward(FunctorGenericModel<Base>& libModel,
                          int q,
                          int p,
@@ -44,7 +81,9 @@ public:
 
 
         if (p == 0) {
-            model_->ForwardZero(x, y);
+            if (functor_ == nullptr || !functor_->forwardZeroDirect(x, y)) {
+                model_->ForwardZero(x, y);
+            }
             return true;
 
         } else if (p == 1) {
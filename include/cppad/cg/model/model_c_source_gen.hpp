@@ -58,6 +58,8 @@ public:
     static const std::string FUNCTION_FORWARD_ONE_SPARSITY;
     static const std::string FUNCTION_REVERSE_ONE_SPARSITY;
     static const std::string FUNCTION_REVERSE_TWO_SPARSITY;
+    static const std::string FUNCTION_SPARSE_ITERATION_MATRIX;
+    static const std::string FUNCTION_ITERATION_MATRIX_SPARSITY;
     static const std::string FUNCTION_INFO;
     static const std::string FUNCTION_ATOMIC_FUNC_NAMES;
 protected:
@@ -171,6 +173,11 @@ protected:
      * model library (experimental).
      */
     bool _multiThreading;
+    /**
+     * the maximum number of parallel tasks per level used to evaluate the
+     * zero order model (values lower than 2 disable the task partitioning)
+     */
+    size_t _forwardZeroTasks;
     /// generate source code for the zero order model evaluation
     bool _zero;
     bool _zeroEvaluated;
@@ -204,6 +211,26 @@ protected:
      */
     bool _sparseHessianReusesRev2;
     JacobianADMode _jacMode;
+    /**
+     * the coloring used to compress the directional sweeps of the sparse
+     * Jacobian and the sparse Hessian
+     */
+    SparseColoring _sparseColoring;
+    /**
+     * the method used to determine the Jacobian and Hessian sparsities
+     */
+    SparsityEngine _sparsityEngine;
+    /**
+     * the maximum number of threads used to determine sparsities with
+     * the operation graph engine
+     */
+    size_t _sparsityThreads;
+    /**
+     * operation graph used to determine sparsities (only while generating
+     * sources with SparsityEngine::OperationGraph)
+     */
+    std::unique_ptr<CodeHandler<Base> > _sparsityHandler;
+    std::unique_ptr<GraphSparsity<Base> > _graphSparsity;
     /**
      * Custom Jacobian element indexes
      */
@@ -214,6 +241,23 @@ protected:
      */
     Position _custom_hess;
     LocalSparsityInfo _hessSparsity;
+    /// generate source code for a sparse iteration matrix
+    bool _sparseIterationMatrix;
+    /**
+     * The independent variables combined in each column of the iteration
+     * matrix with a unit coefficient (negative values are ignored)
+     */
+    std::vector<int> _iterMatColumns;
+    /**
+     * The independent variables combined in each column of the iteration
+     * matrix with the alpha coefficient (negative values are ignored)
+     */
+    std::vector<int> _iterMatAlphaColumns;
+    /**
+     * Iteration matrix elements (rows are dependents and columns are
+     * iteration matrix columns)
+     */
+    LocalSparsityInfo _iterMatSparsity;
     /**
      * Hessian sparsity from the model for each equation
      */
@@ -238,6 +282,46 @@ protected:
      * the maximum number of operations per variable assignment
      */
     size_t _maxOperationsPerAssignment;
+    /**
+     * whether or not functions are split by partitioning the operation
+     * graph instead of using a fixed number of assignments per function
+     */
+    bool _functionGraphPartitioning;
+    /**
+     * whether or not to add hints to the generated loops which help the
+     * C compiler to vectorize them
+     */
+    bool _vectorizationHints;
+    /**
+     * whether or not to reorder operations to reduce the live ranges of
+     * temporary variables
+     */
+    bool _scheduleOperations;
+    /**
+     * whether or not temporary variables are declared as local scalars
+     * instead of an array
+     */
+    bool _localTemporaries;
+    /**
+     * whether or not the names of temporary variables are only created
+     * while the source code is written
+     */
+    bool _compactTemporaryNames;
+    /**
+     * whether or not the temporary arrays are placed in a workspace
+     * provided by the caller instead of the stack
+     */
+    bool _temporaryWorkspace;
+    /**
+     * the maximum number of bytes of the workspace required by a single
+     * generated function
+     */
+    size_t _temporaryWorkspaceSize;
+    /**
+     * the maximum number of bytes of the workspace required by the jobs
+     * of multithreaded functions
+     */
+    size_t _jobsWorkspaceSize;
     /**
      *
      */
@@ -280,6 +364,15 @@ protected:
      * Generated source code (maps file names to content)
      */
     std::map<std::string, std::string> _sources;
+    /**
+     * Receives the generated source files as soon as they are created
+     * (the sources are not kept in memory when defined)
+     */
+    SourceSink* _sourceSink;
+    /**
+     * Whether or not the source code has already been generated
+     */
+    bool _sourcesGenerated;
 public:
 
     /**
@@ -297,6 +390,7 @@ public:
         _baseTypeName(ModelCSourceGen<Base>::baseTypeName()),
         _parameterPrecision(std::numeric_limits<Base>::digits10),
         _multiThreading(true),
+        _forwardZeroTasks(0),
         _zero(true),
         _zeroEvaluated(false),
         _jacobian(false),
@@ -310,10 +404,24 @@ public:
         _sparseJacobianReusesOne(true),
         _sparseHessianReusesRev2(true),
         _jacMode(JacobianADMode::Automatic),
+        _sparseColoring(SparseColoring::CppAD),
+        _sparsityEngine(SparsityEngine::CppAD),
+        _sparsityThreads(1),
+        _sparseIterationMatrix(false),
         _atomicsInfo(nullptr),
         _maxAssignPerFunc(20000),
         _maxOperationsPerAssignment(1000),
-        _jobTimer(nullptr) {
+        _functionGraphPartitioning(false),
+        _vectorizationHints(false),
+        _scheduleOperations(false),
+        _localTemporaries(false),
+        _compactTemporaryNames(false),
+        _temporaryWorkspace(false),
+        _temporaryWorkspaceSize(0),
+        _jobsWorkspaceSize(0),
+        _jobTimer(nullptr),
+        _sourceSink(nullptr),
+        _sourcesGenerated(false) {
 
         CPPADCG_ASSERT_KNOWN(!_name.empty(), "Model name cannot be empty")
         CPPADCG_ASSERT_KNOWN((_name[0] >= 'a' && _name[0] <= 'z') ||
@@ -396,6 +504,8 @@ public:
      * detection must be disabled.
      * For the sparse Hessian, the _sparseHessianReusesRev2 and _reverseTwo
      * must be enabled and loop detection must be disabled.
+     * Alternatively, a sparse coloring other than SparseColoring::CppAD can
+     * be used for both (see setSparseColoring()).
      *
      * @return whether or not multithreading can be used for this model
      */
@@ -412,6 +522,8 @@ public:
      * detection must be disabled.
      * For the sparse Hessian, the _sparseHessianReusesRev2 and _reverseTwo
      * must be enabled and loop detection must be disabled.
+     * Alternatively, a sparse coloring other than SparseColoring::CppAD can
+     * be used for both (see setSparseColoring()).
      *
      * @param multiThreading whether or not multithreading can be used for this
      *                       model
@@ -421,11 +533,42 @@ public:
     }
 
     inline bool isJacobianMultiThreadingEnabled() const {
-        return _multiThreading && _loopTapes.empty() && _sparseJacobian && _sparseJacobianReusesOne && (_forwardOne || _reverseOne);
+        return _multiThreading && _loopTapes.empty() && _sparseJacobian &&
+                ((_sparseJacobianReusesOne && (_forwardOne || _reverseOne)) || _sparseColoring != SparseColoring::CppAD);
     }
 
     inline bool isHessianMultiThreadingEnabled() const {
-        return _multiThreading && _loopTapes.empty() && _sparseHessian && _sparseHessianReusesRev2 && _reverseTwo;
+        return _multiThreading && _loopTapes.empty() && _sparseHessian &&
+                ((_sparseHessianReusesRev2 && _reverseTwo) || _sparseColoring != SparseColoring::CppAD);
+    }
+
+    inline bool isForwardZeroMultiThreadingEnabled() const {
+        return _multiThreading && _loopTapes.empty() && _zero && _forwardZeroTasks > 1;
+    }
+
+    /**
+     * Provides the maximum number of parallel tasks per level used to
+     * evaluate the zero order model.
+     */
+    inline size_t getForwardZeroTaskCount() const {
+        return _forwardZeroTasks;
+    }
+
+    /**
+     * Defines the maximum number of parallel tasks per level used to
+     * evaluate the zero order model (see TaskGraph).
+     * The operations of the zero order model are partitioned into levels of
+     * weakly coupled tasks which are executed by the thread pool requested
+     * by the model library; values shared between tasks are exchanged
+     * through a workspace array.
+     * Multithreading must be enabled and models with loops or atomic
+     * functions are always evaluated by a single function.
+     *
+     * @param tasks the maximum number of tasks per level (at most
+     *              TaskGraph::MAX_TASKS; 0 or 1 disable the partitioning)
+     */
+    inline void setForwardZeroTaskCount(size_t tasks) {
+        _forwardZeroTasks = tasks;
     }
 
     /**
@@ -470,6 +613,81 @@ public:
         _jacMode = mode;
     }
 
+    /**
+     * Provides the coloring strategy used to group the directional sweeps
+     * of the sparse Jacobian and the sparse Hessian.
+     *
+     * @return the coloring strategy
+     */
+    inline SparseColoring getSparseColoring() const {
+        return _sparseColoring;
+    }
+
+    /**
+     * Defines the coloring strategy used to group the directional sweeps
+     * of the sparse Jacobian and the sparse Hessian.
+     * With SparseColoring::CppAD (default) the sparse Jacobian and Hessian
+     * are either determined by CppAD in a single function or by reusing the
+     * forward one, reverse one, and reverse two functions (one function per
+     * row/column).
+     * Any other strategy generates one function per color where all
+     * structurally orthogonal rows/columns are evaluated together in a
+     * single directional sweep (compressed seed matrix).
+     * SparseColoring::Star exploits the symmetry of the Hessian and it is
+     * equivalent to SparseColoring::Distance2 for the Jacobian.
+     * This option is ignored for models with loops.
+     *
+     * @param coloring the coloring strategy
+     */
+    inline void setSparseColoring(SparseColoring coloring) {
+        _sparseColoring = coloring;
+    }
+
+    /**
+     * Provides the method used to determine the Jacobian and Hessian
+     * sparsity patterns.
+     *
+     * @return the sparsity engine
+     */
+    inline SparsityEngine getSparsityEngine() const {
+        return _sparsityEngine;
+    }
+
+    /**
+     * Defines the method used to determine the Jacobian and Hessian
+     * sparsity patterns.
+     * SparsityEngine::CppAD (default) uses CppAD sparsity sweeps over the
+     * tape with set based patterns.
+     * SparsityEngine::OperationGraph propagates dependencies directly over
+     * the operation graph of a CodeHandler (see GraphSparsity) which
+     * requires less time and memory for large models. Atomic functions are
+     * considered dense in all of their arguments.
+     *
+     * @param engine the sparsity engine
+     */
+    inline void setSparsityEngine(SparsityEngine engine) {
+        _sparsityEngine = engine;
+    }
+
+    /**
+     * Provides the maximum number of threads used to determine Hessian
+     * sparsities with SparsityEngine::OperationGraph.
+     */
+    inline size_t getSparsityThreadCount() const {
+        return _sparsityThreads;
+    }
+
+    /**
+     * Defines the maximum number of threads used to determine Hessian
+     * sparsities with SparsityEngine::OperationGraph.
+     *
+     * @param threads the number of threads (0 uses the number of hardware
+     *                threads)
+     */
+    inline void setSparsityThreadCount(size_t threads) {
+        _sparsityThreads = threads;
+    }
+
     /**
      * Determines whether or not to generate source-code for a function
      * that evaluates a dense Jacobian.
@@ -851,6 +1069,65 @@ public:
         _custom_hess = Position(elements);
     }
 
+    /**
+     * Determines whether or not source code is generated for a sparse
+     * iteration matrix.
+     *
+     * @see setIterationMatrixColumns()
+     *
+     * @return true if source code for a sparse iteration matrix should be
+     *         created
+     */
+    inline bool isCreateSparseIterationMatrix() const {
+        return _sparseIterationMatrix;
+    }
+
+    /**
+     * Defines whether or not to generate source code for a sparse
+     * iteration matrix, a linear combination of Jacobian columns with a
+     * scalar alpha provided at runtime:
+     *  \f[ M_{i,k} = \frac{\partial F_i}{\partial x_{c_k}} + \alpha \frac{\partial F_i}{\partial x_{a_k}} \f]
+     * where \f$c\f$ and \f$a\f$ are defined with
+     * setIterationMatrixColumns().
+     * This is, for instance, the matrix dF/dy + alpha dF/dy' used by the
+     * Newton iterations of implicit integrators.
+     * The sparsity pattern is the union of the patterns of both Jacobian
+     * column blocks and it is determined during the source generation.
+     *
+     * @param create true if source code for a sparse iteration matrix
+     *               should be created
+     */
+    inline void setCreateSparseIterationMatrix(bool create) {
+        _sparseIterationMatrix = create;
+    }
+
+    /**
+     * Defines the Jacobian columns combined in each column of the iteration
+     * matrix.
+     *
+     * @param columns the independent variable index with a unit coefficient
+     *                for each column of the iteration matrix (a negative
+     *                value means that there is none)
+     * @param alphaColumns the independent variable index with the alpha
+     *                     coefficient for each column of the iteration
+     *                     matrix (a negative value means that there is
+     *                     none)
+     */
+    inline void setIterationMatrixColumns(const std::vector<int>& columns,
+                                          const std::vector<int>& alphaColumns) {
+        CPPADCG_ASSERT_KNOWN(columns.size() == alphaColumns.size(), "The number of columns must be the same for both independent variable blocks")
+        _iterMatColumns = columns;
+        _iterMatAlphaColumns = alphaColumns;
+    }
+
+    inline const std::vector<int>& getIterationMatrixColumns() const {
+        return _iterMatColumns;
+    }
+
+    inline const std::vector<int>& getIterationMatrixAlphaColumns() const {
+        return _iterMatAlphaColumns;
+    }
+
     /**
      * The maximum number of assignment per generated function.
      * Zero means it is disabled (no limit).
@@ -877,6 +1154,58 @@ public:
         _maxAssignPerFunc = maxAssignPerFunc;
     }
 
+    /**
+     * Whether or not large functions are split by partitioning the
+     * operation graph instead of using a fixed number of assignments per
+     * function.
+     *
+     * @return true if the operation graph is partitioned
+     */
+    inline bool isFunctionGraphPartitioning() const {
+        return _functionGraphPartitioning;
+    }
+
+    /**
+     * Defines whether or not large functions are split by partitioning the
+     * operation graph instead of using a fixed number of assignments per
+     * function (see setMaxAssignmentsPerFunc()).
+     * The number of functions is the same but each one has a similar
+     * number of operations, which balances the compilation of the source
+     * files, and fewer temporary variables are shared between functions
+     * (see LanguageC::setFunctionGraphPartitioning()).
+     *
+     * @param partition true to partition the operation graph
+     */
+    inline void setFunctionGraphPartitioning(bool partition) {
+        _functionGraphPartitioning = partition;
+    }
+
+    /**
+     * Whether or not hints which help the C compiler to vectorize the
+     * generated loops are added to the source code.
+     *
+     * @return true if vectorization hints are generated
+     */
+    inline bool isVectorizationHints() const {
+        return _vectorizationHints;
+    }
+
+    /**
+     * Defines whether or not to add hints which help the C compiler to
+     * vectorize the generated loops, such as restrict qualified arrays
+     * and loop pragmas for loops whose iterations are independent
+     * (see LanguageC::setVectorizationHints()).
+     * The generated functions must then never be called with overlapping
+     * input and output arrays.
+     * Loops which compute model equations are only marked when the
+     * temporary variables are local (see setLocalTemporaries()).
+     *
+     * @param hints true to generate vectorization hints
+     */
+    inline void setVectorizationHints(bool hints) {
+        _vectorizationHints = hints;
+    }
+
     /**
      * The maximum number of operations per variable assignment.
      *
@@ -896,6 +1225,143 @@ public:
         _maxOperationsPerAssignment = maxOperationsPerAssignment;
     }
 
+    /**
+     * Whether or not operations are reordered before the source code
+     * generation in order to reduce the live ranges of temporary variables.
+     *
+     * @return true if operations are reordered
+     */
+    inline bool isScheduleOperations() const {
+        return _scheduleOperations;
+    }
+
+    /**
+     * Defines whether or not operations are reordered before the source
+     * code generation in order to reduce the live ranges of temporary
+     * variables (see CodeHandler::setScheduleOperations()).
+     * This reduces the size of the temporary array and improves the
+     * locality of its accesses.
+     *
+     * @param schedule true to reorder operations
+     */
+    inline void setScheduleOperations(bool schedule) {
+        _scheduleOperations = schedule;
+    }
+
+    /**
+     * Whether or not temporary variables are declared as local scalars
+     * instead of being saved in an array.
+     *
+     * @return true if temporary variables are local scalars
+     */
+    inline bool isLocalTemporaries() const {
+        return _localTemporaries;
+    }
+
+    /**
+     * Defines whether or not temporary variables are declared as local
+     * scalars instead of being saved in an array.
+     * Local scalars can be kept in registers by the C compiler, however
+     * the generated functions are no longer split according to
+     * setMaxAssignmentsPerFunc() since local scalars cannot be shared
+     * between functions.
+     *
+     * @param localTemporaries true to declare temporary variables as local
+     *                         scalars
+     */
+    inline void setLocalTemporaries(bool localTemporaries) {
+        _localTemporaries = localTemporaries;
+    }
+
+    /**
+     * Whether or not the names of temporary variables are written directly
+     * into the source code instead of being saved in each operation node.
+     *
+     * @return true if temporary variable names are not saved
+     */
+    inline bool isCompactTemporaryNames() const {
+        return _compactTemporaryNames;
+    }
+
+    /**
+     * Defines whether or not the names of temporary variables are written
+     * directly into the source code instead of being saved in each
+     * operation node (see
+     * LangCDefaultVariableNameGenerator::setCompactTemporaryNames()).
+     * The generated source code is the same but the memory used by models
+     * with many operations is reduced.
+     *
+     * @param compact true to avoid saving temporary variable names
+     */
+    inline void setCompactTemporaryNames(bool compact) {
+        _compactTemporaryNames = compact;
+    }
+
+    /**
+     * Whether or not the temporary arrays of the generated functions are
+     * placed in a workspace provided by the caller instead of the stack.
+     *
+     * @return true if the temporary arrays are placed in the workspace
+     */
+    inline bool isTemporaryWorkspace() const {
+        return _temporaryWorkspace;
+    }
+
+    /**
+     * Defines whether or not the temporary arrays of the generated functions
+     * are placed in a workspace provided by the caller instead of the stack.
+     * Large models can exceed the stack size of threads (e.g. the workers
+     * of the thread pool) when temporary arrays are allocated in the stack.
+     * The required workspace size is reported by the info function of the
+     * model (see GenericModel::getWorkspaceSize()) and the same workspace
+     * is reused by all calls.
+     *
+     * @param workspace true to place temporary arrays in the workspace
+     */
+    inline void setTemporaryWorkspace(bool workspace) {
+        _temporaryWorkspace = workspace;
+    }
+
+    /**
+     * Provides the number of bytes of the workspace required by the
+     * generated functions.
+     * It is only known after the source code generation.
+     *
+     * @return the workspace size in bytes (zero if the workspace is not
+     *         used)
+     */
+    inline size_t getTemporaryWorkspaceSize() const {
+        if (!_temporaryWorkspace)
+            return 0;
+        return std::max<size_t>(_temporaryWorkspaceSize, _jobsWorkspaceSize);
+    }
+
+    /**
+     * Provides the object which receives the source files as soon as they
+     * are generated.
+     *
+     * @return the source sink or nullptr if the source code is kept in
+     *         memory
+     */
+    inline SourceSink* getSourceSink() const {
+        return _sourceSink;
+    }
+
+    /**
+     * Defines an object which receives each source file as soon as it is
+     * generated (e.g. to save it to disk or to compile it).
+     * The source code is then released and not kept in memory, which
+     * considerably reduces the memory requirements for large models.
+     * Source files created while a sink is defined are not returned by
+     * getSources(), which then provides an empty map.
+     *
+     * @param sink the source sink or nullptr to keep the source code in
+     *             memory
+     */
+    inline void setSourceSink(SourceSink* sink) {
+        _sourceSink = sink;
+    }
+
     inline virtual ~ModelCSourceGen() {
         delete _funNoLoops;
         delete _atomicsInfo;
@@ -922,12 +1388,33 @@ protected:
                                                                      const std::string& tmpName = "v",
                                                                      const std::string& tmpArrayName = "array");
 
+    /**
+     * Generates the source code (if it was not generated yet).
+     *
+     * @return the generated source files or an empty map if a source sink
+     *         was defined (see setSourceSink())
+     */
     const std::map<std::string, std::string>& getSources(MultiThreadingType multiThreadingType,
                                                          JobTimer* timer);
 
     virtual void generateSources(MultiThreadingType multiThreadingType,
                                  JobTimer* timer = nullptr);
 
+    /**
+     * Saves a generated source file or provides it to the source sink.
+     *
+     * @param filename the source file name
+     * @param source the source file content
+     */
+    inline void saveSource(const std::string& filename,
+                           std::string&& source);
+
+    /**
+     * Provides the source files saved in memory (e.g. by the language
+     * when the source is split into several functions) to the source sink.
+     */
+    inline void flushSources();
+
     virtual void generateLoops();
 
     virtual void generateInfoSource();
@@ -942,7 +1429,15 @@ protected:
      * zero order (the original model)
      **********************************************************************/
 
-    virtual void generateZeroSource();
+    virtual void generateZeroSource(MultiThreadingType multiThreadingType);
+
+    virtual void generateZeroTaskSources(CodeHandler<Base>& handler,
+                                         const std::vector<CGBase>& dep,
+                                         MultiThreadingType multiThreadingType);
+
+    virtual std::string generateZeroTaskDispatchSource(const TaskGraph<Base>& tasks,
+                                                       const std::vector<CGBase>& dep,
+                                                       MultiThreadingType multiThreadingType);
 
     /**
      * Generates the operation graph for the zero order model with loops
@@ -963,6 +1458,17 @@ protected:
     virtual void generateSparseJacobianForRevSource(bool forward,
                                                     MultiThreadingType multiThreadingType);
 
+    /**
+     * Generates one function for each color of the (partial distance-2)
+     * column/row coloring of the Jacobian and a sparse Jacobian function
+     * which calls them.
+     *
+     * @param forward whether or not to use forward mode (column coloring)
+     * @param multiThreadingType the type of multithreading used
+     */
+    virtual void generateSparseJacobianColoredSource(bool forward,
+                                                     MultiThreadingType multiThreadingType);
+
     virtual std::string generateSparseJacobianForRevSingleThreadSource(const std::string& functionName,
                                                                        std::map<size_t, CompressedVectorInfo> jacInfo,
                                                                        size_t maxCompressedSize,
@@ -977,6 +1483,15 @@ protected:
                                                                       const std::string& revForSuffix,
                                                                       bool forward,
                                                                       MultiThreadingType multiThreadingType);
+    /**
+     * Generates a function for a sparse iteration matrix (a linear
+     * combination of Jacobian columns with a runtime coefficient alpha)
+     * and its sparsity.
+     */
+    virtual void generateSparseIterationMatrixSource();
+
+    virtual void determineIterationMatrixSparsity();
+
     /**
      * Generates a sparse Jacobian using loops.
      *
@@ -1063,6 +1578,15 @@ protected:
 
     virtual void generateSparseHessianSourceFromRev2(MultiThreadingType multiThreadingType);
 
+    /**
+     * Generates one function for each color of the (star or distance-2)
+     * coloring of the Hessian and a sparse Hessian function which calls
+     * them.
+     *
+     * @param multiThreadingType the type of multithreading used
+     */
+    virtual void generateSparseHessianColoredSource(MultiThreadingType multiThreadingType);
+
     virtual std::string generateSparseHessianRev2SingleThreadSource(const std::string& functionName,
                                                                     std::map<size_t, CompressedVectorInfo> hessInfo,
                                                                     size_t maxCompressedSize,
@@ -1233,6 +1757,18 @@ protected:
 
     virtual void determineHessianSparsity();
 
+    /**
+     * Determines the Hessian sparsity patterns (without the element
+     * indexes) using CppAD sparsity sweeps.
+     */
+    virtual void determineHessianSparsityWithCppAD();
+
+    /**
+     * Provides the operation graph based sparsity engine (created on the
+     * first call).
+     */
+    inline GraphSparsity<Base>& getGraphSparsity();
+
     /**
      * Determines groups of rows from a sparsity pattern which do not share
      * the same columns
@@ -1282,7 +1818,15 @@ protected:
     static void printFileStartPThreads(std::ostringstream& cache,
                                        const std::string& baseTypeName);
 
+    /**
+     * Prints the start of a function which runs jobs in the thread pool.
+     *
+     * @param profileName the name used to export/import the timing
+     *                    profile of the jobs (must be unique in a library)
+     * @param size the number of jobs
+     */
     static void printFunctionStartPThreads(std::ostringstream& cache,
+                                           const std::string& profileName,
                                            size_t size);
 
     static void printFunctionEndPThreads(std::ostringstream& cache,
@@ -1299,6 +1843,50 @@ protected:
     static void printLoopEndOpenMP(std::ostringstream& cache,
                                    size_t size);
 
+    /**
+     * Reserves the regions of the workspace used by the jobs of a
+     * multithreaded function when the temporary arrays are placed in the
+     * workspace (jobs which run concurrently cannot share a region).
+     *
+     * @param nJobs the number of jobs
+     * @param offset the number of bytes at the start of the workspace which
+     *               are used by the function which dispatches the jobs
+     *               (a multiple of LanguageC::WORKSPACE_ALIGNMENT)
+     * @return the number of bytes of the region of each job
+     */
+    inline size_t reserveJobsWorkspace(size_t nJobs,
+                                       size_t offset = 0);
+
+    /**
+     * Prints the call to the function of a job inside an OpenMP loop.
+     * Each job receives its own region of the workspace when the temporary
+     * arrays are placed in the workspace.
+     *
+     * @param langC the language used to create the function arguments
+     * @param function the function to call
+     * @param wsOffset the position of the region of the first job
+     *                 in the workspace
+     * @param wsStride the size of the region of each job
+     */
+    inline void printLoopCallOpenMP(std::ostringstream& cache,
+                                    LanguageC<Base>& langC,
+                                    const std::string& function,
+                                    size_t wsOffset,
+                                    size_t wsStride);
+
+    /**
+     * Prints the definition of the workspace region of the i-th job of a
+     * thread pool (only when temporary arrays are placed in the workspace).
+     *
+     * @param wsOffset the position of the region of the first job
+     *                 in the workspace
+     * @param wsStride the size of the region of each job
+     */
+    inline void printJobWorkspacePThreads(std::ostringstream& cache,
+                                          const LanguageC<Base>& langC,
+                                          size_t wsOffset,
+                                          size_t wsStride);
+
     /**
      *
      */
@@ -1307,6 +1895,13 @@ protected:
 
     inline void finishedJob();
 
+    /**
+     * Reports a metric of the current job to the job timer (if there is
+     * one).
+     */
+    inline void reportJobInfo(const std::string& name,
+                              double value);
+
     friend class
     ModelLibraryCSourceGen<Base>;
 
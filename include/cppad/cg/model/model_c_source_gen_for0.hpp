@@ -19,13 +19,14 @@ namespace CppAD {
 namespace cg {
 
 template<class Base>
-void ModelCSourceGen<Base>::generateZeroSource() {
+void ModelCSourceGen<Base>::generateZeroSource(MultiThreadingType multiThreadingType) {
     const std::string jobName = "model (zero-order forward)";
 
     startingJob("'" + jobName + "'", JobTimer::GRAPH);
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setScheduleOperations(_scheduleOperations);
 
     std::vector<CGBase> indVars(_fun.Domain());
     handler.makeVariables(indVars);
@@ -48,16 +49,283 @@ void ModelCSourceGen<Base>::generateZeroSource() {
 
     finishedJob();
 
+    if (isForwardZeroMultiThreadingEnabled() && multiThreadingType != MultiThreadingType::NONE &&
+        handler.getAtomicFunctions().empty()) {
+        /**
+         * parallel tasks (atomic functions are not supported by the evaluator)
+         */
+        generateZeroTaskSources(handler, dep, multiThreadingType);
+        return;
+    }
+
     LanguageC<Base> langC(_baseTypeName);
     langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
     langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
     langC.setParameterPrecision(_parameterPrecision);
+    langC.setTemporaryWorkspace(_temporaryWorkspace, &_temporaryWorkspaceSize);
+    langC.setFunctionGraphPartitioning(_functionGraphPartitioning);
+    langC.setVectorizationHints(_vectorizationHints);
     langC.setGenerateFunction(_name + "_" + FUNCTION_FORWAD_ZERO);
 
     std::ostringstream code;
     std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator());
 
     handler.generateCode(code, langC, dep, *nameGen, _atomicFunctions, jobName);
+    flushSources();
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::generateZeroTaskSources(CodeHandler<Base>& handler,
+                                                    const std::vector<CGBase>& dep,
+                                                    MultiThreadingType multiThreadingType) {
+    const std::string jobName = "model (zero-order forward tasks)";
+    size_t n = _fun.Domain();
+
+    startingJob("'" + jobName + "'", JobTimer::GRAPH);
+
+    TaskGraph<Base> tasks(handler, _forwardZeroTasks);
+    tasks.partition(dep);
+
+    reportJobInfo("levels", tasks.getLevels().size());
+    reportJobInfo("tasks", tasks.getTaskCount());
+    reportJobInfo("workspace", tasks.getWorkspaceSize());
+
+    finishedJob();
+
+    /**
+     * a function for each task
+     */
+    size_t t = 0;
+    for (const auto& level : tasks.getLevels()) {
+        for (const auto& task : level) {
+            CodeHandler<Base> taskHandler;
+            taskHandler.setJobTimer(_jobTimer);
+            taskHandler.setScheduleOperations(_scheduleOperations);
+
+            std::vector<CGBase> x(n);
+            taskHandler.makeVariables(x);
+            std::vector<CGBase> inputs(task.inputs.size());
+            taskHandler.makeVariables(inputs);
+
+            std::vector<size_t> positions(task.inputs.size());
+            for (size_t i = 0; i < positions.size(); i++) {
+                positions[i] = tasks.getWorkspacePosition(*task.inputs[i]);
+            }
+
+            std::vector<CGBase> outputs = tasks.createTaskOperations(task, x, inputs);
+
+            LanguageC<Base> langC(_baseTypeName);
+            langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+            langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
+            langC.setParameterPrecision(_parameterPrecision);
+            langC.setTemporaryWorkspace(_temporaryWorkspace, &_temporaryWorkspaceSize);
+            langC.setFunctionGraphPartitioning(_functionGraphPartitioning);
+            langC.setVectorizationHints(_vectorizationHints);
+            langC.setGenerateFunction(_name + "_" + FUNCTION_FORWAD_ZERO + "_task" + std::to_string(t));
+
+            std::ostringstream code;
+            std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator());
+            LangCWorkspaceVarNameGenerator<Base> nameGenTask(nameGen.get(), n, "w", std::move(positions));
+
+            taskHandler.generateCode(code, langC, outputs, nameGenTask, _atomicFunctions,
+                                     jobName + " task " + std::to_string(t));
+            flushSources();
+            t++;
+        }
+    }
+
+    std::string functionName = _name + "_" + FUNCTION_FORWAD_ZERO;
+    saveSource(functionName + ".c", generateZeroTaskDispatchSource(tasks, dep, multiThreadingType));
+}
+
+template<class Base>
+std::string ModelCSourceGen<Base>::generateZeroTaskDispatchSource(const TaskGraph<Base>& tasks,
+                                                                  const std::vector<CGBase>& dep,
+                                                                  MultiThreadingType multiThreadingType) {
+    CPPADCG_ASSERT_UNKNOWN(multiThreadingType != MultiThreadingType::NONE);
+
+    std::string functionName = _name + "_" + FUNCTION_FORWAD_ZERO;
+
+    LanguageC<Base> langC(_baseTypeName);
+    langC.setParameterPrecision(_parameterPrecision);
+    std::string argsDcl = langC.generateDefaultFunctionArgumentsDcl();
+
+    langC.setArgumentIn("inLocal");
+    langC.setArgumentOut("outLocal");
+    std::string argsLocal = langC.generateDefaultFunctionArguments();
+
+    _cache.str("");
+    _cache << "#include <stdlib.h>\n"
+           "#include <math.h>\n"
+           << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n\n";
+
+    size_t nTasks = tasks.getTaskCount();
+    for (size_t t = 0; t < nTasks; t++) {
+        _cache << "void " << functionName << "_task" << t << "(" << argsDcl << ");\n";
+    }
+
+    _cache << "\n"
+            "typedef void (*cppadcg_function_type) (" << argsDcl << ");\n";
+
+    if (multiThreadingType == MultiThreadingType::OPENMP) {
+        _cache << "\n";
+        printFileStartOpenMP(_cache);
+        _cache << "\n";
+
+    } else {
+        assert(multiThreadingType == MultiThreadingType::PTHREADS || multiThreadingType == MultiThreadingType::HOST_EXECUTOR);
+
+        printFileStartPThreads(_cache, _baseTypeName);
+    }
+
+    /**
+     * zero order forward function
+     */
+    size_t wSize = std::max<size_t>(1, tasks.getWorkspaceSize());
+
+    /**
+     * the task results are kept at the start of the workspace for the
+     * temporary variables followed by the regions used by the tasks
+     */
+    const size_t align = LanguageC<Base>::WORKSPACE_ALIGNMENT;
+    size_t wsOffset = (wSize * sizeof(Base) + align - 1) / align * align;
+    size_t wsStride = 0;
+    for (const auto& level : tasks.getLevels()) {
+        wsStride = reserveJobsWorkspace(level.size(), wsOffset);
+    }
+
+    _cache << "\n"
+            "void " << functionName << "(" << argsDcl << ") {\n";
+    if (_temporaryWorkspace) {
+        _cache << "   " << _baseTypeName << "* w = (" << _baseTypeName << "*) " << langC.getArgumentAtomic() << ".workspace;\n";
+    } else {
+        _cache << "   " << _baseTypeName << "* w = (" << _baseTypeName << "*) malloc(" << wSize << " * sizeof(" << _baseTypeName << "));\n";
+    }
+    _cache << "   " << _baseTypeName << " const * inLocal[2];\n"
+            "   " << _baseTypeName << " * outLocal[1];\n"
+            "   " << _baseTypeName << " * y = out[0];\n"
+            "   long i;\n"
+            "\n";
+    bool checkAllocation = !_temporaryWorkspace; // whether or not malloc is used
+    if (!_temporaryWorkspace) {
+        _cache << "   if(w == NULL)\n"
+                "      goto allocation_failure;\n"
+                "\n";
+    }
+    _cache << "   inLocal[0] = in[0];\n"
+            "   inLocal[1] = w;\n";
+
+    /**
+     * the tasks of a level only depend on the results of previous levels
+     */
+    size_t t0 = 0;
+    size_t l = 0;
+    for (const auto& level : tasks.getLevels()) {
+        size_t size = level.size();
+
+        _cache << "\n"
+                "   {\n";
+
+        if (size == 1) {
+            _cache << "   outLocal[0] = &w[" << level[0].offset << "];\n";
+            if (_temporaryWorkspace) {
+                _cache << "   {\n";
+                langC.setArgumentAtomic("atomicFunLocal");
+                _cache << "   struct LangCAtomicFun atomicFunLocal = atomicFun;\n"
+                        "   atomicFunLocal.workspace = (char*) atomicFun.workspace + " << wsOffset << ";\n"
+                        "   " << functionName << "_task" << t0 << "(" << langC.generateDefaultFunctionArguments() << ");\n"
+                        "   }\n";
+                langC.setArgumentAtomic("atomicFun");
+            } else {
+                _cache << "   " << functionName << "_task" << t0 << "(" << argsLocal << ");\n";
+            }
+        } else {
+            _cache << "   static const cppadcg_function_type p[" << size << "] = {";
+            for (size_t t = 0; t < size; t++) {
+                if (t != 0) _cache << ", ";
+                _cache << functionName << "_task" << (t0 + t);
+            }
+            _cache << "};\n"
+                    "   static const long offset[" << size << "] = {";
+            for (size_t t = 0; t < size; t++) {
+                if (t != 0) _cache << ", ";
+                _cache << level[t].offset;
+            }
+            _cache << "};\n";
+
+            if (multiThreadingType == MultiThreadingType::OPENMP) {
+                printFunctionStartOpenMP(_cache, size);
+                _cache << "\n";
+                printLoopStartOpenMP(_cache, size);
+                _cache << "      outLocal[0] = &w[offset[i]];\n";
+                printLoopCallOpenMP(_cache, langC, "(*p[i])", wsOffset, wsStride);
+                printLoopEndOpenMP(_cache, size);
+
+            } else {
+                printFunctionStartPThreads(_cache, functionName + "_level" + std::to_string(l), size);
+                _cache << "\n"
+                        "   for(i = 0; i < " << size << "; ++i) {\n"
+                        "      args[i] = (ExecArgStruct*) malloc(sizeof(ExecArgStruct));\n"
+                        "      if(args[i] == NULL) {\n"
+                        "         while(i-- > 0)\n"
+                        "            free(args[i]);\n"
+                        "         goto allocation_failure;\n"
+                        "      }\n"
+                        "      args[i]->func = p[i];\n"
+                        "      args[i]->in = inLocal;\n"
+                        "      args[i]->out[0] = &w[offset[i]];\n"
+                        "      args[i]->atomicFun = " << langC.getArgumentAtomic() << ";\n";
+                printJobWorkspacePThreads(_cache, langC, wsOffset, wsStride);
+                _cache << "   }\n"
+                        "\n";
+                printFunctionEndPThreads(_cache, size);
+                checkAllocation = true;
+            }
+        }
+
+        _cache << "   }\n";
+        t0 += size;
+        l++;
+    }
+
+    /**
+     * copy the results
+     */
+    _cache << "\n";
+    for (size_t i = 0; i < dep.size(); i++) {
+        _cache << "   y[" << i << "] = ";
+        const OperationNode<Base>* node = dep[i].getOperationNode();
+        if (node == nullptr) {
+            langC.writeParameter(dep[i].getValue(), _cache);
+            _cache << ";\n";
+        } else if (node->getOperationType() == CGOpCode::Inv) {
+            _cache << "in[0][" << node->getCodeHandler()->getIndependentVariableIndex(*node) << "];\n";
+        } else {
+            _cache << "w[" << tasks.getWorkspacePosition(*node) << "];\n";
+        }
+    }
+
+    _cache << "\n";
+    if (!_temporaryWorkspace) {
+        _cache << "   free(w);\n";
+    }
+
+    if (checkAllocation) {
+        /**
+         * memory allocation failure (the jobs of the level were not queued):
+         * the results are set to NaN instead of writing through a null pointer
+         */
+        _cache << "   return;\n"
+                "\n"
+                "allocation_failure:\n"
+                "   for(i = 0; i < " << dep.size() << "; ++i)\n"
+                "      y[i] = NAN;\n";
+        if (!_temporaryWorkspace) {
+            _cache << "   free(w);\n";
+        }
+    }
+    _cache << "}\n";
+    return _cache.str();
 }
 
 
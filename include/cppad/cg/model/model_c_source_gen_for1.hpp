@@ -84,6 +84,7 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSourcesWithAtomics(const std
 
         CodeHandler<Base> handler;
         handler.setJobTimer(_jobTimer);
+        handler.setScheduleOperations(_scheduleOperations);
 
         vector<CGBase> indVars(n);
         handler.makeVariables(indVars);
@@ -117,6 +118,9 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSourcesWithAtomics(const std
         langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
         langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
         langC.setParameterPrecision(_parameterPrecision);
+        langC.setTemporaryWorkspace(_temporaryWorkspace, &_temporaryWorkspaceSize);
+        langC.setFunctionGraphPartitioning(_functionGraphPartitioning);
+        langC.setVectorizationHints(_vectorizationHints);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_FORWARD_ONE << "_indep" << j;
         langC.setGenerateFunction(_cache.str());
@@ -126,6 +130,7 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSourcesWithAtomics(const std
         LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), "dx", n);
 
         handler.generateCode(code, langC, dyCustom, nameGenHess, _atomicFunctions, subJobName);
+        flushSources();
     }
 }
 
@@ -140,6 +145,7 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSourcesNoAtomics(const std::
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setScheduleOperations(_scheduleOperations);
 
     vector<CGBase> x(n);
     handler.makeVariables(x);
@@ -204,6 +210,9 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSourcesNoAtomics(const std::
         langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
         langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
         langC.setParameterPrecision(_parameterPrecision);
+        langC.setTemporaryWorkspace(_temporaryWorkspace, &_temporaryWorkspaceSize);
+        langC.setFunctionGraphPartitioning(_functionGraphPartitioning);
+        langC.setVectorizationHints(_vectorizationHints);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_FORWARD_ONE << "_indep" << j;
         langC.setGenerateFunction(_cache.str());
@@ -213,6 +222,7 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSourcesNoAtomics(const std::
         LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), "dx", n);
 
         handler.generateCode(code, langC, dyCustom, nameGenHess, _atomicFunctions, subJobName);
+        flushSources();
     }
 }
 
@@ -316,7 +326,7 @@ void ModelCSourceGen<Base>::generateForwardOneSources() {
             "   free(txPos);\n"
             "   return 0;\n"
             "}\n";
-    _sources[model_function + ".c"] = _cache.str();
+    saveSource(model_function + ".c", _cache.str());
     _cache.str("");
 }
 
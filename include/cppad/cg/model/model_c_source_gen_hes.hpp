@@ -28,6 +28,7 @@ void ModelCSourceGen<Base>::generateHessianSource() {
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setScheduleOperations(_scheduleOperations);
 
     size_t m = _fun.Range();
     size_t n = _fun.Domain();
@@ -66,6 +67,9 @@ void ModelCSourceGen<Base>::generateHessianSource() {
     langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
     langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
     langC.setParameterPrecision(_parameterPrecision);
+    langC.setTemporaryWorkspace(_temporaryWorkspace, &_temporaryWorkspaceSize);
+    langC.setFunctionGraphPartitioning(_functionGraphPartitioning);
+    langC.setVectorizationHints(_vectorizationHints);
     langC.setGenerateFunction(_name + "_" + FUNCTION_HESSIAN);
 
     std::ostringstream code;
@@ -73,6 +77,7 @@ void ModelCSourceGen<Base>::generateHessianSource() {
     LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), n);
 
     handler.generateCode(code, langC, hess, nameGenHess, _atomicFunctions, jobName);
+    flushSources();
 }
 
 template<class Base>
@@ -82,7 +87,9 @@ void ModelCSourceGen<Base>::generateSparseHessianSource(MultiThreadingType multi
      */
     determineHessianSparsity();
 
-    if (_sparseHessianReusesRev2 && _reverseTwo) {
+    if (_sparseColoring != SparseColoring::CppAD && _loopTapes.empty() && !_hessSparsity.rows.empty()) {
+        generateSparseHessianColoredSource(multiThreadingType);
+    } else if (_sparseHessianReusesRev2 && _reverseTwo) {
         generateSparseHessianSourceFromRev2(multiThreadingType);
     } else {
         generateSparseHessianSourceDirectly();
@@ -162,6 +169,7 @@ void ModelCSourceGen<Base>::generateSparseHessianSourceDirectly() {
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setScheduleOperations(_scheduleOperations);
 
     // independent variables
     vector<CGBase> indVars(n);
@@ -214,6 +222,9 @@ void ModelCSourceGen<Base>::generateSparseHessianSourceDirectly() {
     langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
     langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
     langC.setParameterPrecision(_parameterPrecision);
+    langC.setTemporaryWorkspace(_temporaryWorkspace, &_temporaryWorkspaceSize);
+    langC.setFunctionGraphPartitioning(_functionGraphPartitioning);
+    langC.setVectorizationHints(_vectorizationHints);
     langC.setGenerateFunction(_name + "_" + FUNCTION_SPARSE_HESSIAN);
 
     std::ostringstream code;
@@ -221,6 +232,7 @@ void ModelCSourceGen<Base>::generateSparseHessianSourceDirectly() {
     LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), n);
 
     handler.generateCode(code, langC, hess, nameGenHess, _atomicFunctions, jobName);
+    flushSources();
 }
 
 template<class Base>
@@ -294,9 +306,210 @@ void ModelCSourceGen<Base>::generateSparseHessianSourceFromRev2(MultiThreadingTy
     string rev2Suffix = "indep";
 
     if (!_multiThreading || multiThreadingType == MultiThreadingType::NONE) {
-        _sources[functionName + ".c"] = generateSparseHessianRev2SingleThreadSource(functionName, hessInfo, maxCompressedSize, functionRev2, rev2Suffix);
+        saveSource(functionName + ".c", generateSparseHessianRev2SingleThreadSource(functionName, hessInfo, maxCompressedSize, functionRev2, rev2Suffix));
     } else {
-        _sources[functionName + ".c"] = generateSparseHessianRev2MultiThreadSource(functionName, hessInfo, maxCompressedSize, functionRev2, rev2Suffix, multiThreadingType);
+        saveSource(functionName + ".c", generateSparseHessianRev2MultiThreadSource(functionName, hessInfo, maxCompressedSize, functionRev2, rev2Suffix, multiThreadingType));
+    }
+    _cache.str("");
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::generateSparseHessianColoredSource(MultiThreadingType multiThreadingType) {
+    using namespace std;
+
+    const size_t m = _fun.Range();
+    const size_t n = _fun.Domain();
+
+    /**
+     * we might have to consider a slightly different order than the one
+     * specified by the user according to the available elements in the sparsity
+     */
+    std::vector<size_t> evalRows, evalCols;
+    determineSecondOrderElements4Eval(evalRows, evalCols);
+
+    /**
+     * Coloring
+     *
+     * A directional sweep with the seed of variable k provides the elements
+     * (k, j) for all j in _hessSparsity.sparsity[k].
+     * Atomic functions might only provide a partial (non-symmetric) sparsity
+     * pattern, so the coloring always uses the symmetric closure of the
+     * pattern (otherwise two variables with the same color could contribute
+     * to the same element).
+     * Star coloring also relies on the symmetry of the Hessian values and
+     * therefore it is only used without atomic functions.
+     */
+    SparsitySetType sparsity = _hessSparsity.sparsity;
+    for (size_t j = 0; j < n; j++) {
+        for (size_t k : _hessSparsity.sparsity[j]) {
+            sparsity[k].insert(j);
+        }
+    }
+
+    std::vector<size_t> color;
+    std::vector<size_t> rowSource(evalRows.size()); // position in the directional sweep output
+    std::vector<size_t> colorSource(evalRows.size());
+
+    if (_sparseColoring == SparseColoring::Star && !isAtomicsUsed()) {
+        colorStar(sparsity, color);
+
+        for (size_t e = 0; e < evalRows.size(); e++) {
+            std::pair<size_t, size_t> src = starColoringSource(sparsity, color, evalRows[e], evalCols[e]);
+            rowSource[e] = src.first;
+            colorSource[e] = src.second;
+        }
+    } else {
+        // the symmetric pattern is its own transpose
+        colorDistanceTwo(sparsity, n, evalCols, evalRows, color);
+
+        for (size_t e = 0; e < evalRows.size(); e++) {
+            rowSource[e] = evalCols[e];
+            colorSource[e] = color[evalRows[e]];
+        }
+    }
+
+    // elements[color][var]{locations}
+    std::map<size_t, std::map<size_t, set<size_t> > > elements;
+    for (size_t e = 0; e < evalRows.size(); e++) {
+        elements[colorSource[e]][rowSource[e]].insert(e);
+    }
+
+    /**
+     * the elements of each color follow the order requested by the user
+     * (if possible) so that the compressed array can be avoided
+     */
+    std::map<size_t, CompressedVectorInfo> hessInfo;
+    for (const auto& itC : elements) {
+        std::vector<std::pair<size_t, size_t> > order; // (first location, index)
+        for (const auto& itJ : itC.second) {
+            order.push_back(std::make_pair(*itJ.second.begin(), itJ.first));
+        }
+        std::sort(order.begin(), order.end());
+
+        CompressedVectorInfo& info = hessInfo[itC.first];
+        for (const auto& o : order) {
+            info.indexes.push_back(o.second);
+            info.locations.push_back(itC.second.at(o.second));
+        }
+    }
+
+    for (auto& it : hessInfo) {
+        const std::vector<size_t>& els = it.second.indexes;
+        const std::vector<set<size_t> >& location = it.second.locations;
+        CPPADCG_ASSERT_UNKNOWN(els.size() == location.size());
+        CPPADCG_ASSERT_UNKNOWN(els.size() > 0);
+
+        bool passed = true;
+        size_t hessRowStart = *location[0].begin();
+        for (size_t e = 0; e < els.size(); e++) {
+            if (location[e].size() > 1) {
+                passed = false; // too many elements
+                break;
+            }
+            if (*location[e].begin() != hessRowStart + e) {
+                passed = false; // wrong order
+                break;
+            }
+        }
+        it.second.ordered = passed;
+    }
+
+    size_t maxCompressedSize = 0;
+    for (const auto& it : hessInfo) {
+        if (it.second.indexes.size() > maxCompressedSize && !it.second.ordered)
+            maxCompressedSize = it.second.indexes.size();
+    }
+
+    string functionName = _name + "_" + FUNCTION_SPARSE_HESSIAN;
+    string colorSuffix = "color";
+
+    /**
+     * Generate one function for each color
+     */
+    const std::string jobName = "model (sparse Hessian colors)";
+    startingJob("'" + jobName + "'", JobTimer::SOURCE_GENERATION);
+
+    for (const auto& it : hessInfo) {
+        size_t c = it.first;
+        const std::vector<size_t>& els = it.second.indexes;
+
+        _cache.str("");
+        _cache << "model (sparse Hessian, color " << c << ")";
+        const std::string subJobName = _cache.str();
+
+        startingJob("'" + subJobName + "'", JobTimer::GRAPH);
+
+        CodeHandler<Base> handler;
+        handler.setJobTimer(_jobTimer);
+        handler.setScheduleOperations(_scheduleOperations);
+
+        vector<CGBase> tx0(n);
+        handler.makeVariables(tx0);
+        if (_x.size() > 0) {
+            for (size_t j = 0; j < n; j++) {
+                tx0[j].setValue(_x[j]);
+            }
+        }
+
+        // not used (only kept so that the arguments are the same as in the reverse two functions)
+        CGBase tx1;
+        handler.makeVariable(tx1);
+        if (_x.size() > 0) {
+            tx1.setValue(Base(1.0));
+        }
+
+        vector<CGBase> py(m);
+        handler.makeVariables(py);
+        if (_x.size() > 0) {
+            for (size_t i = 0; i < m; i++) {
+                py[i].setValue(Base(1.0));
+            }
+        }
+
+        _fun.Forward(0, tx0);
+
+        vector<CGBase> tx1v(n);
+        for (size_t j = 0; j < n; j++) {
+            tx1v[j] = Base(color[j] == c ? 1 : 0);
+        }
+        _fun.Forward(1, tx1v);
+
+        vector<CGBase> px = _fun.Reverse(2, py);
+        CPPADCG_ASSERT_UNKNOWN(px.size() == 2 * n);
+
+        vector<CGBase> compressed(els.size());
+        for (size_t e = 0; e < els.size(); e++) {
+            compressed[e] = px[els[e] * 2 + 1];
+        }
+
+        finishedJob();
+
+        LanguageC<Base> langC(_baseTypeName);
+        langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+        langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
+        langC.setParameterPrecision(_parameterPrecision);
+        langC.setTemporaryWorkspace(_temporaryWorkspace, &_temporaryWorkspaceSize);
+        langC.setFunctionGraphPartitioning(_functionGraphPartitioning);
+        langC.setVectorizationHints(_vectorizationHints);
+        langC.setGenerateFunction(functionName + "_" + colorSuffix + std::to_string(c));
+
+        std::ostringstream code;
+        std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("hess"));
+        LangCDefaultReverse2VarNameGenerator<Base> nameGenRev2(nameGen.get(), n, 1);
+
+        handler.generateCode(code, langC, compressed, nameGenRev2, _atomicFunctions, subJobName);
+        flushSources();
+    }
+
+    finishedJob();
+
+    /**
+     * the sparse Hessian
+     */
+    if (!_multiThreading || multiThreadingType == MultiThreadingType::NONE) {
+        saveSource(functionName + ".c", generateSparseHessianRev2SingleThreadSource(functionName, hessInfo, maxCompressedSize, functionName, colorSuffix));
+    } else {
+        saveSource(functionName + ".c", generateSparseHessianRev2MultiThreadSource(functionName, hessInfo, maxCompressedSize, functionName, colorSuffix, multiThreadingType));
     }
     _cache.str("");
 }
@@ -445,7 +658,7 @@ std::string ModelCSourceGen<Base>::generateSparseHessianRev2MultiThreadSource(co
         /**
          * PThreads pool needs a function with a void pointer argument
          */
-        assert(multiThreadingType == MultiThreadingType::PTHREADS);
+        assert(multiThreadingType == MultiThreadingType::PTHREADS || multiThreadingType == MultiThreadingType::HOST_EXECUTOR);
 
         printFileStartPThreads(_cache, _baseTypeName);
     }
@@ -483,27 +696,30 @@ std::string ModelCSourceGen<Base>::generateSparseHessianRev2MultiThreadSource(co
             "   long i;\n"
             "\n";
 
+    size_t wsStride = reserveJobsWorkspace(hessInfo.size());
+
     if(multiThreadingType == MultiThreadingType::OPENMP) {
         printFunctionStartOpenMP(_cache, hessInfo.size());
         _cache << "\n";
         printLoopStartOpenMP(_cache, hessInfo.size());
-        _cache << "      outLocal[0] = &hess[offset[i]];\n"
-                "      (*p[i])(" << argsLocal << ");\n";
+        _cache << "      outLocal[0] = &hess[offset[i]];\n";
+        printLoopCallOpenMP(_cache, langC, "(*p[i])", 0, wsStride);
         printLoopEndOpenMP(_cache, hessInfo.size());
         _cache << "\n";
 
     } else {
-        assert(multiThreadingType == MultiThreadingType::PTHREADS);
+        assert(multiThreadingType == MultiThreadingType::PTHREADS || multiThreadingType == MultiThreadingType::HOST_EXECUTOR);
 
-        printFunctionStartPThreads(_cache, hessInfo.size());
+        printFunctionStartPThreads(_cache, functionName, hessInfo.size());
         _cache << "\n"
                 "   for(i = 0; i < " << hessInfo.size() << "; ++i) {\n"
                 "      args[i] = (ExecArgStruct*) malloc(sizeof(ExecArgStruct));\n"
                 "      args[i]->func = p[i];\n"
                 "      args[i]->in = inLocal;\n"
                 "      args[i]->out[0] = &hess[offset[i]];\n"
-                "      args[i]->atomicFun = " << langC .getArgumentAtomic() << ";\n"
-                "   }\n"
+                "      args[i]->atomicFun = " << langC .getArgumentAtomic() << ";\n";
+        printJobWorkspacePThreads(_cache, langC, 0, wsStride);
+        _cache << "   }\n"
                 "\n";
         printFunctionEndPThreads(_cache, hessInfo.size());
     }
@@ -541,11 +757,7 @@ void ModelCSourceGen<Base>::determineSecondOrderElements4Eval(std::vector<size_t
 }
 
 template<class Base>
-void ModelCSourceGen<Base>::determineHessianSparsity() {
-    if (_hessSparsity.sparsity.size() > 0) {
-        return;
-    }
-
+void ModelCSourceGen<Base>::determineHessianSparsityWithCppAD() {
     size_t m = _fun.Range();
     size_t n = _fun.Domain();
 
@@ -626,7 +838,39 @@ void ModelCSourceGen<Base>::determineHessianSparsity() {
             }
 
         }
+    }
+}
 
+template<class Base>
+void ModelCSourceGen<Base>::determineHessianSparsity() {
+    if (_hessSparsity.sparsity.size() > 0) {
+        return;
+    }
+
+    startingJob("'Hessian'", JobTimer::SPARSITY);
+
+    size_t m = _fun.Range();
+
+    if (_sparsityEngine == SparsityEngine::OperationGraph) {
+        GraphSparsity<Base>& graph = getGraphSparsity();
+
+        // sparsity for the sum of the hessians of all equations
+        _hessSparsity.sparsity = graph.hessianSparsity();
+
+        if (_hessianByEquation || _reverseTwo) {
+            // sparsity for the hessian of each equations
+            std::vector<SparsitySetType> sparsities = graph.hessianSparsities();
+
+            _hessSparsities.resize(m);
+            for (size_t i = 0; i < m; i++) {
+                _hessSparsities[i].sparsity = std::move(sparsities[i]);
+            }
+        }
+    } else {
+        determineHessianSparsityWithCppAD();
+    }
+
+    if (_hessianByEquation || _reverseTwo) {
         for (size_t i = 0; i < m; i++) {
             LocalSparsityInfo& hessSparsitiesi = _hessSparsities[i];
 
@@ -657,6 +901,10 @@ void ModelCSourceGen<Base>::determineHessianSparsity() {
         _hessSparsity.rows = _custom_hess.row;
         _hessSparsity.cols = _custom_hess.col;
     }
+
+    reportJobInfo("non-zeros", _hessSparsity.rows.size());
+
+    finishedJob();
 }
 
 template<class Base>
@@ -664,12 +912,12 @@ void ModelCSourceGen<Base>::generateHessianSparsitySource() {
     determineHessianSparsity();
 
     generateSparsity2DSource(_name + "_" + FUNCTION_HESSIAN_SPARSITY, _hessSparsity);
-    _sources[_name + "_" + FUNCTION_HESSIAN_SPARSITY + ".c"] = _cache.str();
+    saveSource(_name + "_" + FUNCTION_HESSIAN_SPARSITY + ".c", _cache.str());
     _cache.str("");
 
     if (_hessianByEquation || _reverseTwo) {
         generateSparsity2DSource2(_name + "_" + FUNCTION_HESSIAN_SPARSITY2, _hessSparsities);
-        _sources[_name + "_" + FUNCTION_HESSIAN_SPARSITY2 + ".c"] = _cache.str();
+        saveSource(_name + "_" + FUNCTION_HESSIAN_SPARSITY2 + ".c", _cache.str());
         _cache.str("");
     }
 }
@@ -71,6 +71,12 @@ const std::string ModelCSourceGen<Base>::FUNCTION_REVERSE_ONE_SPARSITY = "revers
 template<class Base>
 const std::string ModelCSourceGen<Base>::FUNCTION_REVERSE_TWO_SPARSITY = "sparse_reverse_two_sparsity";
 
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_SPARSE_ITERATION_MATRIX = "sparse_iteration_matrix";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_ITERATION_MATRIX_SPARSITY = "iteration_matrix_sparsity";
+
 template<class Base>
 const std::string ModelCSourceGen<Base>::FUNCTION_INFO = "info";
 
@@ -85,18 +91,44 @@ VariableNameGenerator<Base>* ModelCSourceGen<Base>::createVariableNameGenerator(
                                                                                 const std::string& indepName,
                                                                                 const std::string& tmpName,
                                                                                 const std::string& tmpArrayName) {
-    return new LangCDefaultVariableNameGenerator<Base> (depName, indepName, tmpName, tmpArrayName);
+    auto* nameGen = new LangCDefaultVariableNameGenerator<Base> (depName, indepName, tmpName, tmpArrayName);
+    nameGen->setTemporaryArray(!_localTemporaries);
+    nameGen->setCompactTemporaryNames(_compactTemporaryNames);
+    return nameGen;
 }
 
 template<class Base>
 const std::map<std::string, std::string>& ModelCSourceGen<Base>::getSources(MultiThreadingType multiThreadingType,
                                                                             JobTimer* timer) {
-    if (_sources.empty()) {
+    if (!_sourcesGenerated) {
         generateSources(multiThreadingType, timer);
+        _sourcesGenerated = true;
     }
     return _sources;
 }
 
+template<class Base>
+inline void ModelCSourceGen<Base>::saveSource(const std::string& filename,
+                                              std::string&& source) {
+    if (_sourceSink == nullptr) {
+        _sources[filename] = std::move(source);
+    } else {
+        flushSources();
+        _sourceSink->addSource(filename, std::move(source));
+    }
+}
+
+template<class Base>
+inline void ModelCSourceGen<Base>::flushSources() {
+    if (_sourceSink == nullptr)
+        return;
+
+    for (auto& it : _sources) {
+        _sourceSink->addSource(it.first, std::move(it.second));
+    }
+    _sources.clear();
+}
+
 template<class Base>
 void ModelCSourceGen<Base>::generateSources(MultiThreadingType multiThreadingType,
                                             JobTimer* timer) {
@@ -107,7 +139,7 @@ void ModelCSourceGen<Base>::generateSources(MultiThreadingType multiThreadingTyp
     startingJob("'" + _name + "'", JobTimer::SOURCE_FOR_MODEL);
 
     if (_zero) {
-        generateZeroSource();
+        generateZeroSource(multiThreadingType);
         _zeroEvaluated = true;
     }
 
@@ -142,6 +174,10 @@ void ModelCSourceGen<Base>::generateSources(MultiThreadingType multiThreadingTyp
         generateSparseHessianSource(multiThreadingType);
     }
 
+    if (_sparseIterationMatrix) {
+        generateSparseIterationMatrixSource();
+    }
+
     if (_sparseJacobian || _forwardOne || _reverseOne) {
         generateJacobianSparsitySource();
     }
@@ -154,9 +190,36 @@ void ModelCSourceGen<Base>::generateSources(MultiThreadingType multiThreadingTyp
 
     generateAtomicFuncNames();
 
+    flushSources();
+
+    // release the memory used by the operation graph
+    _graphSparsity.reset();
+    _sparsityHandler.reset();
+
     finishedJob();
 }
 
+template<class Base>
+inline GraphSparsity<Base>& ModelCSourceGen<Base>::getGraphSparsity() {
+    if (_graphSparsity == nullptr) {
+        startingJob("'sparsity graph'", JobTimer::GRAPH);
+
+        _sparsityHandler.reset(new CodeHandler<Base>());
+
+        std::vector<CGBase> x(_fun.Domain());
+        _sparsityHandler->makeVariables(x);
+
+        std::vector<CGBase> y = _fun.Forward(0, x);
+
+        _graphSparsity.reset(new GraphSparsity<Base>(*_sparsityHandler, x, y));
+        _graphSparsity->setThreadCount(_sparsityThreads);
+
+        finishedJob();
+    }
+
+    return *_graphSparsity;
+}
+
 template<class Base>
 void ModelCSourceGen<Base>::generateLoops() {
     if (_relatedDepCandidates.empty()) {
@@ -167,6 +230,7 @@ void ModelCSourceGen<Base>::generateLoops() {
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setScheduleOperations(_scheduleOperations);
 
     std::vector<CGBase> xx(_fun.Domain());
     handler.makeVariables(xx);
@@ -181,6 +245,10 @@ void ModelCSourceGen<Base>::generateLoops() {
     DependentPatternMatcher<Base> matcher(_relatedDepCandidates, yy, xx);
     matcher.generateTapes(_funNoLoops, _loopTapes);
 
+    reportJobInfo("nodes", handler.getManagedNodesCount());
+    reportJobInfo("equation patterns", matcher.getEquationPatterns().size());
+    reportJobInfo("loops", matcher.getLoops().size());
+
     finishedJob();
     if (_jobTimer != nullptr && _jobTimer->isVerbose()) {
         std::cout << " equation patterns: " << matcher.getEquationPatterns().size() <<
@@ -201,16 +269,18 @@ void ModelCSourceGen<Base>::generateInfoSource() {
                                                                          "unsigned long* m",
                                                                          "unsigned long* n",
                                                                          "unsigned int* indCount",
-                                                                         "unsigned int* depCount"});
+                                                                         "unsigned int* depCount",
+                                                                         "unsigned long* workspaceSize"});
     _cache << " {\n"
             "   *baseName = \"" << _baseTypeName << "  " << localBaseName << "\";\n"
             "   *m = " << _fun.Range() << ";\n"
             "   *n = " << _fun.Domain() << ";\n"
             "   *depCount = " << nameGen->getDependent().size() << "; // number of dependent array variables\n"
             "   *indCount = " << nameGen->getIndependent().size() << "; // number of independent array variables\n"
+            "   *workspaceSize = " << getTemporaryWorkspaceSize() << "; // bytes of the workspace for temporary variables\n"
             "}\n\n";
 
-    _sources[funcName + ".c"] = _cache.str();
+    saveSource(funcName + ".c", _cache.str());
 }
 
 template<class Base>
@@ -231,7 +301,7 @@ void ModelCSourceGen<Base>::generateAtomicFuncNames() {
             "   *n = " << n << ";\n"
             "}\n\n";
 
-    _sources[funcName + ".c"] = _cache.str();
+    saveSource(funcName + ".c", _cache.str());
 }
 
 template<class Base>
@@ -345,14 +415,14 @@ void ModelCSourceGen<Base>::generateGlobalDirectionalFunctionSource(const std::s
             "   };\n";
 
     _cache << "}\n";
-    _sources[model_function + ".c"] = _cache.str();
+    saveSource(model_function + ".c", _cache.str());
     _cache.str("");
 
     /**
      * Sparsity
      */
     generateSparsity1DSource2(_name + "_" + function_sparsity, elements);
-    _sources[_name + "_" + function_sparsity + ".c"] = _cache.str();
+    saveSource(_name + "_" + function_sparsity + ".c", _cache.str());
     _cache.str("");
 }
 
@@ -663,6 +733,7 @@ void ModelCSourceGen<Base>::printFileStartPThreads(std::ostringstream& cache,
 
 template<class Base>
 void ModelCSourceGen<Base>::printFunctionStartPThreads(std::ostringstream& cache,
+                                                       const std::string& profileName,
                                                        size_t size) {
     auto repeatFill = [&](const std::string& txt){
         cache << "{";
@@ -692,17 +763,21 @@ void ModelCSourceGen<Base>::printFunctionStartPThreads(std::ostringstream& cache
             "   static int job2Thread[" << size << "] = ";
     repeatFill("-1");
     cache << "\n"
-            "   static int last_elapsed_changed = 1;\n"
+            "   static cppadcg_thpool_profile profile = {\"" << profileName << "\", " << size << ", ref_elapsed, order, 0, 1, 0, NULL};\n"
             "   unsigned int nBench = cppadcg_thpool_get_n_time_meas();\n"
-            "   static unsigned int n_meas = 0;\n"
-            "   int do_benchmark = " << (size > 0 ? "(n_meas < nBench && !cppadcg_thpool_is_disabled())" : "0") << ";\n"
-            "   float* elapsed_p = do_benchmark ? elapsed : NULL;\n";
+            "   int do_benchmark;\n"
+            "   float* elapsed_p;\n"
+            "\n"
+            "   if(!profile.registered)\n"
+            "      cppadcg_thpool_register_profile(&profile);\n"
+            "   do_benchmark = " << (size > 0 ? "(profile.n_meas < nBench && !cppadcg_thpool_is_disabled())" : "0") << ";\n"
+            "   elapsed_p = do_benchmark ? elapsed : NULL;\n";
 }
 
 template<class Base>
 void ModelCSourceGen<Base>::printFunctionEndPThreads(std::ostringstream& cache,
                                                      size_t size) {
-    cache << "   cppadcg_thpool_add_jobs(execute_functions, (void**) args, ref_elapsed, elapsed_p, order, job2Thread, " << size << ", last_elapsed_changed" << ");\n"
+    cache << "   cppadcg_thpool_add_jobs(execute_functions, (void**) args, ref_elapsed, elapsed_p, order, job2Thread, " << size << ", profile.last_elapsed_changed" << ");\n"
             "\n"
             "   cppadcg_thpool_wait();\n"
             "\n"
@@ -711,13 +786,62 @@ void ModelCSourceGen<Base>::printFunctionEndPThreads(std::ostringstream& cache,
             "   }\n"
             "\n"
             "   if(do_benchmark) {\n"
-            "      cppadcg_thpool_update_order(ref_elapsed, n_meas, elapsed, order, " << size << ");\n"
-            "      n_meas++;\n"
+            "      cppadcg_thpool_update_order(ref_elapsed, profile.n_meas, elapsed, order, " << size << ");\n"
+            "      profile.n_meas++;\n"
             "   } else {\n"
-            "      last_elapsed_changed = 0;\n"
+            "      profile.last_elapsed_changed = 0;\n"
             "   }\n";
 }
 
+template<class Base>
+size_t ModelCSourceGen<Base>::reserveJobsWorkspace(size_t nJobs,
+                                                   size_t offset) {
+    if (!_temporaryWorkspace)
+        return 0;
+
+    const size_t align = LanguageC<Base>::WORKSPACE_ALIGNMENT;
+    // the largest function generated so far (includes the job functions)
+    size_t stride = (_temporaryWorkspaceSize + align - 1) / align * align;
+    CPPADCG_ASSERT_UNKNOWN(offset % align == 0);
+
+    _jobsWorkspaceSize = std::max<size_t>(_jobsWorkspaceSize, offset + nJobs * stride);
+
+    return stride;
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::printLoopCallOpenMP(std::ostringstream& cache,
+                                                LanguageC<Base>& langC,
+                                                const std::string& function,
+                                                size_t wsOffset,
+                                                size_t wsStride) {
+    if (!_temporaryWorkspace) {
+        cache << "      " << function << "(" << langC.generateDefaultFunctionArguments() << ");\n";
+        return;
+    }
+
+    std::string atomicArg = langC.getArgumentAtomic();
+    langC.setArgumentAtomic(atomicArg + "Local");
+    cache << "      {\n"
+            "         struct LangCAtomicFun " << langC.getArgumentAtomic() << " = " << atomicArg << ";\n"
+            "         " << langC.getArgumentAtomic() << ".workspace = (char*) " << atomicArg << ".workspace + " << wsOffset << " + i * " << wsStride << ";\n"
+            "         " << function << "(" << langC.generateDefaultFunctionArguments() << ");\n"
+            "      }\n";
+    langC.setArgumentAtomic(atomicArg);
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::printJobWorkspacePThreads(std::ostringstream& cache,
+                                                      const LanguageC<Base>& langC,
+                                                      size_t wsOffset,
+                                                      size_t wsStride) {
+    if (!_temporaryWorkspace)
+        return;
+
+    const std::string& atomicArg = langC.getArgumentAtomic();
+    cache << "      args[i]->atomicFun.workspace = (char*) " << atomicArg << ".workspace + " << wsOffset << " + i * " << wsStride << ";\n";
+}
+
 template<class Base>
 void ModelCSourceGen<Base>::printFileStartOpenMP(std::ostringstream& cache) {
     cache << CPPADCG_OPENMP_H_FILE << "\n"
@@ -815,6 +939,13 @@ inline void ModelCSourceGen<Base>::finishedJob() {
         _jobTimer->finishedJob();
 }
 
+template<class Base>
+inline void ModelCSourceGen<Base>::reportJobInfo(const std::string& name,
+                                                 double value) {
+    if (_jobTimer != nullptr)
+        _jobTimer->reportJobInfo(name, value);
+}
+
 /**
  *
  * Specializations
@@ -28,6 +28,7 @@ void ModelCSourceGen<Base>::generateJacobianSource() {
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setScheduleOperations(_scheduleOperations);
 
     vector<CGBase> indVars(_fun.Domain());
     handler.makeVariables(indVars);
@@ -55,12 +56,16 @@ void ModelCSourceGen<Base>::generateJacobianSource() {
     langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
     langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
     langC.setParameterPrecision(_parameterPrecision);
+    langC.setTemporaryWorkspace(_temporaryWorkspace, &_temporaryWorkspaceSize);
+    langC.setFunctionGraphPartitioning(_functionGraphPartitioning);
+    langC.setVectorizationHints(_vectorizationHints);
     langC.setGenerateFunction(_name + "_" + FUNCTION_JACOBIAN);
 
     std::ostringstream code;
     std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("jac"));
 
     handler.generateCode(code, langC, jac, *nameGen, _atomicFunctions, jobName);
+    flushSources();
 }
 
 template<class Base>
@@ -88,7 +93,9 @@ void ModelCSourceGen<Base>::generateSparseJacobianSource(MultiThreadingType mult
     /**
      * call the appropriate method for source code generation
      */
-    if (_sparseJacobianReusesOne && _forwardOne && forwardMode) {
+    if (_sparseColoring != SparseColoring::CppAD && _loopTapes.empty() && !_jacSparsity.rows.empty()) {
+        generateSparseJacobianColoredSource(forwardMode, multiThreadingType);
+    } else if (_sparseJacobianReusesOne && _forwardOne && forwardMode) {
         generateSparseJacobianForRevSource(true, multiThreadingType);
     } else if (_sparseJacobianReusesOne && _reverseOne && !forwardMode) {
         generateSparseJacobianForRevSource(false, multiThreadingType);
@@ -110,6 +117,7 @@ void ModelCSourceGen<Base>::generateSparseJacobianSource(bool forward) {
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setScheduleOperations(_scheduleOperations);
 
     vector<CGBase> indVars(n);
     handler.makeVariables(indVars);
@@ -139,12 +147,16 @@ void ModelCSourceGen<Base>::generateSparseJacobianSource(bool forward) {
     langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
     langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
     langC.setParameterPrecision(_parameterPrecision);
+    langC.setTemporaryWorkspace(_temporaryWorkspace, &_temporaryWorkspaceSize);
+    langC.setFunctionGraphPartitioning(_functionGraphPartitioning);
+    langC.setVectorizationHints(_vectorizationHints);
     langC.setGenerateFunction(_name + "_" + FUNCTION_SPARSE_JACOBIAN);
 
     std::ostringstream code;
     std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("jac"));
 
     handler.generateCode(code, langC, jac, *nameGen, _atomicFunctions, jobName);
+    flushSources();
 }
 
 template<class Base>
@@ -241,9 +253,174 @@ void ModelCSourceGen<Base>::generateSparseJacobianForRevSource(bool forward,
     string functionName(_cache.str());
 
     if(!_multiThreading || multiThreadingType == MultiThreadingType::NONE) {
-        _sources[functionName + ".c"] = generateSparseJacobianForRevSingleThreadSource(functionName, jacInfo, maxCompressedSize, functionRevFor, revForSuffix, forward);
+        saveSource(functionName + ".c", generateSparseJacobianForRevSingleThreadSource(functionName, jacInfo, maxCompressedSize, functionRevFor, revForSuffix, forward));
     } else {
-        _sources[functionName + ".c"] = generateSparseJacobianForRevMultiThreadSource(functionName, jacInfo, maxCompressedSize, functionRevFor, revForSuffix, forward, multiThreadingType);
+        saveSource(functionName + ".c", generateSparseJacobianForRevMultiThreadSource(functionName, jacInfo, maxCompressedSize, functionRevFor, revForSuffix, forward, multiThreadingType));
+    }
+
+    _cache.str("");
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::generateSparseJacobianColoredSource(bool forward,
+                                                                MultiThreadingType multiThreadingType) {
+    using namespace std;
+
+    size_t m = _fun.Range();
+    size_t n = _fun.Domain();
+
+    const std::vector<size_t>& rows = _jacSparsity.rows;
+    const std::vector<size_t>& cols = _jacSparsity.cols;
+
+    /**
+     * Coloring (columns in forward mode and rows in reverse mode)
+     */
+    std::vector<size_t> color;
+    if (forward) {
+        colorDistanceTwo(_jacSparsity.sparsity, n, rows, cols, color);
+    } else {
+        SparsitySetType sparsityT = transposePattern(_jacSparsity.sparsity, m, n);
+        colorDistanceTwo(sparsityT, m, cols, rows, color);
+    }
+
+    // elements[color][equation or variable]{locations}
+    std::map<size_t, std::map<size_t, set<size_t> > > elements;
+    for (size_t e = 0; e < rows.size(); e++) {
+        if (forward) {
+            elements[color[cols[e]]][rows[e]].insert(e);
+        } else {
+            elements[color[rows[e]]][cols[e]].insert(e);
+        }
+    }
+
+    /**
+     * the elements of each color follow the order requested by the user
+     * (if possible) so that the compressed array can be avoided
+     */
+    std::map<size_t, CompressedVectorInfo> jacInfo;
+    for (const auto& itC : elements) {
+        std::vector<std::pair<size_t, size_t> > order; // (first location, index)
+        for (const auto& itI : itC.second) {
+            order.push_back(std::make_pair(*itI.second.begin(), itI.first));
+        }
+        std::sort(order.begin(), order.end());
+
+        CompressedVectorInfo& info = jacInfo[itC.first];
+        for (const auto& o : order) {
+            info.indexes.push_back(o.second);
+            info.locations.push_back(itC.second.at(o.second));
+        }
+    }
+
+    for (auto& it : jacInfo) {
+        const std::vector<size_t>& els = it.second.indexes;
+        const std::vector<set<size_t> >& location = it.second.locations;
+        CPPADCG_ASSERT_UNKNOWN(els.size() == location.size());
+        CPPADCG_ASSERT_UNKNOWN(els.size() > 0);
+
+        bool passed = true;
+        size_t jacArrayStart = *location[0].begin();
+        for (size_t e = 0; e < els.size(); e++) {
+            if (location[e].size() > 1) {
+                passed = false; // too many elements
+                break;
+            }
+            if (*location[e].begin() != jacArrayStart + e) {
+                passed = false; // wrong order
+                break;
+            }
+        }
+        it.second.ordered = passed;
+    }
+
+    size_t maxCompressedSize = 0;
+    for (const auto& it : jacInfo) {
+        if (it.second.indexes.size() > maxCompressedSize && !it.second.ordered)
+            maxCompressedSize = it.second.indexes.size();
+    }
+
+    string functionName = _name + "_" + FUNCTION_SPARSE_JACOBIAN;
+    string colorSuffix = "color";
+
+    /**
+     * Generate one function for each color
+     */
+    const std::string jobName = "model (sparse Jacobian colors)";
+    startingJob("'" + jobName + "'", JobTimer::SOURCE_GENERATION);
+
+    for (const auto& it : jacInfo) {
+        size_t c = it.first;
+        const std::vector<size_t>& els = it.second.indexes;
+
+        _cache.str("");
+        _cache << "model (sparse Jacobian, color " << c << ")";
+        const std::string subJobName = _cache.str();
+
+        startingJob("'" + subJobName + "'", JobTimer::GRAPH);
+
+        CodeHandler<Base> handler;
+        handler.setJobTimer(_jobTimer);
+        handler.setScheduleOperations(_scheduleOperations);
+
+        vector<CGBase> x(n);
+        handler.makeVariables(x);
+        if (_x.size() > 0) {
+            for (size_t j = 0; j < n; j++) {
+                x[j].setValue(_x[j]);
+            }
+        }
+
+        _fun.Forward(0, x);
+
+        vector<CGBase> dir;
+        if (forward) {
+            vector<CGBase> dx(n);
+            for (size_t j = 0; j < n; j++) {
+                dx[j] = Base(color[j] == c ? 1 : 0);
+            }
+            dir = _fun.Forward(1, dx);
+            CPPADCG_ASSERT_UNKNOWN(dir.size() == m);
+        } else {
+            vector<CGBase> w(m);
+            for (size_t i = 0; i < m; i++) {
+                w[i] = Base(color[i] == c ? 1 : 0);
+            }
+            dir = _fun.Reverse(1, w);
+            CPPADCG_ASSERT_UNKNOWN(dir.size() == n);
+        }
+
+        vector<CGBase> compressed(els.size());
+        for (size_t e = 0; e < els.size(); e++) {
+            compressed[e] = dir[els[e]];
+        }
+
+        finishedJob();
+
+        LanguageC<Base> langC(_baseTypeName);
+        langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+        langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
+        langC.setParameterPrecision(_parameterPrecision);
+        langC.setTemporaryWorkspace(_temporaryWorkspace, &_temporaryWorkspaceSize);
+        langC.setFunctionGraphPartitioning(_functionGraphPartitioning);
+        langC.setVectorizationHints(_vectorizationHints);
+        langC.setGenerateFunction(functionName + "_" + colorSuffix + std::to_string(c));
+
+        std::ostringstream code;
+        std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("jac"));
+
+        handler.generateCode(code, langC, compressed, *nameGen, _atomicFunctions, subJobName);
+        flushSources();
+    }
+
+    finishedJob();
+
+    /**
+     * the sparse Jacobian
+     */
+    if (!_multiThreading || multiThreadingType == MultiThreadingType::NONE) {
+        saveSource(functionName + ".c", generateSparseJacobianForRevSingleThreadSource(functionName, jacInfo, maxCompressedSize, functionName, colorSuffix, forward));
+    } else {
+        saveSource(functionName + ".c", generateSparseJacobianForRevMultiThreadSource(functionName, jacInfo, maxCompressedSize, functionName, colorSuffix, forward, multiThreadingType));
     }
 
     _cache.str("");
@@ -388,7 +565,7 @@ std::string ModelCSourceGen<Base>::generateSparseJacobianForRevMultiThreadSource
         _cache << "\n";
 
     } else {
-        assert(multiThreadingType == MultiThreadingType::PTHREADS);
+        assert(multiThreadingType == MultiThreadingType::PTHREADS || multiThreadingType == MultiThreadingType::HOST_EXECUTOR);
 
         printFileStartPThreads(_cache, _baseTypeName);
     }
@@ -426,27 +603,30 @@ std::string ModelCSourceGen<Base>::generateSparseJacobianForRevMultiThreadSource
             "   long i;\n"
             "\n";
 
+    size_t wsStride = reserveJobsWorkspace(jacInfo.size());
+
     if(multiThreadingType == MultiThreadingType::OPENMP) {
         printFunctionStartOpenMP(_cache, jacInfo.size());
         _cache << "\n";
         printLoopStartOpenMP(_cache, jacInfo.size());
-        _cache << "      outLocal[0] = &jac[offset[i]];\n"
-                "      (*p[i])(" << argsLocal << ");\n";
+        _cache << "      outLocal[0] = &jac[offset[i]];\n";
+        printLoopCallOpenMP(_cache, langC, "(*p[i])", 0, wsStride);
         printLoopEndOpenMP(_cache, jacInfo.size());
         _cache << "\n";
 
     } else {
-        assert(multiThreadingType == MultiThreadingType::PTHREADS);
+        assert(multiThreadingType == MultiThreadingType::PTHREADS || multiThreadingType == MultiThreadingType::HOST_EXECUTOR);
 
-        printFunctionStartPThreads(_cache, jacInfo.size());
+        printFunctionStartPThreads(_cache, functionName, jacInfo.size());
         _cache << "\n"
                 "   for(i = 0; i < " << jacInfo.size() << "; ++i) {\n"
                 "      args[i] = (ExecArgStruct*) malloc(sizeof(ExecArgStruct));\n"
                 "      args[i]->func = p[i];\n"
                 "      args[i]->in = inLocal;\n"
                 "      args[i]->out[0] = &jac[offset[i]];\n"
-                "      args[i]->atomicFun = " << langC.getArgumentAtomic() << ";\n"
-                "   }\n"
+                "      args[i]->atomicFun = " << langC.getArgumentAtomic() << ";\n";
+        printJobWorkspacePThreads(_cache, langC, 0, wsStride);
+        _cache << "   }\n"
                 "\n";
         printFunctionEndPThreads(_cache, jacInfo.size());
     }
@@ -457,16 +637,182 @@ std::string ModelCSourceGen<Base>::generateSparseJacobianForRevMultiThreadSource
     return _cache.str();
 }
 
+template<class Base>
+void ModelCSourceGen<Base>::generateSparseIterationMatrixSource() {
+    using std::vector;
+
+    const std::string jobName = "sparse iteration matrix";
+
+    size_t n = _fun.Domain();
+
+    /**
+     * Determine the sparsity pattern
+     */
+    determineIterationMatrixSparsity();
+
+    const std::vector<size_t>& rows = _iterMatSparsity.rows;
+    const std::vector<size_t>& cols = _iterMatSparsity.cols;
+
+    /**
+     * the Jacobian elements required by the iteration matrix
+     */
+    vector<size_t> jacRows, jacCols;
+    std::map<size_t, std::map<size_t, size_t> > jacElements; // [row][col] -> position
+    auto jacPosition = [&](size_t i, int j) -> long {
+        if (j < 0 || _jacSparsity.sparsity[i].find(j) == _jacSparsity.sparsity[i].end())
+            return -1; // a structural zero
+        std::map<size_t, size_t>& rowElements = jacElements[i];
+        auto it = rowElements.find(j);
+        if (it != rowElements.end())
+            return it->second;
+        size_t pos = jacRows.size();
+        rowElements[j] = pos;
+        jacRows.push_back(i);
+        jacCols.push_back(j);
+        return pos;
+    };
+
+    vector<long> posUnit(rows.size());
+    vector<long> posAlpha(rows.size());
+    for (size_t e = 0; e < rows.size(); e++) {
+        posUnit[e] = jacPosition(rows[e], _iterMatColumns[cols[e]]);
+        posAlpha[e] = jacPosition(rows[e], _iterMatAlphaColumns[cols[e]]);
+    }
+
+    bool forwardMode;
+    if (_jacMode == JacobianADMode::Automatic) {
+        forwardMode = estimateBestJacobianADMode(jacRows, jacCols);
+    } else {
+        forwardMode = _jacMode == JacobianADMode::Forward;
+    }
+
+    startingJob("'" + jobName + "'", JobTimer::GRAPH);
+
+    CodeHandler<Base> handler;
+    handler.setJobTimer(_jobTimer);
+    handler.setScheduleOperations(_scheduleOperations);
+
+    vector<CGBase> indVars(n);
+    handler.makeVariables(indVars);
+    if (_x.size() > 0) {
+        for (size_t i = 0; i < n; i++) {
+            indVars[i].setValue(_x[i]);
+        }
+    }
+
+    // the coefficient provided at runtime
+    vector<CGBase> alpha(1);
+    handler.makeVariables(alpha);
+    if (_x.size() > 0) {
+        alpha[0].setValue(Base(1.0));
+    }
+
+    vector<CGBase> jac(jacRows.size());
+    if (!jacRows.empty()) {
+        CppAD::sparse_jacobian_work work;
+        if (forwardMode) {
+            _fun.SparseJacobianForward(indVars, _jacSparsity.sparsity, jacRows, jacCols, jac, work);
+        } else {
+            _fun.SparseJacobianReverse(indVars, _jacSparsity.sparsity, jacRows, jacCols, jac, work);
+        }
+    }
+
+    vector<CGBase> mat(rows.size());
+    for (size_t e = 0; e < rows.size(); e++) {
+        if (posUnit[e] >= 0 && posAlpha[e] >= 0) {
+            mat[e] = jac[posUnit[e]] + alpha[0] * jac[posAlpha[e]];
+        } else if (posUnit[e] >= 0) {
+            mat[e] = jac[posUnit[e]];
+        } else {
+            mat[e] = alpha[0] * jac[posAlpha[e]];
+        }
+    }
+
+    finishedJob();
+
+    LanguageC<Base> langC(_baseTypeName);
+    langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+    langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
+    langC.setParameterPrecision(_parameterPrecision);
+    langC.setTemporaryWorkspace(_temporaryWorkspace, &_temporaryWorkspaceSize);
+    langC.setFunctionGraphPartitioning(_functionGraphPartitioning);
+    langC.setVectorizationHints(_vectorizationHints);
+    langC.setGenerateFunction(_name + "_" + FUNCTION_SPARSE_ITERATION_MATRIX);
+
+    std::ostringstream code;
+    std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("mat"));
+    LangCDefaultHessianVarNameGenerator<Base> nameGenAlpha(nameGen.get(), "alpha", n);
+
+    handler.generateCode(code, langC, mat, nameGenAlpha, _atomicFunctions, jobName);
+    flushSources();
+
+    /**
+     * sparsity
+     */
+    generateSparsity2DSource(_name + "_" + FUNCTION_ITERATION_MATRIX_SPARSITY, _iterMatSparsity);
+    saveSource(_name + "_" + FUNCTION_ITERATION_MATRIX_SPARSITY + ".c", _cache.str());
+    _cache.str("");
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::determineIterationMatrixSparsity() {
+    size_t m = _fun.Range();
+    size_t n = _fun.Domain();
+    size_t nCols = _iterMatColumns.size();
+
+    if (nCols == 0) {
+        throw CGException("The columns of the iteration matrix of model '", _name, "' were not defined");
+    }
+
+    // the iteration matrix columns where each independent variable is used
+    std::vector<std::vector<size_t> > indep2Cols(n);
+    for (size_t k = 0; k < nCols; k++) {
+        int j = _iterMatColumns[k];
+        int ja = _iterMatAlphaColumns[k];
+        if ((j < 0 && ja < 0) || j >= int(n) || ja >= int(n)) {
+            throw CGException("Invalid independent variable indexes for column ", k, " of the iteration matrix");
+        }
+        if (j >= 0)
+            indep2Cols[j].push_back(k);
+        if (ja >= 0 && ja != j)
+            indep2Cols[ja].push_back(k);
+    }
+
+    determineJacobianSparsity();
+
+    _iterMatSparsity.sparsity.resize(m);
+    _iterMatSparsity.rows.clear();
+    _iterMatSparsity.cols.clear();
+    for (size_t i = 0; i < m; i++) {
+        std::set<size_t>& rowCols = _iterMatSparsity.sparsity[i];
+        rowCols.clear();
+        for (size_t j : _jacSparsity.sparsity[i]) {
+            rowCols.insert(indep2Cols[j].begin(), indep2Cols[j].end());
+        }
+
+        for (size_t k : rowCols) {
+            _iterMatSparsity.rows.push_back(i);
+            _iterMatSparsity.cols.push_back(k);
+        }
+    }
+}
+
 template<class Base>
 void ModelCSourceGen<Base>::determineJacobianSparsity() {
     if (_jacSparsity.sparsity.size() > 0) {
         return;
     }
 
+    startingJob("'Jacobian'", JobTimer::SPARSITY);
+
     /**
      * Determine the sparsity pattern
      */
-    _jacSparsity.sparsity = jacobianSparsitySet<SparsitySetType, CGBase> (_fun);
+    if (_sparsityEngine == SparsityEngine::OperationGraph) {
+        _jacSparsity.sparsity = getGraphSparsity().jacobianSparsity();
+    } else {
+        _jacSparsity.sparsity = jacobianSparsitySet<SparsitySetType, CGBase> (_fun);
+    }
 
     if (!_custom_jac.defined) {
         generateSparsityIndexes(_jacSparsity.sparsity, _jacSparsity.rows, _jacSparsity.cols);
@@ -475,6 +821,10 @@ void ModelCSourceGen<Base>::determineJacobianSparsity() {
         _jacSparsity.rows = _custom_jac.row;
         _jacSparsity.cols = _custom_jac.col;
     }
+
+    reportJobInfo("non-zeros", _jacSparsity.rows.size());
+
+    finishedJob();
 }
 
 template<class Base>
@@ -482,7 +832,7 @@ void ModelCSourceGen<Base>::generateJacobianSparsitySource() {
     determineJacobianSparsity();
 
     generateSparsity2DSource(_name + "_" + FUNCTION_JACOBIAN_SPARSITY, _jacSparsity);
-    _sources[_name + "_" + FUNCTION_JACOBIAN_SPARSITY + ".c"] = _cache.str();
+    saveSource(_name + "_" + FUNCTION_JACOBIAN_SPARSITY + ".c", _cache.str());
     _cache.str("");
 }
 
@@ -88,6 +88,7 @@ void ModelCSourceGen<Base>::generateSparseReverseTwoSourcesWithAtomics(const std
 
         CodeHandler<Base> handler;
         handler.setJobTimer(_jobTimer);
+        handler.setScheduleOperations(_scheduleOperations);
 
         vector<CGBase> tx0(n);
         handler.makeVariables(tx0);
@@ -130,6 +131,9 @@ void ModelCSourceGen<Base>::generateSparseReverseTwoSourcesWithAtomics(const std
         langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
         langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
         langC.setParameterPrecision(_parameterPrecision);
+        langC.setTemporaryWorkspace(_temporaryWorkspace, &_temporaryWorkspaceSize);
+        langC.setFunctionGraphPartitioning(_functionGraphPartitioning);
+        langC.setVectorizationHints(_vectorizationHints);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_TWO << "_indep" << j;
         langC.setGenerateFunction(_cache.str());
@@ -139,6 +143,7 @@ void ModelCSourceGen<Base>::generateSparseReverseTwoSourcesWithAtomics(const std
         LangCDefaultReverse2VarNameGenerator<Base> nameGenRev2(nameGen.get(), n, 1);
 
         handler.generateCode(code, langC, pxCustom, nameGenRev2, _atomicFunctions, subJobName);
+        flushSources();
     }
 }
 
@@ -167,6 +172,7 @@ void ModelCSourceGen<Base>::generateSparseReverseTwoSourcesNoAtomics(const std::
     // we can use a new handler to reduce memory usage
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setScheduleOperations(_scheduleOperations);
 
     vector<CGBase> tx0(n);
     handler.makeVariables(tx0);
@@ -233,6 +239,9 @@ void ModelCSourceGen<Base>::generateSparseReverseTwoSourcesNoAtomics(const std::
         langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
         langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
         langC.setParameterPrecision(_parameterPrecision);
+        langC.setTemporaryWorkspace(_temporaryWorkspace, &_temporaryWorkspaceSize);
+        langC.setFunctionGraphPartitioning(_functionGraphPartitioning);
+        langC.setVectorizationHints(_vectorizationHints);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_TWO << "_indep" << j;
         langC.setGenerateFunction(_cache.str());
@@ -242,6 +251,7 @@ void ModelCSourceGen<Base>::generateSparseReverseTwoSourcesNoAtomics(const std::
         LangCDefaultReverse2VarNameGenerator<Base> nameGenRev2(nameGen.get(), n, 1);
 
         handler.generateCode(code, langC, pxCustom, nameGenRev2, _atomicFunctions, subJobName);
+        flushSources();
     }
 }
 
@@ -363,7 +373,7 @@ void ModelCSourceGen<Base>::generateReverseTwoSources() {
             "   return 0;\n"
             "};\n";
 
-    _sources[model_function + ".c"] = _cache.str();
+    saveSource(model_function + ".c", _cache.str());
     _cache.str("");
 }
 
@@ -19,6 +19,23 @@
 namespace CppAD {
 namespace cg {
 
+/**
+ * Submits a batch of independent jobs to an executor of the application
+ * (see ModelLibrary::setHostExecutor()).
+ * It returns a handle for the batch which is provided to the wait callback.
+ */
+using HostExecutorSubmit = void* (*)(void* executor,
+                                     void (*functions[])(void*),
+                                     void* args[],
+                                     int nJobs);
+
+/**
+ * Blocks until all the jobs of a batch submitted to an executor of the
+ * application have been executed.
+ */
+using HostExecutorWait = void (*)(void* executor,
+                                  void* batch);
+
 /**
  * Abstract class used to load models
  * 
@@ -134,6 +151,51 @@ public:
      */
     virtual unsigned int getThreadPoolNumberOfTimeMeas() const = 0;
 
+    /**
+     * Exports the job timing information (elapsed times and job order)
+     * learned by the thread pool for the multithreaded functions used so
+     * far, so that new processes can start with the same schedule
+     * (see setThreadPoolProfile()).
+     * It must not be called while models are being evaluated.
+     *
+     * @return the profile in a text format (empty if the models were not
+     *         compiled with pthreads multithreading support)
+     */
+    virtual std::string getThreadPoolProfile() const = 0;
+
+    /**
+     * Imports a job timing profile previously exported with
+     * getThreadPoolProfile().
+     * Entries for functions which do not exist or which have a different
+     * number of jobs are ignored.
+     * It must not be called while models are being evaluated.
+     *
+     * @param profile the profile in a text format
+     * @throws CGException if the profile is not valid
+     */
+    virtual void setThreadPoolProfile(const std::string& profile) = 0;
+
+    /**
+     * Defines the executor of the application used to run the jobs of
+     * multithreaded model evaluations.
+     * This is only used by the models if they were compiled with
+     * MultiThreadingType::HOST_EXECUTOR, in which case the library does not
+     * create any thread.
+     * It should be defined before using the models and the executor must
+     * remain valid while the models are used. Jobs are evaluated by the
+     * calling thread while no executor is defined.
+     *
+     * @param executor the executor provided to the callbacks
+     * @param submit the function used to submit a batch of jobs
+     * @param wait the function used to wait for a batch of jobs (it is
+     *             always called right after the batch is submitted by the
+     *             same thread)
+     * @return true if the library supports host executors
+     */
+    virtual bool setHostExecutor(void* executor,
+                                 HostExecutorSubmit submit,
+                                 HostExecutorWait wait) = 0;
+
     inline virtual ~ModelLibrary() = default;
 
 };
@@ -42,6 +42,10 @@ public:
     static const std::string FUNCTION_GETTHREADPOOLGUIDEDMAXGROUPWORK;
     static const std::string FUNCTION_SETTHREADPOOLNUMBEROFTIMEMEAS;
     static const std::string FUNCTION_GETTHREADPOOLNUMBEROFTIMEMEAS;
+    static const std::string FUNCTION_SETHOSTEXECUTOR;
+    static const std::string FUNCTION_GETTHREADPOOLPROFILE;
+    static const std::string FUNCTION_SETTHREADPOOLPROFILE;
+    static const std::string FUNCTION_GETTHREADPOOLDEFAULTPROFILE;
     static const unsigned long API_VERSION;
 protected:
     static const std::string CONST;
@@ -64,6 +68,11 @@ protected:
      * Parallelization can be disabled locally for each model.
      */
     MultiThreadingType _multiThreading;
+    /**
+     * job timing profile used by default by the thread pool
+     * (see ModelLibrary::getThreadPoolProfile())
+     */
+    std::string _threadPoolProfile;
     /**
      * temporary stream to generate source code
      */
@@ -151,6 +160,9 @@ public:
      * Parallelization can be disabled locally for each model.
      * Do not forget to add the appropriate compiler and linker flags
      * when multithreading is enabled.
+     * With MultiThreadingType::HOST_EXECUTOR the library does not create
+     * threads: jobs are dispatched to the executor registered with
+     * ModelLibrary::setHostExecutor().
      *
      * @param multiThreading multithreading support type
      */
@@ -158,6 +170,28 @@ public:
         _multiThreading = multiThreading;
     }
 
+    /**
+     * Provides the job timing profile embedded in the library.
+     *
+     * @return the profile (empty if no profile is embedded)
+     */
+    inline const std::string& getThreadPoolProfile() const {
+        return _threadPoolProfile;
+    }
+
+    /**
+     * Defines a job timing profile, previously exported with
+     * ModelLibrary::getThreadPoolProfile(), which is loaded whenever the
+     * library is opened so that the pthread pool starts with a learned
+     * schedule.
+     * It is only used with MultiThreadingType::PTHREADS.
+     *
+     * @param profile the profile (empty to not embed a profile)
+     */
+    inline void setThreadPoolProfile(const std::string& profile) {
+        _threadPoolProfile = profile;
+    }
+
     /**
      * Saves the generated C source code into several files.
      * 
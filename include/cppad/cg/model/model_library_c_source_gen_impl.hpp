@@ -21,7 +21,7 @@ namespace CppAD {
 namespace cg {
 
 template<class Base>
-const unsigned long ModelLibraryCSourceGen<Base>::API_VERSION = 7;
+const unsigned long ModelLibraryCSourceGen<Base>::API_VERSION = 8;
 
 template<class Base>
 const std::string ModelLibraryCSourceGen<Base>::FUNCTION_VERSION = "cppad_cg_version";
@@ -68,6 +68,18 @@ const std::string ModelLibraryCSourceGen<Base>::FUNCTION_SETTHREADPOOLNUMBEROFTI
 template<class Base>
 const std::string ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLNUMBEROFTIMEMEAS = "cppad_cg_thpool_get_number_of_time_meas";
 
+template<class Base>
+const std::string ModelLibraryCSourceGen<Base>::FUNCTION_SETHOSTEXECUTOR = "cppad_cg_set_host_executor";
+
+template<class Base>
+const std::string ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLPROFILE = "cppad_cg_thpool_get_profile";
+
+template<class Base>
+const std::string ModelLibraryCSourceGen<Base>::FUNCTION_SETTHREADPOOLPROFILE = "cppad_cg_thpool_set_profile";
+
+template<class Base>
+const std::string ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLDEFAULTPROFILE = "cppad_cg_thpool_get_default_profile";
+
 template<class Base>
 const std::string ModelLibraryCSourceGen<Base>::CONST = "const";
 
@@ -113,7 +125,8 @@ const std::map<std::string, std::string>& ModelLibraryCSourceGen<Base>::getLibra
         if(_multiThreading != MultiThreadingType::NONE) {
             bool usingMultiThreading = false;
             for (const auto& it : _models) {
-                if (it.second->isJacobianMultiThreadingEnabled() || it.second->isHessianMultiThreadingEnabled()) {
+                if (it.second->isJacobianMultiThreadingEnabled() || it.second->isHessianMultiThreadingEnabled() ||
+                    it.second->isForwardZeroMultiThreadingEnabled()) {
                     usingMultiThreading = true;
                     break;
                 }
@@ -125,6 +138,9 @@ const std::map<std::string, std::string>& ModelLibraryCSourceGen<Base>::getLibra
 
                 } else if (_multiThreading == MultiThreadingType::OPENMP) {
                     _libSources["thread_pool.c"] = CPPADCG_OPENMP_C_FILE;
+
+                } else if (_multiThreading == MultiThreadingType::HOST_EXECUTOR) {
+                    _libSources["thread_pool.c"] = CPPADCG_HOST_EXECUTOR_C_FILE;
                 }
             }
         }
@@ -168,9 +184,10 @@ void ModelLibraryCSourceGen<Base>::generateModelsSource(std::map<std::string, st
 template<class Base>
 void ModelLibraryCSourceGen<Base>::generateOnCloseSource(std::map<std::string, std::string>& sources) {
     bool pthreads = false;
-    if(_multiThreading == MultiThreadingType::PTHREADS) {
+    if(_multiThreading == MultiThreadingType::PTHREADS || _multiThreading == MultiThreadingType::HOST_EXECUTOR) {
         for (const auto& it : _models) {
-            if (it.second->isJacobianMultiThreadingEnabled() || it.second->isHessianMultiThreadingEnabled()) {
+            if (it.second->isJacobianMultiThreadingEnabled() || it.second->isHessianMultiThreadingEnabled() ||
+                    it.second->isForwardZeroMultiThreadingEnabled()) {
                 pthreads = true;
                 break;
             }
@@ -196,16 +213,26 @@ void ModelLibraryCSourceGen<Base>::generateThreadPoolSources(std::map<std::strin
     bool usingMultiThreading = false;
     if(_multiThreading != MultiThreadingType::NONE) {
         for (const auto& it : _models) {
-            if (it.second->isJacobianMultiThreadingEnabled() || it.second->isHessianMultiThreadingEnabled()) {
+            if (it.second->isJacobianMultiThreadingEnabled() || it.second->isHessianMultiThreadingEnabled() ||
+                    it.second->isForwardZeroMultiThreadingEnabled()) {
                 usingMultiThreading = true;
                 break;
             }
         }
     }
 
-    if (usingMultiThreading && _multiThreading == MultiThreadingType::PTHREADS) {
+    bool hostExecutor = _multiThreading == MultiThreadingType::HOST_EXECUTOR;
+
+    if (usingMultiThreading && (_multiThreading == MultiThreadingType::PTHREADS || hostExecutor)) {
         _cache.str("");
         _cache << CPPADCG_PTHREAD_POOL_H_FILE << "\n\n";
+        if (hostExecutor) {
+            _cache << CPPADCG_HOST_EXECUTOR_H_FILE << "\n\n";
+
+            _cache << "void " << FUNCTION_SETHOSTEXECUTOR << "(void* executor, cppadcg_host_submit_type submit, cppadcg_host_wait_type wait) {\n";
+            _cache << "   cppadcg_thpool_set_host_executor(executor, submit, wait);\n";
+            _cache << "}\n\n";
+        }
 
         _cache << "void " << FUNCTION_SETTHREADPOOLDISABLED << "(int disabled) {\n";
         _cache << "   cppadcg_thpool_set_disabled(disabled);\n";
@@ -255,6 +282,26 @@ void ModelLibraryCSourceGen<Base>::generateThreadPoolSources(std::map<std::strin
         _cache << "   return cppadcg_thpool_get_n_time_meas();\n";
         _cache << "}\n\n";
 
+        _cache << "int " << FUNCTION_GETTHREADPOOLPROFILE << "(int index, const char** name, int* n_jobs, unsigned int* n_meas, const float** ref_elapsed, const int** order) {\n";
+        _cache << "   return cppadcg_thpool_get_profile(index, name, n_jobs, n_meas, ref_elapsed, order);\n";
+        _cache << "}\n\n";
+
+        _cache << "void " << FUNCTION_SETTHREADPOOLPROFILE << "(const char* name, int n_jobs, unsigned int n_meas, const float* ref_elapsed, const int* order) {\n";
+        _cache << "   cppadcg_thpool_set_profile(name, n_jobs, n_meas, ref_elapsed, order);\n";
+        _cache << "}\n\n";
+
+        if (!_threadPoolProfile.empty() && !hostExecutor) {
+            _cache << "const char* " << FUNCTION_GETTHREADPOOLDEFAULTPROFILE << "() {\n";
+            _cache << "   return \"";
+            for (char c : _threadPoolProfile) {
+                if (c == '\n') _cache << "\\n\"\n          \"";
+                else if (c == '"' || c == '\\') _cache << '\\' << c;
+                else _cache << c;
+            }
+            _cache << "\";\n";
+            _cache << "}\n\n";
+        }
+
         sources["thread_pool_access.c"] = _cache.str();
 
     } else if(usingMultiThreading && _multiThreading == MultiThreadingType::OPENMP) {
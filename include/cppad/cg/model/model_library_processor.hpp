@@ -42,6 +42,10 @@ protected:
         return modelLibraryHelper_->getLibrarySources();
     }
 
+    /**
+     * Provides the source files of a model. The map is empty when the
+     * model uses a source sink (see ModelCSourceGen::setSourceSink()).
+     */
     inline const std::map<std::string, std::string>& getSources(ModelCSourceGen<Base>& model) {
         return model.getSources(modelLibraryHelper_->getMultiThreading(), modelLibraryHelper_);
     }
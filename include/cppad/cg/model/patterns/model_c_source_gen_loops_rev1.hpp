@@ -38,6 +38,7 @@ void ModelCSourceGen<Base>::prepareSparseReverseOneWithLoops(const std::map<size
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setScheduleOperations(_scheduleOperations);
     handler.setZeroDependents(false);
 
     auto& indexJrowDcl = *handler.makeIndexDclrNode("jrow");
@@ -282,6 +283,7 @@ void ModelCSourceGen<Base>::prepareSparseReverseOneWithLoops(const std::map<size
             LanguageC<Base> langC(_baseTypeName);
             langC.setFunctionIndexArgument(indexJrowDcl);
             langC.setParameterPrecision(_parameterPrecision);
+            langC.setVectorizationHints(_vectorizationHints);
 
             _cache.str("");
             std::ostringstream code;
@@ -295,6 +297,7 @@ void ModelCSourceGen<Base>::prepareSparseReverseOneWithLoops(const std::map<size
             _cache << "model (reverse one, loop " << lModel.getLoopId() << ", group " << tapeI << ")";
             string jobName = _cache.str();
             handler.generateCode(code, langC, pxCustom, nameGenHess, _atomicFunctions, jobName);
+            flushSources();
 
             _cache.str("");
             generateFunctionNameLoopRev1(_cache, lModel, tapeI);
@@ -323,7 +326,7 @@ void ModelCSourceGen<Base>::prepareSparseReverseOneWithLoops(const std::map<size
             nameGenHess.finalizeCustomFunctionVariables(_cache);
             _cache << "}\n\n";
 
-            _sources[functionName + ".c"] = _cache.str();
+            saveSource(functionName + ".c", _cache.str());
             _cache.str("");
 
             /**
@@ -340,16 +343,16 @@ void ModelCSourceGen<Base>::prepareSparseReverseOneWithLoops(const std::map<size
      * 
      */
     string functionRev1 = _name + "_" + FUNCTION_SPARSE_REVERSE_ONE;
-    _sources[functionRev1 + ".c"] = generateGlobalForRevWithLoopsFunctionSource(elements,
+    saveSource(functionRev1 + ".c", generateGlobalForRevWithLoopsFunctionSource(elements,
                                                                                 _loopRev1Groups, _nonLoopRev1Elements,
                                                                                 functionRev1, _name, _baseTypeName, "dep",
-                                                                                generateFunctionNameLoopRev1);
+                                                                                generateFunctionNameLoopRev1));
     /**
      * Sparsity
      */
     _cache.str("");
     generateSparsity1DSource2(_name + "_" + FUNCTION_REVERSE_ONE_SPARSITY, elements);
-    _sources[_name + "_" + FUNCTION_REVERSE_ONE_SPARSITY + ".c"] = _cache.str();
+    saveSource(_name + "_" + FUNCTION_REVERSE_ONE_SPARSITY + ".c", _cache.str());
     _cache.str("");
 }
 
@@ -366,6 +369,7 @@ void ModelCSourceGen<Base>::createReverseOneWithLoopsNL(CodeHandler<Base>& handl
     LanguageC<Base> langC(_baseTypeName);
     langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
     langC.setParameterPrecision(_parameterPrecision);
+    langC.setVectorizationHints(_vectorizationHints);
     _cache.str("");
     _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_ONE << "_noloop_dep" << i;
     langC.setGenerateFunction(_cache.str());
@@ -375,6 +379,7 @@ void ModelCSourceGen<Base>::createReverseOneWithLoopsNL(CodeHandler<Base>& handl
     LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), "dy", n);
 
     handler.generateCode(code, langC, jacRow, nameGenHess, _atomicFunctions, jobName);
+    flushSources();
 
     handler.resetNodes();
 }
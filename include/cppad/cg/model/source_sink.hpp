@@ -0,0 +1,348 @@
+#ifndef CPPAD_CG_SOURCE_SINK_INCLUDED
+#define CPPAD_CG_SOURCE_SINK_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Ciengis
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Receives source files as soon as they are generated so that they do not
+ * have to be kept in memory until the whole model source code is created
+ * (see ModelCSourceGen::setSourceSink()).
+ *
+ * @author Joao Leal
+ */
+class SourceSink {
+public:
+
+    /**
+     * Called once for each generated source file.
+     *
+     * @param filename the source file name
+     * @param source the content of the source file (it can be moved)
+     */
+    virtual void addSource(const std::string& filename,
+                           std::string&& source) = 0;
+
+    inline virtual ~SourceSink() = default;
+};
+
+/**
+ * Saves each generated source file into a folder.
+ *
+ * @author Joao Leal
+ */
+class FileSourceSink : public SourceSink {
+protected:
+    std::string _folder;
+    std::vector<std::string> _files;
+    bool _folderCreated;
+public:
+
+    /**
+     * @param folder the folder where source files are saved
+     */
+    inline explicit FileSourceSink(std::string folder) :
+        _folder(std::move(folder)),
+        _folderCreated(false) {
+    }
+
+    inline const std::string& getFolder() const {
+        return _folder;
+    }
+
+    /**
+     * @return the paths of the source files saved so far
+     */
+    inline const std::vector<std::string>& getFiles() const {
+        return _files;
+    }
+
+    void addSource(const std::string& filename,
+                   std::string&& source) override {
+        if (!_folderCreated) {
+            system::createFolder(_folder);
+            _folderCreated = true;
+        }
+
+        std::string path = system::createPath(_folder, filename);
+
+        std::ofstream file(path.c_str());
+        file << source;
+        file.close();
+        if (file.fail()) {
+            throw CGException("Failed to save source file '", path, "'");
+        }
+
+        _files.push_back(path);
+    }
+};
+
+/**
+ * Compiles each generated source file into an object file as soon as it
+ * is available.
+ * The source code is provided to the compiler without being saved to disk
+ * unless the compiler is configured to do so
+ * (see CCompiler::setSaveToDiskFirst()).
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class CompilerSourceSink : public SourceSink {
+protected:
+    CCompiler<Base>& _compiler;
+    bool _posIndepCode;
+    JobTimer* _timer;
+    std::map<std::string, std::string> _single;
+public:
+
+    /**
+     * @param compiler the compiler used to create the object files
+     * @param posIndepCode whether or not to create position-independent
+     *                     code for dynamic linking
+     * @param timer an optional job timer
+     */
+    inline CompilerSourceSink(CCompiler<Base>& compiler,
+                              bool posIndepCode,
+                              JobTimer* timer = nullptr) :
+        _compiler(compiler),
+        _posIndepCode(posIndepCode),
+        _timer(timer) {
+    }
+
+    void addSource(const std::string& filename,
+                   std::string&& source) override {
+        _single[filename] = std::move(source);
+        try {
+            _compiler.compileSources(_single, _posIndepCode, _timer);
+        } catch (...) {
+            _single.clear();
+            throw;
+        }
+        _single.clear(); // release the source code
+    }
+};
+
+/**
+ * Compiles generated source files in background threads while the
+ * generation of other source files continues.
+ * The main thread only queues the source code and reports the completed
+ * compilations to the job timer.
+ * finish() must be called once all the sources have been provided.
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class PipelinedCompilerSourceSink : public SourceSink {
+protected:
+    using clock = std::chrono::steady_clock;
+
+    /**
+     * A compiled source file
+     */
+    struct Compiled {
+        std::string name;
+        std::string object;
+        clock::duration elapsed;
+    };
+    AbstractCCompiler<Base>& _compiler;
+    bool _posIndepCode;
+    JobTimer* _timer;
+    /**
+     * the maximum number of source files waiting to be compiled
+     * (limits the memory used by sources in the queue)
+     */
+    size_t _maxQueued;
+    std::mutex _mutex;
+    /**
+     * used to wake up workers when there are new sources (or when closing)
+     */
+    std::condition_variable _sourceAvailable;
+    /**
+     * used to wake up the generator when a worker takes a source
+     */
+    std::condition_variable _slotAvailable;
+    std::deque<std::pair<std::string, std::string> > _queue;
+    std::vector<Compiled> _compiled;
+    std::exception_ptr _error;
+    bool _closing;
+    size_t _count;
+    std::vector<std::thread> _workers;
+public:
+
+    /**
+     * Creates the compilation threads.
+     *
+     * @param compiler the compiler used to create the object files
+     * @param posIndepCode whether or not to create position-independent
+     *                     code for dynamic linking
+     * @param threads the number of compilation threads (0 uses the number
+     *                of hardware threads)
+     * @param timer an optional job timer
+     */
+    inline PipelinedCompilerSourceSink(AbstractCCompiler<Base>& compiler,
+                                       bool posIndepCode,
+                                       size_t threads = 1,
+                                       JobTimer* timer = nullptr) :
+        _compiler(compiler),
+        _posIndepCode(posIndepCode),
+        _timer(timer),
+        _closing(false),
+        _count(0) {
+        if (threads == 0) {
+            threads = std::thread::hardware_concurrency();
+        }
+        threads = std::max<size_t>(threads, 1);
+        _maxQueued = 2 * threads;
+
+        _compiler.prepareFolders();
+
+        for (size_t t = 0; t < threads; t++) {
+            _workers.emplace_back([this]() {
+                compileQueued();
+            });
+        }
+    }
+
+    PipelinedCompilerSourceSink(const PipelinedCompilerSourceSink& orig) = delete;
+    PipelinedCompilerSourceSink& operator=(const PipelinedCompilerSourceSink& rhs) = delete;
+
+    void addSource(const std::string& filename,
+                   std::string&& source) override {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _slotAvailable.wait(lock, [this]() {
+                return _queue.size() < _maxQueued || _error != nullptr;
+            });
+            if (_error == nullptr) {
+                _queue.emplace_back(filename, std::move(source));
+            }
+        }
+        _sourceAvailable.notify_one();
+
+        reportCompiled();
+    }
+
+    /**
+     * Waits for all queued sources to be compiled and registers the
+     * object files in the compiler.
+     *
+     * @throws CGException if the compilation of a source file failed
+     */
+    inline void finish() {
+        join();
+        reportCompiled();
+    }
+
+    inline virtual ~PipelinedCompilerSourceSink() {
+        join(false);
+    }
+
+protected:
+
+    inline void join(bool rethrow = true) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _closing = true;
+        }
+        _sourceAvailable.notify_all();
+
+        for (auto& w : _workers) {
+            if (w.joinable())
+                w.join();
+        }
+
+        if (rethrow && _error != nullptr) {
+            std::exception_ptr e = _error;
+            _error = nullptr;
+            std::rethrow_exception(e);
+        }
+    }
+
+    /**
+     * Registers the object files compiled so far (main thread only)
+     */
+    inline void reportCompiled() {
+        std::vector<Compiled> compiled;
+        std::exception_ptr error;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            compiled.swap(_compiled);
+            error = _error;
+        }
+
+        for (const Compiled& c : compiled) {
+            _compiler.addObjectFile(c.name, c.object);
+            _count++;
+            if (_timer != nullptr) {
+                _timer->completedJob("'" + c.object + "'", JobTimer::COMPILING, c.elapsed,
+                                     "[" + std::to_string(_count) + "]");
+            }
+        }
+
+        if (error != nullptr) {
+            join(false);
+            _error = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+
+    /**
+     * Executed by each worker thread
+     */
+    inline void compileQueued() {
+        while (true) {
+            std::pair<std::string, std::string> src;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _sourceAvailable.wait(lock, [this]() {
+                    return !_queue.empty() || _closing;
+                });
+                if (_queue.empty() || _error != nullptr)
+                    return; // closing
+                src = std::move(_queue.front());
+                _queue.pop_front();
+            }
+            _slotAvailable.notify_one();
+
+            Compiled c;
+            c.name = src.first;
+            c.object = _compiler.getObjectFilePath(src.first);
+            clock::time_point begin = clock::now();
+            try {
+                _compiler.compileSingle(src.first, src.second, c.object, _posIndepCode);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (_error == nullptr)
+                    _error = std::current_exception();
+                _queue.clear();
+                _slotAvailable.notify_all();
+                return;
+            }
+            c.elapsed = clock::now() - begin;
+
+            std::string().swap(src.second); // release the source code
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            _compiled.push_back(std::move(c));
+        }
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
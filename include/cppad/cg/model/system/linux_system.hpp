@@ -18,6 +18,7 @@
 
 #if CPPAD_CG_SYSTEM_LINUX
 #include <unistd.h>
+#include <fcntl.h>
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <sys/stat.h>
@@ -68,11 +69,26 @@ public:
     FDHandler write;
 public:
 
+    /**
+     * Creates a pipe whose file descriptors are closed when a process is
+     * executed, so that processes forked concurrently by other threads do
+     * not keep the pipe open (e.g. a compiler would never see the end of
+     * its standard input).
+     */
     inline void create() {
         int fd[2]; /** file descriptors used to communicate between processes*/
+#ifdef CPPAD_CG_SYSTEM_APPLE
+        // pipe2() is not available: pipes are created while holding forkMutex()
         if (pipe(fd) < 0) {
             throw CGException("Failed to create pipe");
         }
+        fcntl(fd[0], F_SETFD, FD_CLOEXEC);
+        fcntl(fd[1], F_SETFD, FD_CLOEXEC);
+#else
+        if (pipe2(fd, O_CLOEXEC) < 0) {
+            throw CGException("Failed to create pipe");
+        }
+#endif
         read.fd = fd[0];
         read.closed = false;
         write.fd = fd[1];
@@ -80,6 +96,17 @@ public:
     }
 };
 
+#ifdef CPPAD_CG_SYSTEM_APPLE
+/**
+ * Serializes the creation of pipes and the forking of processes where the
+ * close-on-exec flag cannot be set atomically.
+ */
+inline std::mutex& forkMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+#endif
+
 }
 
 #ifdef CPPAD_CG_SYSTEM_APPLE
@@ -201,6 +228,10 @@ inline void callExecutable(const std::string& executable,
                            const std::string* stdInMessage) {
     std::string execName = filenameFromPath(executable);
 
+#ifdef CPPAD_CG_SYSTEM_APPLE
+    std::unique_lock<std::mutex> forkLock(forkMutex());
+#endif
+
     PipeHandler pipeMsg; // file descriptors used to communicate between processes
     pipeMsg.create();
 
@@ -303,6 +334,9 @@ inline void callExecutable(const std::string& executable,
     /***************************************************************************
      * Parent process
      **************************************************************************/
+#ifdef CPPAD_CG_SYSTEM_APPLE
+    forkLock.unlock();
+#endif
     pipeMsg.write.close();
     if(stdOutErrMessage != nullptr) {
         pipeStdOutErr.write.close();
@@ -391,6 +425,36 @@ inline void callExecutable(const std::string& executable,
     }
 }
 
+inline bool getMemoryUsage(size_t& rss,
+                           size_t& peakRss) {
+    rss = 0;
+    peakRss = 0;
+
+    std::ifstream status("/proc/self/status");
+    if (!status.is_open())
+        return false;
+
+    size_t found = 0;
+    std::string line;
+    while (found < 2 && std::getline(status, line)) {
+        size_t* value;
+        if (line.compare(0, 6, "VmRSS:") == 0)
+            value = &rss;
+        else if (line.compare(0, 6, "VmHWM:") == 0)
+            value = &peakRss;
+        else
+            continue;
+
+        std::istringstream is(line.substr(6));
+        size_t kB;
+        is >> kB;
+        *value = kB * 1024;
+        found++;
+    }
+
+    return found == 2;
+}
+
 } // END system namespace
 
 } // END cg namespace
@@ -112,6 +112,16 @@ inline void callExecutable(const std::string& executable,
                            std::string* stdOutErrMessage = nullptr,
                            const std::string* stdInMessage = nullptr);
 
+/**
+ * Determines the memory used by the current process (system dependent).
+ *
+ * @param rss the current resident set size (in bytes)
+ * @param peakRss the highest resident set size so far (in bytes)
+ * @return false if the memory usage could not be determined
+ */
+inline bool getMemoryUsage(size_t& rss,
+                           size_t& peakRss);
+
 }
 
 } // END cg namespace
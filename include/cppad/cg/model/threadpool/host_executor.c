@@ -0,0 +1,212 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Ciengis
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+/**
+ * Implementation of the thread pool interface used by the generated models
+ * (see pthread_pool.h) which dispatches jobs to an executor provided by
+ * the application (no threads are created by the model library).
+ * Jobs are evaluated by the calling thread while no executor is registered.
+ */
+
+#include <stdlib.h>
+
+enum ScheduleStrategy {SCHED_STATIC = 1,
+                       SCHED_DYNAMIC = 2,
+                       SCHED_GUIDED = 3
+                       };
+
+enum ElapsedTimeReference {ELAPSED_TIME_AVG,
+                           ELAPSED_TIME_MIN};
+
+typedef void (* thpool_function_type)(void*);
+
+typedef struct cppadcg_thpool_profile {
+    const char* name;
+    int n_jobs;
+    float* ref_elapsed;
+    int* order;
+    unsigned int n_meas;
+    int last_elapsed_changed;
+    int registered;
+    struct cppadcg_thpool_profile* next;
+} cppadcg_thpool_profile;
+
+typedef void* (*cppadcg_host_submit_type)(void* executor,
+                                          thpool_function_type functions[],
+                                          void* args[],
+                                          int nJobs);
+
+typedef void (*cppadcg_host_wait_type)(void* executor,
+                                       void* batch);
+
+static void* cppadcg_host_executor = NULL;
+static cppadcg_host_submit_type cppadcg_host_submit = NULL;
+static cppadcg_host_wait_type cppadcg_host_wait = NULL;
+static int cppadcg_pool_n_threads = 2;
+static int cppadcg_pool_disabled = 0; // false
+static int cppadcg_pool_verbose = 0; // false
+static enum ScheduleStrategy schedule_strategy = SCHED_DYNAMIC;
+
+/* ========================== PUBLIC API ============================ */
+
+void cppadcg_thpool_set_host_executor(void* executor,
+                                      cppadcg_host_submit_type submit,
+                                      cppadcg_host_wait_type wait) {
+    if (submit == NULL || wait == NULL) {
+        cppadcg_host_submit = NULL;
+        cppadcg_host_wait = NULL;
+        cppadcg_host_executor = NULL;
+    } else {
+        cppadcg_host_executor = executor;
+        cppadcg_host_submit = submit;
+        cppadcg_host_wait = wait;
+    }
+}
+
+void cppadcg_thpool_set_threads(int n) {
+    cppadcg_pool_n_threads = n;
+}
+
+int cppadcg_thpool_get_threads() {
+    return cppadcg_pool_n_threads;
+}
+
+void cppadcg_thpool_set_scheduler_strategy(enum ScheduleStrategy s) {
+    // scheduling is the responsibility of the host executor
+    schedule_strategy = s;
+}
+
+enum ScheduleStrategy cppadcg_thpool_get_scheduler_strategy() {
+    return schedule_strategy;
+}
+
+void cppadcg_thpool_set_disabled(int disabled) {
+    cppadcg_pool_disabled = disabled;
+}
+
+int cppadcg_thpool_is_disabled() {
+    return cppadcg_pool_disabled || cppadcg_host_submit == NULL;
+}
+
+void cppadcg_thpool_set_guided_maxgroupwork(float v) {
+}
+
+float cppadcg_thpool_get_guided_maxgroupwork() {
+    return 1.0;
+}
+
+unsigned int cppadcg_thpool_get_n_time_meas() {
+    return 0; // no time measurements are required for scheduling
+}
+
+void cppadcg_thpool_set_n_time_meas(unsigned int n) {
+}
+
+enum ElapsedTimeReference cppadcg_thpool_get_time_meas_ref() {
+    return ELAPSED_TIME_MIN;
+}
+
+void cppadcg_thpool_set_time_meas_ref(enum ElapsedTimeReference r) {
+}
+
+void cppadcg_thpool_set_verbose(int v) {
+    cppadcg_pool_verbose = v;
+}
+
+int cppadcg_thpool_is_verbose() {
+    return cppadcg_pool_verbose;
+}
+
+void cppadcg_thpool_prepare() {
+}
+
+void cppadcg_thpool_add_job(thpool_function_type function,
+                            void* arg,
+                            float* avgElapsed,
+                            float* elapsed) {
+    if (!cppadcg_thpool_is_disabled()) {
+        void* batch = (*cppadcg_host_submit)(cppadcg_host_executor, &function, &arg, 1);
+        (*cppadcg_host_wait)(cppadcg_host_executor, batch);
+        return;
+    }
+
+    // host executor not used
+    (*function)(arg);
+}
+
+void cppadcg_thpool_add_jobs(thpool_function_type functions[],
+                             void* args[],
+                             const float avgElapsed[],
+                             float elapsed[],
+                             const int order[],
+                             int job2Thread[],
+                             int nJobs,
+                             int lastElapsedChanged) {
+    int i;
+    if (!cppadcg_thpool_is_disabled()) {
+        /**
+         * the batch is waited for here (and not in cppadcg_thpool_wait())
+         * so that models can be evaluated concurrently by several threads
+         * of the application
+         */
+        void* batch = (*cppadcg_host_submit)(cppadcg_host_executor, functions, args, nJobs);
+        (*cppadcg_host_wait)(cppadcg_host_executor, batch);
+        return;
+    }
+
+    // host executor not used
+    for (i = 0; i < nJobs; ++i) {
+        (*functions[i])(args[i]);
+    }
+}
+
+void cppadcg_thpool_wait() {
+    // jobs are always complete when cppadcg_thpool_add_jobs() returns
+}
+
+void cppadcg_thpool_update_order(float refElapsed[],
+                                 unsigned int nTimeMeas,
+                                 const float elapsed[],
+                                 int order[],
+                                 int nJobs) {
+}
+
+/**
+ * Job timing profiles are not used since the scheduling is the
+ * responsibility of the host executor
+ */
+void cppadcg_thpool_register_profile(cppadcg_thpool_profile* profile) {
+    profile->registered = 1;
+}
+
+int cppadcg_thpool_get_profile(int index,
+                               const char** name,
+                               int* n_jobs,
+                               unsigned int* n_meas,
+                               const float** ref_elapsed,
+                               const int** order) {
+    return 0;
+}
+
+void cppadcg_thpool_set_profile(const char* name,
+                                int n_jobs,
+                                unsigned int n_meas,
+                                const float ref_elapsed[],
+                                const int order[]) {
+}
+
+void cppadcg_thpool_shutdown() {
+    cppadcg_thpool_set_host_executor(NULL, NULL, NULL);
+}
@@ -0,0 +1,55 @@
+#ifndef CPPADCG_HOST_EXECUTOR_H
+#define CPPADCG_HOST_EXECUTOR_H
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Ciengis
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Submits a batch of independent jobs to the executor of the application.
+ *
+ * @param executor the executor provided when the callbacks were registered
+ * @param functions the function of each job
+ * @param args the argument of each job
+ * @param nJobs the number of jobs
+ * @return a handle for the submitted batch which is provided to the wait
+ *         callback
+ */
+typedef void* (*cppadcg_host_submit_type)(void* executor,
+                                          void (*functions[])(void*),
+                                          void* args[],
+                                          int nJobs);
+
+/**
+ * Blocks until all the jobs of a batch have been executed.
+ * The calling thread may be used to execute jobs.
+ *
+ * @param executor the executor provided when the callbacks were registered
+ * @param batch the handle returned by the submit callback
+ */
+typedef void (*cppadcg_host_wait_type)(void* executor,
+                                       void* batch);
+
+void cppadcg_thpool_set_host_executor(void* executor,
+                                      cppadcg_host_submit_type submit,
+                                      cppadcg_host_wait_type wait);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
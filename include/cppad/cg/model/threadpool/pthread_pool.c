@@ -21,6 +21,7 @@
 #include <unistd.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <pthread.h>
 #include <errno.h>
 #include <time.h>
@@ -43,6 +44,27 @@ enum ElapsedTimeReference {ELAPSED_TIME_AVG,
 typedef struct ThPool ThPool;
 typedef void (* thpool_function_type)(void*);
 
+typedef struct cppadcg_thpool_profile {
+    const char* name;
+    int n_jobs;
+    float* ref_elapsed;
+    int* order;
+    unsigned int n_meas;
+    int last_elapsed_changed;
+    int registered;
+    struct cppadcg_thpool_profile* next;
+} cppadcg_thpool_profile;
+
+/* profile imported before the corresponding function was used */
+typedef struct PendingProfile {
+    char* name;
+    int n_jobs;
+    unsigned int n_meas;
+    float* ref_elapsed;
+    int* order;
+    struct PendingProfile* next;
+} PendingProfile;
+
 static ThPool* volatile cppadcg_pool = NULL;
 static int cppadcg_pool_n_threads = 2;
 static int cppadcg_pool_disabled = 0; // false
@@ -53,6 +75,10 @@ static float cppadcg_pool_guided_maxgroupwork = 0.75;
 
 static enum ScheduleStrategy schedule_strategy = SCHED_DYNAMIC;
 
+static pthread_mutex_t cppadcg_profile_mutex = PTHREAD_MUTEX_INITIALIZER;
+static cppadcg_thpool_profile* cppadcg_profiles = NULL; /* registered profiles */
+static PendingProfile* cppadcg_pending_profiles = NULL;
+
 /* ==================== INTERNAL HIGH LEVEL API  ====================== */
 
 static ThPool* thpool_init(int num_threads);
@@ -353,11 +379,159 @@ void cppadcg_thpool_update_order(float refElapsed[],
 
 }
 
+static int profile_is_valid(int n_jobs,
+                            const int order[]) {
+    int i, j;
+    for (i = 0; i < n_jobs; ++i) {
+        if (order[i] < 0 || order[i] >= n_jobs)
+            return 0;
+        for (j = 0; j < i; ++j) {
+            if (order[j] == order[i])
+                return 0;
+        }
+    }
+    return 1;
+}
+
+static void profile_apply(cppadcg_thpool_profile* profile,
+                          unsigned int n_meas,
+                          const float ref_elapsed[],
+                          const int order[]) {
+    int i;
+    for (i = 0; i < profile->n_jobs; ++i) {
+        profile->ref_elapsed[i] = ref_elapsed[i];
+        profile->order[i] = order[i];
+    }
+    profile->n_meas = n_meas;
+    profile->last_elapsed_changed = 1;
+}
+
+static void pending_profile_free(PendingProfile* p) {
+    free(p->name);
+    free(p->ref_elapsed);
+    free(p->order);
+    free(p);
+}
+
+void cppadcg_thpool_register_profile(cppadcg_thpool_profile* profile) {
+    PendingProfile* p;
+    PendingProfile** prev;
+
+    pthread_mutex_lock(&cppadcg_profile_mutex);
+    if (!profile->registered) {
+        // use a previously imported profile
+        prev = &cppadcg_pending_profiles;
+        for (p = cppadcg_pending_profiles; p != NULL; prev = &p->next, p = p->next) {
+            if (strcmp(p->name, profile->name) == 0) {
+                if (p->n_jobs == profile->n_jobs) {
+                    profile_apply(profile, p->n_meas, p->ref_elapsed, p->order);
+                }
+                *prev = p->next;
+                pending_profile_free(p);
+                break;
+            }
+        }
+
+        profile->next = cppadcg_profiles;
+        cppadcg_profiles = profile;
+        profile->registered = 1;
+    }
+    pthread_mutex_unlock(&cppadcg_profile_mutex);
+}
+
+int cppadcg_thpool_get_profile(int index,
+                               const char** name,
+                               int* n_jobs,
+                               unsigned int* n_meas,
+                               const float** ref_elapsed,
+                               const int** order) {
+    cppadcg_thpool_profile* profile;
+    int i = 0;
+
+    pthread_mutex_lock(&cppadcg_profile_mutex);
+    for (profile = cppadcg_profiles; profile != NULL && i < index; profile = profile->next) {
+        i++;
+    }
+    if (profile != NULL) {
+        *name = profile->name;
+        *n_jobs = profile->n_jobs;
+        *n_meas = profile->n_meas;
+        *ref_elapsed = profile->ref_elapsed;
+        *order = profile->order;
+    }
+    pthread_mutex_unlock(&cppadcg_profile_mutex);
+
+    return profile != NULL;
+}
+
+void cppadcg_thpool_set_profile(const char* name,
+                                int n_jobs,
+                                unsigned int n_meas,
+                                const float ref_elapsed[],
+                                const int order[]) {
+    cppadcg_thpool_profile* profile;
+    PendingProfile* p;
+    int i;
+
+    if (n_jobs <= 0 || !profile_is_valid(n_jobs, order))
+        return;
+
+    pthread_mutex_lock(&cppadcg_profile_mutex);
+    for (profile = cppadcg_profiles; profile != NULL; profile = profile->next) {
+        if (strcmp(profile->name, name) == 0) {
+            if (profile->n_jobs == n_jobs) {
+                profile_apply(profile, n_meas, ref_elapsed, order);
+            }
+            pthread_mutex_unlock(&cppadcg_profile_mutex);
+            return;
+        }
+    }
+
+    // the function has not been used yet
+    for (p = cppadcg_pending_profiles; p != NULL; p = p->next) {
+        if (strcmp(p->name, name) == 0)
+            break;
+    }
+
+    if (p == NULL) {
+        p = (PendingProfile*) malloc(sizeof(PendingProfile));
+        p->name = (char*) malloc(strlen(name) + 1);
+        strcpy(p->name, name);
+        p->ref_elapsed = NULL;
+        p->order = NULL;
+        p->next = cppadcg_pending_profiles;
+        cppadcg_pending_profiles = p;
+    } else {
+        free(p->ref_elapsed);
+        free(p->order);
+    }
+
+    p->n_jobs = n_jobs;
+    p->n_meas = n_meas;
+    p->ref_elapsed = (float*) malloc(n_jobs * sizeof(float));
+    p->order = (int*) malloc(n_jobs * sizeof(int));
+    for (i = 0; i < n_jobs; ++i) {
+        p->ref_elapsed[i] = ref_elapsed[i];
+        p->order[i] = order[i];
+    }
+    pthread_mutex_unlock(&cppadcg_profile_mutex);
+}
+
 void cppadcg_thpool_shutdown() {
+    PendingProfile* p;
+
     if(cppadcg_pool != NULL) {
         thpool_destroy(cppadcg_pool);
         cppadcg_pool = NULL;
     }
+
+    pthread_mutex_lock(&cppadcg_profile_mutex);
+    while (cppadcg_pending_profiles != NULL) {
+        p = cppadcg_pending_profiles;
+        cppadcg_pending_profiles = p->next;
+        pending_profile_free(p);
+    }
+    pthread_mutex_unlock(&cppadcg_profile_mutex);
 }
 
 /* ========================== PROTOTYPES ============================ */
@@ -29,6 +29,21 @@ enum ElapsedTimeReference {ELAPSED_TIME_AVG,
 
 typedef void (*cppadcg_thpool_function_type)(void*);
 
+/**
+ * The timing information used to schedule the jobs of a multithreaded
+ * function (it can be exported and imported to warm-start the scheduling).
+ */
+typedef struct cppadcg_thpool_profile {
+    const char* name;
+    int n_jobs;
+    float* ref_elapsed;
+    int* order;
+    unsigned int n_meas;
+    int last_elapsed_changed;
+    int registered;
+    struct cppadcg_thpool_profile* next;
+} cppadcg_thpool_profile;
+
 
 void cppadcg_thpool_set_threads(int n);
 
@@ -89,6 +104,21 @@ void cppadcg_thpool_update_order(float refElapsed[],
                                  int order[],
                                  int nJobs);
 
+void cppadcg_thpool_register_profile(cppadcg_thpool_profile* profile);
+
+int cppadcg_thpool_get_profile(int index,
+                               const char** name,
+                               int* n_jobs,
+                               unsigned int* n_meas,
+                               const float** ref_elapsed,
+                               const int** order);
+
+void cppadcg_thpool_set_profile(const char* name,
+                                int n_jobs,
+                                unsigned int n_meas,
+                                const float ref_elapsed[],
+                                const int order[]);
+
 void cppadcg_thpool_shutdown();
 
 #ifdef __cplusplus
@@ -0,0 +1,466 @@
+#ifndef CPPAD_CG_TASK_GRAPH_INCLUDED
+#define CPPAD_CG_TASK_GRAPH_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Ciengis
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Partitions the operations required to evaluate a set of dependent
+ * variables into tasks which can be executed in parallel.
+ *
+ * Tasks are organized in levels: the tasks of a level only depend on the
+ * independent variables and on values exported by the tasks of previous
+ * levels, so that all the tasks of a level can run concurrently.
+ * The values exchanged between tasks are stored in a workspace array.
+ *
+ * The partition is determined from the outputs towards the inputs:
+ * the outputs are split into contiguous groups with a similar number of
+ * operations (one per task), the operations used by a single group are
+ * assigned to its task, and the operations shared by several groups are
+ * partitioned again in a previous level.
+ * A level is executed by a single task when most of its operations would
+ * be shared, or when the maximum number of levels is reached.
+ *
+ * Loops (index operations) are not supported.
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class TaskGraph {
+public:
+    using Node = OperationNode<Base>;
+    using CGB = CG<Base>;
+
+    /**
+     * A group of operations evaluated by a single function
+     */
+    struct Task {
+        /// the nodes whose values are saved in the workspace by this task
+        std::vector<Node*> outputs;
+        /// the nodes computed by tasks of previous levels used by this task
+        std::vector<Node*> inputs;
+        /// the number of operations evaluated by this task
+        size_t operations;
+        /// position of the first output in the workspace
+        size_t offset;
+
+        inline Task() :
+            operations(0),
+            offset(0) {
+        }
+    };
+
+    static const size_t NONE;
+    /**
+     * maximum number of tasks per level
+     */
+    static const size_t MAX_TASKS = 64;
+protected:
+    CodeHandler<Base>& handler_;
+    /**
+     * maximum number of tasks in each level
+     */
+    size_t maxTasks_;
+    /**
+     * maximum number of levels
+     */
+    size_t maxLevels_;
+    /**
+     * the tasks of each level (in the order they must be executed)
+     */
+    std::vector<std::vector<Task> > levels_;
+    /**
+     * the workspace position of the values of each node (by handler
+     * position)
+     */
+    std::vector<size_t> position_;
+    size_t workspaceSize_;
+public:
+
+    /**
+     * @param handler The code handler with the operation graph
+     * @param maxTasks The maximum number of tasks in each level (at most
+     *                 MAX_TASKS)
+     * @param maxLevels The maximum number of levels
+     */
+    inline TaskGraph(CodeHandler<Base>& handler,
+                     size_t maxTasks,
+                     size_t maxLevels = 4) :
+        handler_(handler),
+        maxTasks_(std::max<size_t>(1, std::min<size_t>(maxTasks, MAX_TASKS))),
+        maxLevels_(std::max<size_t>(1, maxLevels)),
+        workspaceSize_(0) {
+    }
+
+    TaskGraph(const TaskGraph&) = delete;
+    TaskGraph& operator=(const TaskGraph&) = delete;
+
+    virtual ~TaskGraph() = default;
+
+    /**
+     * @return the tasks of each level (in the order they must be executed)
+     */
+    inline const std::vector<std::vector<Task> >& getLevels() const {
+        return levels_;
+    }
+
+    /**
+     * @return the total number of tasks
+     */
+    inline size_t getTaskCount() const {
+        size_t n = 0;
+        for (const auto& l : levels_)
+            n += l.size();
+        return n;
+    }
+
+    /**
+     * @return the number of elements of the workspace array
+     */
+    inline size_t getWorkspaceSize() const {
+        return workspaceSize_;
+    }
+
+    /**
+     * @return the position in the workspace of the value of a node or
+     *         NONE if the node is not the output of any task
+     */
+    inline size_t getWorkspacePosition(const Node& node) const {
+        size_t p = node.getHandlerPosition();
+        return p < position_.size() ? position_[p] : NONE;
+    }
+
+    /**
+     * Determines the tasks required to evaluate dependent variables.
+     *
+     * @param dep The dependent variables (must belong to the handler)
+     * @throws CGException if the graph contains loops or the dependents
+     *                     belong to another handler
+     */
+    template<class VectorCG>
+    inline void partition(const VectorCG& dep) {
+        size_t nNodes = handler_.getManagedNodesCount();
+
+        levels_.clear();
+        position_.assign(nNodes, NONE);
+        workspaceSize_ = 0;
+
+        std::vector<char> isTarget(nNodes, 0);
+        std::vector<Node*> targets;
+        for (size_t i = 0; i < dep.size(); i++) {
+            Node* node = dep[i].getOperationNode();
+            if (node == nullptr || node->getOperationType() == CGOpCode::Inv)
+                continue;
+            if (node->getCodeHandler() != &handler_) {
+                throw CGException("Dependent variable ", i, " does not belong to the provided handler");
+            }
+            if (!isTarget[node->getHandlerPosition()]) {
+                isTarget[node->getHandlerPosition()] = 1;
+                targets.push_back(node);
+            }
+        }
+
+        std::vector<uint64_t> mask(nNodes, 0);
+        std::vector<size_t> visited(nNodes, 0);
+        size_t visitId = 0;
+
+        std::vector<size_t> nextMark(nNodes, NONE);
+        std::vector<std::vector<Task> > topDown;
+
+        while (!targets.empty()) {
+            /**
+             * all the operations required by the targets
+             */
+            std::vector<Node*> order;
+            std::vector<size_t> weight(targets.size());
+            visitId++;
+            for (size_t t = 0; t < targets.size(); t++) {
+                size_t before = order.size();
+                addCone(*targets[t], visited, visitId, order);
+                weight[t] = order.size() - before;
+            }
+
+            /**
+             * split the targets into contiguous groups with a similar number
+             * of new operations
+             */
+            bool lastLevel = topDown.size() + 1 >= maxLevels_;
+            size_t nTasks = lastLevel ? 1 : std::min(maxTasks_, targets.size());
+
+            std::vector<size_t> group(targets.size(), 0);
+            if (nTasks > 1) {
+                size_t total = order.size();
+                size_t cumulative = 0;
+                for (size_t t = 0; t < targets.size(); t++) {
+                    group[t] = std::min(nTasks - 1, (2 * cumulative + weight[t]) * nTasks / (2 * total));
+                    cumulative += weight[t];
+                }
+
+                determineMasks(targets, group, order, mask);
+
+                size_t shared = 0;
+                for (const Node* node : order) {
+                    if (!isSingle(mask[node->getHandlerPosition()]))
+                        shared++;
+                }
+
+                if (shared * 10 > order.size() * 9) {
+                    // not worth it: most operations would be shared
+                    nTasks = 1;
+                    std::fill(group.begin(), group.end(), 0);
+                }
+            }
+
+            if (nTasks == 1) {
+                determineMasks(targets, group, order, mask);
+            }
+
+            /**
+             * assign operations to tasks
+             */
+            std::vector<Task> tasks(nTasks);
+            std::vector<Node*> nextTargets;
+            std::vector<size_t> inputMark(nNodes, NONE);
+
+            for (Node* node : order) {
+                uint64_t m = mask[node->getHandlerPosition()];
+                if (!isSingle(m))
+                    continue; // evaluated by a previous level
+
+                size_t g = groupIndex(m);
+                Task& task = tasks[g];
+                task.operations++;
+
+                for (const Argument<Base>& a : node->getArguments()) {
+                    Node* arg = a.getOperation();
+                    if (arg == nullptr || arg->getOperationType() == CGOpCode::Inv)
+                        continue;
+
+                    size_t pa = arg->getHandlerPosition();
+                    if (isSingle(mask[pa]))
+                        continue; // same task
+
+                    if (inputMark[pa] != g) {
+                        inputMark[pa] = g;
+                        task.inputs.push_back(arg);
+                    }
+                    if (nextMark[pa] != topDown.size()) {
+                        nextMark[pa] = topDown.size();
+                        nextTargets.push_back(arg);
+                    }
+                }
+            }
+
+            for (size_t t = 0; t < targets.size(); t++) {
+                Node* node = targets[t];
+                uint64_t m = mask[node->getHandlerPosition()];
+                if (isSingle(m)) {
+                    tasks[groupIndex(m)].outputs.push_back(node);
+                } else if (nextMark[node->getHandlerPosition()] != topDown.size()) {
+                    // the value is determined by a previous level
+                    nextMark[node->getHandlerPosition()] = topDown.size();
+                    nextTargets.push_back(node);
+                }
+            }
+
+            for (Node* node : order) {
+                mask[node->getHandlerPosition()] = 0;
+            }
+
+            tasks.erase(std::remove_if(tasks.begin(), tasks.end(), [](const Task& task) {
+                return task.operations == 0;
+            }), tasks.end());
+
+            topDown.push_back(std::move(tasks));
+            targets = std::move(nextTargets);
+        }
+
+        /**
+         * execution order and workspace positions
+         */
+        levels_.assign(std::make_move_iterator(topDown.rbegin()), std::make_move_iterator(topDown.rend()));
+
+        for (auto& level : levels_) {
+            for (Task& task : level) {
+                task.offset = workspaceSize_;
+                for (const Node* node : task.outputs) {
+                    position_[node->getHandlerPosition()] = workspaceSize_++;
+                }
+            }
+        }
+    }
+
+    /**
+     * Creates the operations of a task in another code handler.
+     *
+     * @param task The task
+     * @param indep The independent variables in the new code handler
+     * @param inputs The variables in the new code handler which hold the
+     *               values of the task inputs
+     * @return the task outputs in the new code handler
+     */
+    inline std::vector<CGB> createTaskOperations(const Task& task,
+                                                 const std::vector<CGB>& indep,
+                                                 const std::vector<CGB>& inputs) {
+        CPPADCG_ASSERT_KNOWN(inputs.size() == task.inputs.size(), "Invalid number of task inputs")
+
+        std::vector<CGB> outputs(task.outputs.size());
+        for (size_t i = 0; i < outputs.size(); i++) {
+            outputs[i] = handler_.createCG(Argument<Base>(*task.outputs[i]));
+        }
+
+        TaskEvaluator evaluator(handler_, task.inputs, inputs);
+        return evaluator.evaluate(indep, outputs);
+    }
+
+protected:
+
+    static inline bool isSingle(uint64_t m) {
+        return m != 0 && (m & (m - 1)) == 0;
+    }
+
+    static inline size_t groupIndex(uint64_t m) {
+        size_t g = 0;
+        while ((m & 1) == 0) {
+            m >>= 1;
+            g++;
+        }
+        return g;
+    }
+
+    /**
+     * Adds the operations (not yet visited) required by a node in a
+     * topological order (arguments first).
+     */
+    inline void addCone(Node& root,
+                        std::vector<size_t>& visited,
+                        size_t visitId,
+                        std::vector<Node*>& order) const {
+        if (visited[root.getHandlerPosition()] == visitId)
+            return;
+
+        // depth-first search without recursion (graphs can be very deep)
+        std::vector<std::pair<Node*, size_t> > stack;
+        stack.emplace_back(&root, 0);
+        visited[root.getHandlerPosition()] = visitId;
+
+        while (!stack.empty()) {
+            Node* node = stack.back().first;
+            size_t& a = stack.back().second;
+            const std::vector<Argument<Base> >& args = node->getArguments();
+
+            Node* next = nullptr;
+            for (; a < args.size(); a++) {
+                Node* arg = args[a].getOperation();
+                if (arg != nullptr && arg->getOperationType() != CGOpCode::Inv &&
+                    visited[arg->getHandlerPosition()] != visitId) {
+                    next = arg;
+                    break;
+                }
+            }
+
+            if (next != nullptr) {
+                CGOpCode op = next->getOperationType();
+                if (op == CGOpCode::LoopEnd || op == CGOpCode::LoopIndexedDep || op == CGOpCode::LoopIndexedIndep ||
+                    op == CGOpCode::LoopIndexedTmp || op == CGOpCode::Index || op == CGOpCode::IndexAssign) {
+                    throw CGException("Unable to determine tasks for operation graphs with loops");
+                }
+                visited[next->getHandlerPosition()] = visitId;
+                stack.emplace_back(next, 0);
+            } else {
+                order.push_back(node);
+                stack.pop_back();
+            }
+        }
+    }
+
+    /**
+     * Determines the groups which use each operation (one bit per group).
+     */
+    inline void determineMasks(const std::vector<Node*>& targets,
+                               const std::vector<size_t>& group,
+                               const std::vector<Node*>& order,
+                               std::vector<uint64_t>& mask) const {
+        for (const Node* node : order) {
+            mask[node->getHandlerPosition()] = 0;
+        }
+
+        for (size_t t = 0; t < targets.size(); t++) {
+            mask[targets[t]->getHandlerPosition()] |= uint64_t(1) << group[t];
+        }
+
+        // users are always processed before their arguments
+        for (auto it = order.rbegin(); it != order.rend(); ++it) {
+            uint64_t m = mask[(*it)->getHandlerPosition()];
+            for (const Argument<Base>& a : (*it)->getArguments()) {
+                const Node* arg = a.getOperation();
+                if (arg != nullptr && arg->getOperationType() != CGOpCode::Inv)
+                    mask[arg->getHandlerPosition()] |= m;
+            }
+        }
+    }
+
+    /**
+     * Evaluates the operations of a task using new variables for the values
+     * determined by other tasks.
+     */
+    class TaskEvaluator : public EvaluatorCG<Base, Base, TaskEvaluator> {
+        friend EvaluatorBase<Base, Base, CGB, TaskEvaluator>;
+        friend EvaluatorOperations<Base, Base, CGB, TaskEvaluator>;
+        friend EvaluatorCG<Base, Base, TaskEvaluator>;
+    protected:
+        using Super = EvaluatorCG<Base, Base, TaskEvaluator>;
+    protected:
+        const std::vector<Node*>& inputNodes_;
+        const std::vector<CGB>& inputs_;
+    public:
+
+        inline TaskEvaluator(CodeHandler<Base>& handler,
+                             const std::vector<Node*>& inputNodes,
+                             const std::vector<CGB>& inputs) :
+            Super(handler),
+            inputNodes_(inputNodes),
+            inputs_(inputs) {
+        }
+
+    protected:
+
+        /**
+         * @note overrides the default prepareNewEvaluation() even though
+         *       this method is not virtual (hides a method in
+         *       EvaluatorBase)
+         */
+        inline void prepareNewEvaluation() {
+            Super::prepareNewEvaluation();
+
+            for (size_t i = 0; i < inputNodes_.size(); i++) {
+                this->evals_[*inputNodes_[i]].reset(new CGB(inputs_[i]));
+            }
+        }
+    };
+};
+
+template<class Base>
+const size_t TaskGraph<Base>::NONE = (std::numeric_limits<size_t>::max)();
+
+template<class Base>
+const size_t TaskGraph<Base>::MAX_TASKS;
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
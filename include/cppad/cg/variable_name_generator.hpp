@@ -125,6 +125,31 @@ public:
     virtual std::string generateTemporary(const OperationNode<Base>& variable,
                                           size_t id) = 0;
 
+    /**
+     * Whether or not the names of temporary variables should be formatted
+     * directly into the source code using appendTemporary() instead of
+     * being created and saved in each operation node.
+     * The name of a temporary variable must then depend only on its ID.
+     */
+    virtual bool isCompactTemporaryNames() const {
+        return false;
+    }
+
+    /**
+     * Appends the name of a temporary variable to a string.
+     * It must produce the same text as generateTemporary().
+     *
+     * @param out the string where the name is appended to
+     * @param variable the node representing the temporary variable
+     * @param id an ID assigned by the CodeHandler to the operation node
+     *           (potentially not unique)
+     */
+    virtual void appendTemporary(std::string& out,
+                                 const OperationNode<Base>& variable,
+                                 size_t id) {
+        out += generateTemporary(variable, id);
+    }
+
     /**
      * Creates a name for a temporary dense array variable.
      * 
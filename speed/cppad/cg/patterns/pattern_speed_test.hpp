@@ -81,6 +81,9 @@ public:
     bool cppADCG;
     bool cppADCGLoops;
     bool cppADCGLoopsLlvm;
+    bool scheduleOperations;
+    bool localTemporaries;
+    bool vectorizationHints;
 protected:
     std::string libName_;
     bool testJacobian_;
@@ -119,6 +122,9 @@ public:
         cppADCG(true),
         cppADCGLoops(true),
         cppADCGLoopsLlvm(true),
+        scheduleOperations(false),
+        localTemporaries(false),
+        vectorizationHints(false),
         libName_(libName),
         testJacobian_(true),
         testHessian_(true),
@@ -566,6 +572,9 @@ protected:
         modelSourceGen_->setCreateReverseTwo(reverseTwo);
         modelSourceGen_->setRelatedDependents(relatedDepCandidates);
         modelSourceGen_->setTypicalIndependentValues(xTypical);
+        modelSourceGen_->setScheduleOperations(scheduleOperations);
+        modelSourceGen_->setLocalTemporaries(localTemporaries);
+        modelSourceGen_->setVectorizationHints(vectorizationHints);
 
         if (!customJacSparsity_.empty())
             modelSourceGen_->setCustomSparseJacobianElements(customJacSparsity_);
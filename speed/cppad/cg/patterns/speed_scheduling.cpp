@@ -0,0 +1,95 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Ciengis
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+#include "pattern_speed_test.hpp"
+#include "../../../../test/cppad/cg/models/plug_flow.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+using namespace std;
+
+using Base = double;
+using CGD = CppAD::cg::CG<Base>;
+
+/**
+ * Compares the evaluation time of the generated source code with and
+ * without the scheduling of operations and local temporary variables.
+ */
+class PlugFlowSchedulingSpeedTest : public PatternSpeedTest {
+public:
+
+    inline PlugFlowSchedulingSpeedTest(bool verbose = false) :
+        PatternSpeedTest("plugflow", verbose) {
+        preparation = false;
+    }
+
+    virtual std::vector<AD<CGD> > modelCppADCG(const std::vector<AD<CGD> >& x, size_t repeat) {
+        PlugFlowModel<CGD> m;
+        return m.model2(x, repeat);
+    }
+
+    virtual std::vector<AD<Base> > modelCppAD(const std::vector<AD<Base> >& x, size_t repeat) {
+        PlugFlowModel<Base> m;
+        return m.model2(x, repeat);
+    }
+
+    inline void measureScheduling(size_t repeat,
+                                  const std::vector<Base>& x) {
+        std::cout << libName_ << "\n";
+        std::cout << "n=" << repeat << "\n";
+        std::cerr << libName_ << "\n";
+        std::cerr << "n=" << repeat << "\n";
+
+        measureScheduling(repeat, x, false, false);
+        measureScheduling(repeat, x, true, false);
+        measureScheduling(repeat, x, true, true);
+    }
+
+private:
+
+    inline void measureScheduling(size_t repeat,
+                                  const std::vector<Base>& x,
+                                  bool schedule,
+                                  bool local) {
+        std::string head = std::string("\n") +
+                "schedule operations: " + (schedule ? "yes" : "no") +
+                ", local temporaries: " + (local ? "yes" : "no") + "\n";
+        std::cout << head;
+        std::cerr << head;
+
+        scheduleOperations = schedule;
+        localTemporaries = local;
+
+        // the previous library must be unloaded since the new one uses the same file name
+        model_.reset();
+        dynamicLib_.reset();
+
+        measureSpeedCppADCG(repeat, x);
+    }
+};
+
+int main(int argc, char **argv) {
+    size_t nEles = PatternSpeedTest::parseProgramArguments(1, argc, argv, 10);
+
+    std::vector<Base> x = PlugFlowModel<Base>::getTypicalValues(nEles);
+
+    std::vector<std::string> flags;
+    flags.push_back("-O2");
+
+    PlugFlowSchedulingSpeedTest speed;
+    speed.setNumberOfExecutions(100);
+    speed.setCompileFlags(flags);
+    speed.measureScheduling(nEles, x);
+}
@@ -0,0 +1,497 @@
+#ifndef CPPAD_CG_COMPILER_FLAG_TUNER_INCLUDED
+#define CPPAD_CG_COMPILER_FLAG_TUNER_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Ciengis
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+#include "runtime_benchmark.hpp"
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * The options used to generate and compile a model library
+ */
+struct CompilerFlagConfiguration {
+    std::vector<std::string> compileFlags;
+    /// maximum number of assignments per generated function (0 for the default)
+    size_t maxAssignPerFunc;
+    bool functionGraphPartitioning;
+
+    inline CompilerFlagConfiguration() :
+        maxAssignPerFunc(0),
+        functionGraphPartitioning(false) {
+    }
+
+    inline std::string getCompileFlagsString() const {
+        std::string s;
+        for (const std::string& f : compileFlags) {
+            if (!s.empty())
+                s += " ";
+            s += f;
+        }
+        return s;
+    }
+
+    inline std::string toString() const {
+        return "'" + getCompileFlagsString() + "' max assignments: " + std::to_string(maxAssignPerFunc) +
+               (functionGraphPartitioning ? " partitioned" : "");
+    }
+};
+
+/**
+ * The outcome of the evaluation of a configuration
+ */
+struct CompilerFlagTrial {
+    CompilerFlagConfiguration config;
+    /// time to generate and compile the library (in seconds)
+    double buildTime;
+    /// sum of the median execution times of the selected functions (NaN if rejected)
+    double score;
+    /// the reason why the configuration was rejected
+    std::string error;
+
+    inline CompilerFlagTrial() :
+        buildTime(0),
+        score(std::numeric_limits<double>::quiet_NaN()) {
+    }
+
+    inline bool isValid() const {
+        return error.empty();
+    }
+};
+
+/**
+ * Searches the compiler flags and the function splitting size which
+ * minimize the execution time of selected functions of a model.
+ *
+ * The search space is defined by groups of alternative flags (e.g.
+ * optimization levels, floating-point options, unrolling) and by the
+ * maximum number of assignments per generated function.
+ * A coordinate search is used: starting from the first alternative of
+ * each group, one group at a time is changed while the others are kept,
+ * and the search is repeated while the score improves.
+ * The search stops once the accumulated library build time exceeds the
+ * budget.
+ * Configurations whose results differ from the initial configuration
+ * (e.g. due to unsafe floating-point optimizations) are rejected.
+ *
+ * @author Joao Leal
+ */
+class CompilerFlagTuner : public RuntimeBenchmark {
+protected:
+    /// alternatives of each group of flags (the first is the initial choice)
+    std::vector<std::vector<std::vector<std::string> > > flagGroups_;
+    /// candidates for the maximum number of assignments per function
+    std::vector<size_t> maxAssignPerFuncs_;
+    /// candidates for the function graph partitioning option
+    std::vector<bool> partitioning_;
+    /// maximum accumulated build time (in seconds)
+    double budget_;
+    /// accepted relative difference of the results
+    double tolerance_;
+    /// minimum relative score improvement to accept a new configuration
+    double minImprovement_;
+    double buildTime_;
+    std::vector<Base> reference_;
+    std::vector<CompilerFlagTrial> trials_;
+public:
+
+    inline CompilerFlagTuner() :
+        flagGroups_{
+            {{"-O2"}, {"-O1"}, {"-O3"}},
+            {{}, {"-fno-math-errno"}, {"-fno-math-errno", "-fno-trapping-math"}, {"-ffast-math"}},
+            {{}, {"-march=native"}},
+            {{}, {"-funroll-loops"}}
+        },
+        maxAssignPerFuncs_{0, 10000, 2000, 500},
+        partitioning_{false, true},
+        budget_(600),
+        tolerance_(1e-8),
+        minImprovement_(0.02),
+        buildTime_(0) {
+        functions_ = {Function::SPARSE_JACOBIAN};
+        samples_ = 50;
+    }
+
+    inline void clearFlagGroups() {
+        flagGroups_.clear();
+    }
+
+    /**
+     * Adds a group of mutually exclusive flag sets.
+     *
+     * @param alternatives the flag sets where the first one is used by
+     *                     the initial configuration (an empty set means
+     *                     that no flag of the group is used)
+     */
+    inline void addFlagGroup(const std::vector<std::vector<std::string> >& alternatives) {
+        CPPADCG_ASSERT_KNOWN(!alternatives.empty(), "A flag group requires at least one alternative")
+        flagGroups_.push_back(alternatives);
+    }
+
+    /**
+     * Defines the candidates for the maximum number of assignments per
+     * generated function (0 for the default of ModelCSourceGen).
+     * The first value is used by the initial configuration.
+     */
+    inline void setMaxAssignmentsPerFuncCandidates(const std::vector<size_t>& candidates) {
+        CPPADCG_ASSERT_KNOWN(!candidates.empty(), "At least one candidate is required")
+        maxAssignPerFuncs_ = candidates;
+    }
+
+    /**
+     * Defines the candidates for the function graph partitioning option
+     * (see ModelCSourceGen::setFunctionGraphPartitioning()).
+     */
+    inline void setFunctionGraphPartitioningCandidates(const std::vector<bool>& candidates) {
+        CPPADCG_ASSERT_KNOWN(!candidates.empty(), "At least one candidate is required")
+        partitioning_ = candidates;
+    }
+
+    /**
+     * Defines the maximum accumulated time used to build libraries.
+     * The initial configuration is always evaluated.
+     *
+     * @param seconds the build time budget
+     */
+    inline void setBuildTimeBudget(double seconds) {
+        budget_ = seconds;
+    }
+
+    /**
+     * Defines the accepted relative difference between the results of a
+     * configuration and the results of the initial configuration.
+     */
+    inline void setTolerance(double tolerance) {
+        tolerance_ = tolerance;
+    }
+
+    /**
+     * Defines the minimum relative reduction of the score required to
+     * replace the best configuration (to avoid following measurement
+     * noise).
+     */
+    inline void setMinimumImprovement(double minImprovement) {
+        minImprovement_ = minImprovement;
+    }
+
+    /**
+     * @return all the evaluated configurations
+     */
+    inline const std::vector<CompilerFlagTrial>& getTrials() const {
+        return trials_;
+    }
+
+    /**
+     * @return the accumulated time used to build libraries (in seconds)
+     */
+    inline double getBuildTime() const {
+        return buildTime_;
+    }
+
+    /**
+     * Searches the best configuration for a model.
+     *
+     * @param model the model
+     * @param size the model size
+     * @param backend the compiler (GCC or Clang)
+     * @param loops whether or not to generate the model with loops
+     * @param threading the threading mode
+     * @return the best configuration found
+     * @throws CGException if the initial configuration cannot be evaluated
+     */
+    inline CompilerFlagTrial tune(const RuntimeBenchmarkModel& model,
+                                  size_t size,
+                                  Backend backend = Backend::GCC,
+                                  bool loops = false,
+                                  MultiThreadingType threading = MultiThreadingType::NONE) {
+        if (backend == Backend::LLVM) {
+            throw CGException("Compiler flags cannot be tuned for the LLVM back end");
+        }
+
+        trials_.clear();
+        reference_.clear();
+        buildTime_ = 0;
+
+        std::vector<Base> x = model.getIndependentValues(size);
+        std::vector<std::set<size_t> > related;
+        if (loops)
+            related = model.getRelatedDependents(size);
+
+        std::unique_ptr<ADFun<CGD> > fun(tape(model, x, size));
+
+        std::string name = "tuning_" + model.getName() + std::to_string(size) + (related.empty() ? "" : "Loops");
+
+        /**
+         * each dimension is a flag group, followed by the function size
+         * and the partitioning option
+         */
+        std::vector<size_t> nChoices;
+        for (const auto& group : flagGroups_)
+            nChoices.push_back(group.size());
+        nChoices.push_back(maxAssignPerFuncs_.size());
+        nChoices.push_back(partitioning_.size());
+
+        std::map<std::vector<size_t>, size_t> evaluated; // choices -> trial index
+
+        auto evaluateChoices = [&](const std::vector<size_t>& choices) -> const CompilerFlagTrial& {
+            auto it = evaluated.find(choices);
+            if (it != evaluated.end())
+                return trials_[it->second];
+
+            evaluated[choices] = trials_.size();
+            trials_.push_back(evaluate(*fun, x, related, backend, threading, name, toConfiguration(choices)));
+            return trials_.back();
+        };
+
+        std::vector<size_t> best(nChoices.size(), 0);
+        const CompilerFlagTrial& initial = evaluateChoices(best);
+        if (!initial.isValid()) {
+            throw CGException("Failed to evaluate the initial configuration ", initial.config.toString(), ": ",
+                              initial.error);
+        }
+        double bestScore = initial.score;
+        size_t bestTrial = 0;
+
+        bool improved = true;
+        while (improved && buildTime_ < budget_) {
+            improved = false;
+
+            for (size_t d = 0; d < nChoices.size() && buildTime_ < budget_; ++d) {
+                for (size_t c = 0; c < nChoices[d] && buildTime_ < budget_; ++c) {
+                    if (c == best[d])
+                        continue;
+
+                    std::vector<size_t> candidate = best;
+                    candidate[d] = c;
+                    if (evaluated.find(candidate) != evaluated.end())
+                        continue;
+
+                    const CompilerFlagTrial& trial = evaluateChoices(candidate);
+                    if (trial.isValid() && trial.score < bestScore * (1 - minImprovement_)) {
+                        bestScore = trial.score;
+                        bestTrial = trials_.size() - 1;
+                        best = candidate;
+                        improved = true;
+                    }
+                }
+            }
+        }
+
+        if (verbose_) {
+            std::cout << "best configuration: " << trials_[bestTrial].config.toString()
+                      << " (" << trials_[bestTrial].score << " s)" << std::endl;
+        }
+
+        return trials_[bestTrial];
+    }
+
+    /**
+     * Saves the evaluated configurations in the CSV format.
+     */
+    inline void saveTrialsCsv(std::ostream& out) const {
+        out << "compile_flags,max_assignments_per_function,function_graph_partitioning,build_time,score,error\n";
+        out << std::setprecision(9);
+        for (const CompilerFlagTrial& t : trials_) {
+            out << t.config.getCompileFlagsString() << ","
+                << t.config.maxAssignPerFunc << ","
+                << (t.config.functionGraphPartitioning ? 1 : 0) << ","
+                << t.buildTime << ","
+                << t.score << ","
+                << t.error << "\n";
+        }
+        out.flush();
+    }
+
+protected:
+
+    inline CompilerFlagConfiguration toConfiguration(const std::vector<size_t>& choices) const {
+        CompilerFlagConfiguration config;
+        for (size_t g = 0; g < flagGroups_.size(); ++g) {
+            const std::vector<std::string>& flags = flagGroups_[g][choices[g]];
+            config.compileFlags.insert(config.compileFlags.end(), flags.begin(), flags.end());
+        }
+        config.maxAssignPerFunc = maxAssignPerFuncs_[choices[flagGroups_.size()]];
+        config.functionGraphPartitioning = partitioning_[choices[flagGroups_.size() + 1]];
+        return config;
+    }
+
+    inline CompilerFlagTrial evaluate(ADFun<CGD>& fun,
+                                      const std::vector<Base>& x,
+                                      const std::vector<std::set<size_t> >& related,
+                                      Backend backend,
+                                      MultiThreadingType threading,
+                                      const std::string& name,
+                                      const CompilerFlagConfiguration& config) {
+        using namespace std::chrono;
+
+        CompilerFlagTrial trial;
+        trial.config = config;
+
+        if (verbose_)
+            std::cout << "evaluating " << config.toString() << std::endl;
+
+        CompiledModel compiled;
+        auto t0 = steady_clock::now();
+        try {
+            compile(compiled, fun, x, related, backend, threading, name,
+                    config.compileFlags, config.maxAssignPerFunc, config.functionGraphPartitioning);
+        } catch (const std::exception& e) {
+            trial.error = std::string("build failed: ") + e.what();
+        }
+        trial.buildTime = duration<double>(steady_clock::now() - t0).count();
+        buildTime_ += trial.buildTime;
+
+        if (!trial.isValid())
+            return trial;
+
+        std::vector<Base> results = evaluateResults(*compiled.model, x);
+        if (reference_.empty()) {
+            reference_ = results;
+        } else if (!isEqual(results, reference_)) {
+            trial.error = "different results";
+            return trial;
+        }
+
+        trial.score = 0;
+        for (Function f : functions_) {
+            std::vector<double> times = measure(*compiled.model, x, f);
+            std::sort(times.begin(), times.end());
+            trial.score += percentile(times, 50);
+        }
+
+        if (verbose_)
+            std::cout << "  build: " << trial.buildTime << " s  score: " << trial.score << " s" << std::endl;
+
+        return trial;
+    }
+
+    /**
+     * Evaluates the selected functions once and collects their results.
+     */
+    inline std::vector<Base> evaluateResults(GenericModel<Base>& model,
+                                             const std::vector<Base>& x) const {
+        size_t n = model.Domain();
+        size_t m = model.Range();
+
+        std::vector<Base> results;
+        std::vector<Base> values;
+        std::vector<size_t> rows, cols;
+
+        for (Function f : functions_) {
+            switch (f) {
+                case Function::FORWARD_ZERO:
+                    values = model.ForwardZero(x);
+                    break;
+                case Function::SPARSE_JACOBIAN:
+                    model.SparseJacobian(x, values, rows, cols);
+                    break;
+                case Function::SPARSE_HESSIAN:
+                    model.SparseHessian(x, std::vector<Base>(m, 1.0), values, rows, cols);
+                    break;
+                default: {
+                    std::vector<Base> tx(2 * n), ty(2 * m), py(2 * m);
+                    for (size_t j = 0; j < n; j++)
+                        tx[j * 2] = x[j];
+                    tx[1] = 1.0;
+                    for (size_t i = 0; i < m; i++)
+                        py[i * 2 + 1] = 1.0;
+                    values.resize(2 * n);
+                    model.ReverseTwo(tx, ty, values, py);
+                    break;
+                }
+            }
+            results.insert(results.end(), values.begin(), values.end());
+        }
+
+        return results;
+    }
+
+    inline bool isEqual(const std::vector<Base>& a,
+                        const std::vector<Base>& b) const {
+        if (a.size() != b.size())
+            return false;
+
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (std::isnan(a[i]) != std::isnan(b[i]))
+                return false;
+            double scale = std::max(std::max(std::abs(a[i]), std::abs(b[i])), 1.0);
+            if (std::abs(a[i] - b[i]) > tolerance_ * scale)
+                return false;
+        }
+        return true;
+    }
+};
+
+/**
+ * Saves a configuration so that it can be used by later builds
+ * (see loadCompilerFlagConfiguration()).
+ */
+inline void saveCompilerFlagConfiguration(const CompilerFlagConfiguration& config,
+                                          std::ostream& out) {
+    out << "compile_flags=" << config.getCompileFlagsString() << "\n"
+        << "max_assignments_per_function=" << config.maxAssignPerFunc << "\n"
+        << "function_graph_partitioning=" << (config.functionGraphPartitioning ? 1 : 0) << "\n";
+    out.flush();
+}
+
+/**
+ * Reads a configuration saved with saveCompilerFlagConfiguration().
+ *
+ * @throws CGException if the file cannot be read or has an unexpected format
+ */
+inline CompilerFlagConfiguration loadCompilerFlagConfiguration(const std::string& file) {
+    std::ifstream in(file.c_str());
+    if (!in.is_open()) {
+        throw CGException("Failed to open compiler configuration file '", file, "'");
+    }
+
+    CompilerFlagConfiguration config;
+    std::string line;
+    size_t lineNumber = 0;
+    while (std::getline(in, line)) {
+        lineNumber++;
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        size_t p = line.find('=');
+        if (p == std::string::npos) {
+            throw CGException("Invalid compiler configuration in '", file, "' at line ", lineNumber);
+        }
+        std::string key = line.substr(0, p);
+        std::string value = line.substr(p + 1);
+
+        if (key == "compile_flags") {
+            config.compileFlags.clear();
+            std::istringstream ss(value);
+            std::string flag;
+            while (ss >> flag)
+                config.compileFlags.push_back(flag);
+        } else if (key == "max_assignments_per_function") {
+            config.maxAssignPerFunc = std::stoul(value);
+        } else if (key == "function_graph_partitioning") {
+            config.functionGraphPartitioning = value == "1";
+        } else {
+            throw CGException("Unknown key '", key, "' in compiler configuration '", file, "' at line ", lineNumber);
+        }
+    }
+
+    return config;
+}
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -0,0 +1,466 @@
+#ifndef CPPAD_CG_RUNTIME_BENCHMARK_INCLUDED
+#define CPPAD_CG_RUNTIME_BENCHMARK_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Ciengis
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+#include <functional>
+#include <cppad/cg/cppadcg.hpp>
+#ifdef CPPADCG_BENCHMARK_LLVM
+#include <cppad/cg/model/llvm/llvm.hpp>
+#endif
+#include "runtime_statistics.hpp"
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * A model used by the runtime benchmark
+ */
+class RuntimeBenchmarkModel {
+public:
+    using Base = double;
+    using CGD = CG<Base>;
+    using ADCGD = AD<CGD>;
+
+    /**
+     * @return the name of the model/sparsity structure
+     */
+    virtual std::string getName() const = 0;
+
+    /**
+     * @param size the model size
+     * @return the values of the independent variables used to tape and to
+     *         evaluate the model
+     */
+    virtual std::vector<Base> getIndependentValues(size_t size) const = 0;
+
+    /**
+     * @param size the model size
+     * @return related dependent candidates for the loop detection (empty
+     *         if the model cannot be created with loops)
+     */
+    virtual std::vector<std::set<size_t> > getRelatedDependents(size_t size) const = 0;
+
+    virtual std::vector<ADCGD> evaluate(const std::vector<ADCGD>& x,
+                                        size_t size) const = 0;
+
+    inline virtual ~RuntimeBenchmarkModel() = default;
+};
+
+/**
+ * Measures the execution time of the functions of generated models for a
+ * matrix of models, model sizes, back ends, with and without loops, and
+ * threading modes.
+ *
+ * @author Joao Leal
+ */
+class RuntimeBenchmark {
+public:
+    using Base = double;
+    using CGD = CG<Base>;
+    using ADCGD = AD<CGD>;
+
+    enum class Backend {
+        GCC, // dynamic library compiled with GCC
+        CLANG, // dynamic library compiled with Clang
+        LLVM // JIT compiled with LLVM
+    };
+
+    enum class Function {
+        FORWARD_ZERO,
+        SPARSE_JACOBIAN,
+        SPARSE_HESSIAN,
+        REVERSE_TWO
+    };
+protected:
+    std::vector<RuntimeBenchmarkModel*> models_;
+    std::vector<size_t> sizes_;
+    std::vector<Backend> backends_;
+    std::vector<bool> loops_;
+    std::vector<MultiThreadingType> threading_;
+    std::vector<Function> functions_;
+    std::vector<std::string> compileFlags_;
+    /// maximum number of assignments per generated function (0 for the default)
+    size_t maxAssignPerFunc_;
+    bool functionGraphPartitioning_;
+    std::string gccPath_;
+    std::string clangPath_;
+    /// number of measured executions
+    size_t samples_;
+    /// number of executions before the measurements
+    size_t warmup_;
+    bool verbose_;
+    std::vector<RuntimeBenchmarkResult> results_;
+public:
+
+    inline RuntimeBenchmark() :
+        sizes_{10, 50},
+        backends_{Backend::GCC},
+        loops_{false, true},
+        threading_{MultiThreadingType::NONE},
+        functions_{Function::FORWARD_ZERO, Function::SPARSE_JACOBIAN, Function::SPARSE_HESSIAN, Function::REVERSE_TWO},
+        compileFlags_{"-O2"},
+        maxAssignPerFunc_(0),
+        functionGraphPartitioning_(false),
+        gccPath_("/usr/bin/gcc"),
+        clangPath_("/usr/bin/clang"),
+        samples_(100),
+        warmup_(5),
+        verbose_(false) {
+    }
+
+    inline void addModel(RuntimeBenchmarkModel& model) {
+        models_.push_back(&model);
+    }
+
+    inline void setSizes(const std::vector<size_t>& sizes) {
+        sizes_ = sizes;
+    }
+
+    inline void setBackends(const std::vector<Backend>& backends) {
+        backends_ = backends;
+    }
+
+    /**
+     * Defines whether models are created without loops (false) and/or with
+     * loops (true).
+     */
+    inline void setLoops(const std::vector<bool>& loops) {
+        loops_ = loops;
+    }
+
+    /**
+     * Defines the threading modes used to evaluate the sparse Jacobian and
+     * Hessian.
+     * OpenMP is rejected since it cannot be used by dynamically loaded
+     * model libraries.
+     */
+    inline void setThreading(const std::vector<MultiThreadingType>& threading) {
+        for (MultiThreadingType t : threading) {
+            if (t == MultiThreadingType::OPENMP)
+                throw CGException("OpenMP is not supported by dynamically loaded model libraries");
+        }
+        threading_ = threading;
+    }
+
+    inline void setFunctions(const std::vector<Function>& functions) {
+        functions_ = functions;
+    }
+
+    inline void setCompileFlags(const std::vector<std::string>& flags) {
+        compileFlags_ = flags;
+    }
+
+    /**
+     * Defines the maximum number of assignments per generated function
+     * (0 to use the default of ModelCSourceGen).
+     */
+    inline void setMaxAssignmentsPerFunc(size_t maxAssignPerFunc) {
+        maxAssignPerFunc_ = maxAssignPerFunc;
+    }
+
+    inline void setFunctionGraphPartitioning(bool partitioning) {
+        functionGraphPartitioning_ = partitioning;
+    }
+
+    inline void setGccPath(const std::string& path) {
+        gccPath_ = path;
+    }
+
+    inline void setClangPath(const std::string& path) {
+        clangPath_ = path;
+    }
+
+    inline void setSamples(size_t samples) {
+        samples_ = samples;
+    }
+
+    inline void setWarmup(size_t warmup) {
+        warmup_ = warmup;
+    }
+
+    inline void setVerbose(bool verbose) {
+        verbose_ = verbose;
+    }
+
+    inline const std::vector<RuntimeBenchmarkResult>& getResults() const {
+        return results_;
+    }
+
+    /**
+     * Runs all the cases of the benchmark matrix.
+     * Cases which cannot be created (e.g. loops for a model without related
+     * dependents) are skipped.
+     */
+    inline void run() {
+        for (RuntimeBenchmarkModel* model : models_) {
+            for (size_t size : sizes_) {
+                std::vector<Base> x = model->getIndependentValues(size);
+                std::vector<std::set<size_t> > related = model->getRelatedDependents(size);
+
+                std::unique_ptr<ADFun<CGD> > fun(tape(*model, x, size));
+
+                for (bool loops : loops_) {
+                    if (loops && related.empty())
+                        continue;
+
+                    for (Backend backend : backends_) {
+                        for (MultiThreadingType threading : threading_) {
+                            if (backend == Backend::LLVM && threading != MultiThreadingType::NONE)
+                                continue;
+
+                            RuntimeBenchmarkKey key;
+                            key.model = model->getName();
+                            key.size = size;
+                            key.backend = toString(backend);
+                            key.loops = loops;
+                            key.threading = toString(threading);
+
+                            if (verbose_)
+                                std::cout << key.model << "/" << size << "/" << key.backend << "/"
+                                          << (loops ? "loops" : "noloops") << "/" << key.threading << std::endl;
+
+                            runCase(*fun, x, loops ? related : std::vector<std::set<size_t> >(),
+                                    backend, threading, key);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    inline void printResults(std::ostream& out) const {
+        out << std::setw(60) << std::left << "case" << std::right
+            << std::setw(12) << "median" << std::setw(12) << "p90" << std::setw(12) << "p99" << "\n";
+        for (const RuntimeBenchmarkResult& r : results_) {
+            out << std::setw(60) << std::left << r.key.toString() << std::right
+                << std::setw(12) << r.median << std::setw(12) << r.p90 << std::setw(12) << r.p99 << "\n";
+        }
+        out.flush();
+    }
+
+    static inline std::string toString(Backend backend) {
+        switch (backend) {
+            case Backend::GCC:
+                return "gcc";
+            case Backend::CLANG:
+                return "clang";
+            default:
+                return "llvm";
+        }
+    }
+
+    static inline std::string toString(MultiThreadingType threading) {
+        switch (threading) {
+            case MultiThreadingType::NONE:
+                return "none";
+            case MultiThreadingType::OPENMP:
+                return "openmp";
+            default:
+                return "pthreads";
+        }
+    }
+
+    static inline std::string toString(Function function) {
+        switch (function) {
+            case Function::FORWARD_ZERO:
+                return "forward_zero";
+            case Function::SPARSE_JACOBIAN:
+                return "sparse_jacobian";
+            case Function::SPARSE_HESSIAN:
+                return "sparse_hessian";
+            default:
+                return "reverse_two";
+        }
+    }
+
+protected:
+
+    static inline ADFun<CGD>* tape(const RuntimeBenchmarkModel& model,
+                                   const std::vector<Base>& xb,
+                                   size_t size) {
+        std::vector<ADCGD> x(xb.size());
+        for (size_t j = 0; j < xb.size(); j++)
+            x[j] = xb[j];
+        CppAD::Independent(x);
+
+        std::vector<ADCGD> y = model.evaluate(x, size);
+
+        std::unique_ptr<ADFun<CGD> > fun(new ADFun<CGD>());
+        fun->Dependent(y);
+        return fun.release();
+    }
+
+    inline bool isRequested(Function f) const {
+        return std::find(functions_.begin(), functions_.end(), f) != functions_.end();
+    }
+
+    /**
+     * A compiled model and the library which contains it
+     */
+    struct CompiledModel {
+        std::unique_ptr<DynamicLib<Base> > dynamicLib;
+#ifdef CPPADCG_BENCHMARK_LLVM
+        std::unique_ptr<LlvmModelLibrary<Base> > llvmLib;
+#endif
+        std::unique_ptr<GenericModel<Base> > model; // deleted before the libraries
+    };
+
+    inline void runCase(ADFun<CGD>& fun,
+                        const std::vector<Base>& x,
+                        const std::vector<std::set<size_t> >& related,
+                        Backend backend,
+                        MultiThreadingType threading,
+                        const RuntimeBenchmarkKey& caseKey) {
+        std::string name = "runtime_" + caseKey.model + std::to_string(caseKey.size) + (related.empty() ? "" : "Loops");
+
+        CompiledModel compiled;
+        if (!compile(compiled, fun, x, related, backend, threading, name,
+                     compileFlags_, maxAssignPerFunc_, functionGraphPartitioning_)) {
+            return; // not available
+        }
+
+        for (Function f : functions_) {
+            RuntimeBenchmarkKey key = caseKey;
+            key.function = toString(f);
+            results_.push_back(computeRuntimeStatistics(key, measure(*compiled.model, x, f)));
+        }
+    }
+
+    /**
+     * Generates and compiles a model.
+     *
+     * @return false if the back end is not available
+     */
+    inline bool compile(CompiledModel& compiled,
+                        ADFun<CGD>& fun,
+                        const std::vector<Base>& x,
+                        const std::vector<std::set<size_t> >& related,
+                        Backend backend,
+                        MultiThreadingType threading,
+                        const std::string& name,
+                        const std::vector<std::string>& compileFlags,
+                        size_t maxAssignPerFunc,
+                        bool functionGraphPartitioning) const {
+        ModelCSourceGen<Base> modelGen(fun, name);
+        modelGen.setCreateForwardZero(true);
+        modelGen.setCreateSparseJacobian(isRequested(Function::SPARSE_JACOBIAN));
+        modelGen.setCreateSparseHessian(isRequested(Function::SPARSE_HESSIAN));
+        modelGen.setCreateReverseTwo(isRequested(Function::REVERSE_TWO));
+        modelGen.setRelatedDependents(related);
+        modelGen.setTypicalIndependentValues(x);
+        modelGen.setMultiThreading(threading != MultiThreadingType::NONE);
+        if (maxAssignPerFunc > 0)
+            modelGen.setMaxAssignmentsPerFunc(maxAssignPerFunc);
+        modelGen.setFunctionGraphPartitioning(functionGraphPartitioning);
+
+        ModelLibraryCSourceGen<Base> libGen(modelGen);
+        libGen.setMultiThreading(threading);
+        libGen.setVerbose(verbose_);
+
+        if (backend == Backend::LLVM) {
+#ifdef CPPADCG_BENCHMARK_LLVM
+            compiled.llvmLib = LlvmModelLibraryProcessor<Base>::create(libGen);
+            compiled.model = compiled.llvmLib->model(name);
+#else
+            return false;
+#endif
+        } else {
+            std::string libName = "cppadcg_runtime_" + toString(backend);
+            DynamicModelLibraryProcessor<Base> p(libGen, libName);
+            if (backend == Backend::GCC) {
+                GccCompiler<Base> compiler(gccPath_);
+                if (!compileFlags.empty())
+                    compiler.setCompileFlags(compileFlags);
+                compiled.dynamicLib = p.createDynamicLibrary(compiler);
+            } else {
+                ClangCompiler<Base> compiler(clangPath_);
+                if (!compileFlags.empty())
+                    compiler.setCompileFlags(compileFlags);
+                compiled.dynamicLib = p.createDynamicLibrary(compiler);
+            }
+            compiled.model = compiled.dynamicLib->model(name);
+        }
+
+        if (compiled.model == nullptr) {
+            throw CGException("Failed to load the benchmark model '", name, "'");
+        }
+
+        return true;
+    }
+
+    inline std::vector<double> measure(GenericModel<Base>& model,
+                                       const std::vector<Base>& x,
+                                       Function f) const {
+        using namespace std::chrono;
+
+        size_t n = model.Domain();
+        size_t m = model.Range();
+
+        std::function<void()> eval;
+
+        std::vector<Base> y(m);
+        std::vector<Base> w(m, 1.0);
+        std::vector<Base> values;
+        std::vector<size_t> rows, cols;
+        std::vector<Base> tx(2 * n), ty(2 * m), px(2 * n), py(2 * m);
+
+        switch (f) {
+            case Function::FORWARD_ZERO:
+                eval = [&]() {
+                    model.ForwardZero(x, y);
+                };
+                break;
+            case Function::SPARSE_JACOBIAN:
+                eval = [&]() {
+                    model.SparseJacobian(x, values, rows, cols);
+                };
+                break;
+            case Function::SPARSE_HESSIAN:
+                eval = [&]() {
+                    model.SparseHessian(x, w, values, rows, cols);
+                };
+                break;
+            default:
+                // directional second-order derivatives along the first independent
+                for (size_t j = 0; j < n; j++)
+                    tx[j * 2] = x[j];
+                tx[1] = 1.0;
+                for (size_t i = 0; i < m; i++)
+                    py[i * 2 + 1] = 1.0; // py[i * 2] must be zero
+                eval = [&]() {
+                    model.ReverseTwo(tx, ty, px, py);
+                };
+                break;
+        }
+
+        for (size_t i = 0; i < warmup_; i++)
+            eval();
+
+        std::vector<double> times(samples_);
+        for (size_t i = 0; i < samples_; i++) {
+            auto t0 = steady_clock::now();
+            eval();
+            times[i] = duration<double>(steady_clock::now() - t0).count();
+        }
+
+        return times;
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef CPPAD_CG_RUNTIME_BENCHMARK_MODELS_INCLUDED
+#define CPPAD_CG_RUNTIME_BENCHMARK_MODELS_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Ciengis
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+#include "runtime_benchmark.hpp"
+#include "../../../../test/cppad/cg/models/plug_flow.hpp"
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * The plug flow reactor (a realistic sparsity structure with loops)
+ */
+class PlugFlowBenchmarkModel : public RuntimeBenchmarkModel {
+public:
+
+    std::string getName() const override {
+        return "plugflow";
+    }
+
+    std::vector<Base> getIndependentValues(size_t size) const override {
+        return PlugFlowModel<Base>::getTypicalValues(size);
+    }
+
+    std::vector<std::set<size_t> > getRelatedDependents(size_t size) const override {
+        return PlugFlowModel<Base>::getRelatedCandidates(size);
+    }
+
+    std::vector<ADCGD> evaluate(const std::vector<ADCGD>& x,
+                                size_t size) const override {
+        PlugFlowModel<CGD> m;
+        return m.model2(x, size);
+    }
+};
+
+/**
+ * A synthetic model where each equation depends on a band of variables:
+ *   y_i = x_i * sum_{k=0}^{bandwidth-1} sin(x_{(i+k) mod n})^2
+ * A bandwidth of 1 results in a diagonal Jacobian and a bandwidth equal to
+ * the model size results in dense Jacobian and Hessian.
+ */
+class BandedBenchmarkModel : public RuntimeBenchmarkModel {
+private:
+    std::string name_;
+    size_t bandwidth_; // zero means dense
+public:
+
+    inline BandedBenchmarkModel(std::string name,
+                                size_t bandwidth) :
+        name_(std::move(name)),
+        bandwidth_(bandwidth) {
+    }
+
+    std::string getName() const override {
+        return name_;
+    }
+
+    std::vector<Base> getIndependentValues(size_t size) const override {
+        std::vector<Base> x(size);
+        for (size_t j = 0; j < size; j++)
+            x[j] = 0.5 + 0.01 * j;
+        return x;
+    }
+
+    std::vector<std::set<size_t> > getRelatedDependents(size_t size) const override {
+        if (bandwidth_ == 0)
+            return std::vector<std::set<size_t> >(); // no repeated structure worth a loop
+
+        std::vector<std::set<size_t> > related(1);
+        for (size_t i = 0; i + bandwidth_ <= size; i++)
+            related[0].insert(i);
+        return related;
+    }
+
+    std::vector<ADCGD> evaluate(const std::vector<ADCGD>& x,
+                                size_t size) const override {
+        size_t bw = bandwidth_ == 0 ? size : std::min(bandwidth_, size);
+        std::vector<ADCGD> y(size);
+        for (size_t i = 0; i < size; i++) {
+            ADCGD sum = 0;
+            for (size_t k = 0; k < bw; k++) {
+                ADCGD s = sin(x[(i + k) % size]);
+                sum += s * s;
+            }
+            y[i] = x[i] * sum;
+        }
+        return y;
+    }
+};
+
+/**
+ * Splits a comma separated list of command line values
+ */
+inline std::vector<std::string> splitList(const std::string& s) {
+    std::vector<std::string> parts;
+    std::istringstream ss(s);
+    std::string p;
+    while (std::getline(ss, p, ','))
+        if (!p.empty())
+            parts.push_back(p);
+    return parts;
+}
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -0,0 +1,353 @@
+#ifndef CPPAD_CG_RUNTIME_STATISTICS_INCLUDED
+#define CPPAD_CG_RUNTIME_STATISTICS_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Ciengis
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Identifies a benchmark case (a single cell of the benchmark matrix)
+ */
+struct RuntimeBenchmarkKey {
+    std::string model;
+    size_t size;
+    std::string backend;
+    bool loops;
+    std::string threading;
+    std::string function;
+
+    inline RuntimeBenchmarkKey() :
+        size(0),
+        loops(false) {
+    }
+
+    inline std::string toString() const {
+        return model + "/" + std::to_string(size) + "/" + backend + "/" + (loops ? "loops" : "noloops") + "/" +
+               threading + "/" + function;
+    }
+
+    inline bool operator<(const RuntimeBenchmarkKey& other) const {
+        return toString() < other.toString();
+    }
+};
+
+/**
+ * Execution time statistics of a benchmark case (in seconds)
+ */
+struct RuntimeBenchmarkResult {
+    RuntimeBenchmarkKey key;
+    size_t samples;
+    double mean;
+    double stdDev;
+    double min;
+    double p25;
+    double median;
+    double p75;
+    double p90;
+    double p95;
+    double p99;
+    double max;
+
+    inline RuntimeBenchmarkResult() :
+        samples(0),
+        mean(std::numeric_limits<double>::quiet_NaN()),
+        stdDev(mean),
+        min(mean),
+        p25(mean),
+        median(mean),
+        p75(mean),
+        p90(mean),
+        p95(mean),
+        p99(mean),
+        max(mean) {
+    }
+};
+
+/**
+ * Determines a percentile using linear interpolation between the closest
+ * ranks.
+ *
+ * @param sorted the values sorted in ascending order
+ * @param p the percentile in [0, 100]
+ */
+inline double percentile(const std::vector<double>& sorted,
+                         double p) {
+    if (sorted.empty())
+        return std::numeric_limits<double>::quiet_NaN();
+
+    double rank = p / 100.0 * (sorted.size() - 1);
+    size_t low = size_t(std::floor(rank));
+    size_t high = std::min(low + 1, sorted.size() - 1);
+    double f = rank - low;
+    return sorted[low] + f * (sorted[high] - sorted[low]);
+}
+
+/**
+ * Computes the statistics of the execution times of a benchmark case.
+ *
+ * @param key the benchmark case
+ * @param times the execution times (in seconds)
+ */
+inline RuntimeBenchmarkResult computeRuntimeStatistics(const RuntimeBenchmarkKey& key,
+                                                       std::vector<double> times) {
+    RuntimeBenchmarkResult r;
+    r.key = key;
+    r.samples = times.size();
+    if (times.empty())
+        return r;
+
+    std::sort(times.begin(), times.end());
+
+    double sum = 0;
+    for (double t : times)
+        sum += t;
+    r.mean = sum / times.size();
+
+    double var = 0;
+    for (double t : times)
+        var += (t - r.mean) * (t - r.mean);
+    r.stdDev = std::sqrt(var / times.size());
+
+    r.min = times.front();
+    r.p25 = percentile(times, 25);
+    r.median = percentile(times, 50);
+    r.p75 = percentile(times, 75);
+    r.p90 = percentile(times, 90);
+    r.p95 = percentile(times, 95);
+    r.p99 = percentile(times, 99);
+    r.max = times.back();
+
+    return r;
+}
+
+/**
+ * Saves benchmark results in the CSV format (one line per benchmark case).
+ */
+inline void saveRuntimeResultsCsv(const std::vector<RuntimeBenchmarkResult>& results,
+                                  std::ostream& out) {
+    out << "model,size,backend,loops,threading,function,samples,mean,std_dev,min,p25,median,p75,p90,p95,p99,max\n";
+    out << std::setprecision(9);
+    for (const RuntimeBenchmarkResult& r : results) {
+        const RuntimeBenchmarkKey& k = r.key;
+        out << k.model << ","
+            << k.size << ","
+            << k.backend << ","
+            << (k.loops ? 1 : 0) << ","
+            << k.threading << ","
+            << k.function << ","
+            << r.samples << ","
+            << r.mean << ","
+            << r.stdDev << ","
+            << r.min << ","
+            << r.p25 << ","
+            << r.median << ","
+            << r.p75 << ","
+            << r.p90 << ","
+            << r.p95 << ","
+            << r.p99 << ","
+            << r.max << "\n";
+    }
+}
+
+/**
+ * Saves benchmark results in the JSON format.
+ */
+inline void saveRuntimeResultsJson(const std::vector<RuntimeBenchmarkResult>& results,
+                                   std::ostream& out) {
+    auto number = [&](const char* name, double v, bool last = false) {
+        out << "\"" << name << "\": ";
+        if (std::isnan(v))
+            out << "null";
+        else
+            out << v;
+        if (!last)
+            out << ", ";
+    };
+
+    out << std::setprecision(9);
+    out << "{\n  \"unit\": \"s\",\n  \"results\": [";
+    for (size_t i = 0; i < results.size(); i++) {
+        const RuntimeBenchmarkResult& r = results[i];
+        const RuntimeBenchmarkKey& k = r.key;
+        out << (i == 0 ? "\n" : ",\n");
+        out << "    {\"model\": \"" << k.model << "\", "
+            << "\"size\": " << k.size << ", "
+            << "\"backend\": \"" << k.backend << "\", "
+            << "\"loops\": " << (k.loops ? "true" : "false") << ", "
+            << "\"threading\": \"" << k.threading << "\", "
+            << "\"function\": \"" << k.function << "\", "
+            << "\"samples\": " << r.samples << ", ";
+        number("mean", r.mean);
+        number("std_dev", r.stdDev);
+        number("min", r.min);
+        number("p25", r.p25);
+        number("median", r.median);
+        number("p75", r.p75);
+        number("p90", r.p90);
+        number("p95", r.p95);
+        number("p99", r.p99);
+        number("max", r.max, true);
+        out << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+/**
+ * Reads benchmark results previously saved with saveRuntimeResultsCsv().
+ *
+ * @throws CGException if the file cannot be read or has an unexpected format
+ */
+inline std::vector<RuntimeBenchmarkResult> loadRuntimeResultsCsv(const std::string& file) {
+    std::ifstream in(file.c_str());
+    if (!in.is_open()) {
+        throw CGException("Failed to open benchmark results file '", file, "'");
+    }
+
+    auto toDouble = [](const std::string& s) {
+        if (s == "nan" || s == "-nan" || s.empty())
+            return std::numeric_limits<double>::quiet_NaN();
+        return std::stod(s);
+    };
+
+    std::vector<RuntimeBenchmarkResult> results;
+    std::string line;
+    std::getline(in, line); // header
+    size_t lineNumber = 1;
+    while (std::getline(in, line)) {
+        lineNumber++;
+        if (line.empty())
+            continue;
+
+        std::vector<std::string> cells;
+        std::istringstream ss(line);
+        std::string cell;
+        while (std::getline(ss, cell, ','))
+            cells.push_back(cell);
+
+        if (cells.size() != 17) {
+            throw CGException("Invalid benchmark results in '", file, "' at line ", lineNumber);
+        }
+
+        RuntimeBenchmarkResult r;
+        r.key.model = cells[0];
+        r.key.size = std::stoul(cells[1]);
+        r.key.backend = cells[2];
+        r.key.loops = cells[3] == "1";
+        r.key.threading = cells[4];
+        r.key.function = cells[5];
+        r.samples = std::stoul(cells[6]);
+        r.mean = toDouble(cells[7]);
+        r.stdDev = toDouble(cells[8]);
+        r.min = toDouble(cells[9]);
+        r.p25 = toDouble(cells[10]);
+        r.median = toDouble(cells[11]);
+        r.p75 = toDouble(cells[12]);
+        r.p90 = toDouble(cells[13]);
+        r.p95 = toDouble(cells[14]);
+        r.p99 = toDouble(cells[15]);
+        r.max = toDouble(cells[16]);
+        results.push_back(r);
+    }
+
+    return results;
+}
+
+/**
+ * Compares the median execution times against a baseline and prints
+ * a report.
+ * A case is considered a regression when its median is slower than the
+ * baseline median by more than the provided tolerance.
+ * Cases which are not present in both result sets are reported but
+ * ignored.
+ *
+ * @param baseline the reference results
+ * @param current the new results
+ * @param tolerance the accepted relative increase of the median
+ *                  (e.g. 0.1 for 10%)
+ * @param out where the report is printed to
+ * @return the number of regressions
+ */
+inline size_t compareRuntimeResults(const std::vector<RuntimeBenchmarkResult>& baseline,
+                                    const std::vector<RuntimeBenchmarkResult>& current,
+                                    double tolerance,
+                                    std::ostream& out) {
+    std::map<RuntimeBenchmarkKey, const RuntimeBenchmarkResult*> base;
+    for (const RuntimeBenchmarkResult& r : baseline)
+        base[r.key] = &r;
+
+    size_t regressions = 0;
+    size_t improvements = 0;
+    size_t compared = 0;
+
+    out << std::setw(60) << std::left << "case" << std::right
+        << std::setw(14) << "baseline" << std::setw(14) << "current" << std::setw(10) << "ratio" << "\n";
+
+    for (const RuntimeBenchmarkResult& r : current) {
+        auto it = base.find(r.key);
+        if (it == base.end()) {
+            out << std::setw(60) << std::left << r.key.toString() << std::right << "  (new)\n";
+            continue;
+        }
+        const RuntimeBenchmarkResult& b = *it->second;
+        base.erase(it);
+
+        if (std::isnan(b.median) || std::isnan(r.median) || b.median <= 0)
+            continue;
+
+        compared++;
+        double ratio = r.median / b.median;
+        const char* status = "";
+        if (ratio > 1 + tolerance) {
+            status = "  REGRESSION";
+            regressions++;
+        } else if (ratio < 1 / (1 + tolerance)) {
+            status = "  improvement";
+            improvements++;
+        }
+
+        out << std::setw(60) << std::left << r.key.toString() << std::right
+            << std::setw(14) << b.median << std::setw(14) << r.median
+            << std::setw(10) << std::setprecision(3) << ratio << std::setprecision(6)
+            << status << "\n";
+    }
+
+    for (const auto& missing : base) {
+        out << std::setw(60) << std::left << missing.first.toString() << std::right << "  (missing)\n";
+    }
+
+    out << "\ncompared: " << compared
+        << ", regressions: " << regressions
+        << ", improvements: " << improvements
+        << " (tolerance " << tolerance * 100 << "%)" << std::endl;
+
+    return regressions;
+}
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
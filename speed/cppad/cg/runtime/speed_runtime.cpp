@@ -0,0 +1,186 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Ciengis
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+#include "runtime_benchmark_models.hpp"
+#include "compiler_flag_tuner.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace {
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+            "  --models LIST      plugflow,diagonal,banded,dense (default: all)\n"
+            "  --sizes LIST       model sizes (default: 10,50)\n"
+            "  --backends LIST    gcc,clang,llvm (default: gcc)\n"
+            "  --loops LIST       0,1 (default: 0,1)\n"
+            "  --threading LIST   none,pthreads (default: none)\n"
+            "  --functions LIST   forward_zero,sparse_jacobian,sparse_hessian,reverse_two (default: all)\n"
+            "  --samples N        number of measured executions (default: 100)\n"
+            "  --warmup N         number of executions before measuring (default: 5)\n"
+            "  --gcc PATH         GCC executable\n"
+            "  --clang PATH       Clang executable\n"
+            "  --tuned FILE       use a configuration saved by speed_tuning\n"
+            "  --csv FILE         save the results in the CSV format\n"
+            "  --json FILE        save the results in the JSON format\n"
+            "  --compare FILE     compare the results with a baseline CSV file\n"
+            "  --tolerance X      accepted relative increase of the median (default: 0.1)\n"
+            "  --verbose\n"
+            "Returns 2 if a regression was detected in the comparison.\n";
+}
+
+} // END namespace
+
+int main(int argc, char** argv) {
+    using Backend = RuntimeBenchmark::Backend;
+    using Function = RuntimeBenchmark::Function;
+
+    PlugFlowBenchmarkModel plugflow;
+    BandedBenchmarkModel diagonal("diagonal", 1);
+    BandedBenchmarkModel banded("banded", 5);
+    BandedBenchmarkModel dense("dense", 0);
+
+    std::map<std::string, RuntimeBenchmarkModel*> allModels{
+        {"plugflow", &plugflow},
+        {"diagonal", &diagonal},
+        {"banded", &banded},
+        {"dense", &dense}
+    };
+    std::vector<std::string> modelNames{"plugflow", "diagonal", "banded", "dense"};
+
+    RuntimeBenchmark benchmark;
+    std::string csvFile, jsonFile, baselineFile;
+    double tolerance = 0.1;
+
+    try {
+        for (int a = 1; a < argc; a++) {
+            std::string arg = argv[a];
+            if (arg == "--help" || arg == "-h") {
+                printUsage(argv[0]);
+                return 0;
+            } else if (arg == "--verbose") {
+                benchmark.setVerbose(true);
+                continue;
+            }
+
+            if (a + 1 >= argc) {
+                throw CGException("Missing value for argument '", arg, "'");
+            }
+            std::string value = argv[++a];
+
+            if (arg == "--models") {
+                modelNames = splitList(value);
+            } else if (arg == "--sizes") {
+                std::vector<size_t> sizes;
+                for (const std::string& s : splitList(value))
+                    sizes.push_back(std::stoul(s));
+                benchmark.setSizes(sizes);
+            } else if (arg == "--backends") {
+                std::vector<Backend> backends;
+                for (const std::string& s : splitList(value)) {
+                    if (s == "gcc") backends.push_back(Backend::GCC);
+                    else if (s == "clang") backends.push_back(Backend::CLANG);
+                    else if (s == "llvm") backends.push_back(Backend::LLVM);
+                    else throw CGException("Unknown back end '", s, "'");
+                }
+                benchmark.setBackends(backends);
+            } else if (arg == "--loops") {
+                std::vector<bool> loops;
+                for (const std::string& s : splitList(value))
+                    loops.push_back(s == "1");
+                benchmark.setLoops(loops);
+            } else if (arg == "--threading") {
+                std::vector<MultiThreadingType> threading;
+                for (const std::string& s : splitList(value)) {
+                    if (s == "none") threading.push_back(MultiThreadingType::NONE);
+                    else if (s == "pthreads") threading.push_back(MultiThreadingType::PTHREADS);
+                    else if (s == "openmp") throw CGException("OpenMP is not supported by dynamically loaded model libraries (use 'pthreads')");
+                    else throw CGException("Unknown threading mode '", s, "'");
+                }
+                benchmark.setThreading(threading);
+            } else if (arg == "--functions") {
+                std::vector<Function> functions;
+                for (const std::string& s : splitList(value)) {
+                    if (s == "forward_zero") functions.push_back(Function::FORWARD_ZERO);
+                    else if (s == "sparse_jacobian") functions.push_back(Function::SPARSE_JACOBIAN);
+                    else if (s == "sparse_hessian") functions.push_back(Function::SPARSE_HESSIAN);
+                    else if (s == "reverse_two") functions.push_back(Function::REVERSE_TWO);
+                    else throw CGException("Unknown function '", s, "'");
+                }
+                benchmark.setFunctions(functions);
+            } else if (arg == "--samples") {
+                benchmark.setSamples(std::stoul(value));
+            } else if (arg == "--warmup") {
+                benchmark.setWarmup(std::stoul(value));
+            } else if (arg == "--gcc") {
+                benchmark.setGccPath(value);
+            } else if (arg == "--clang") {
+                benchmark.setClangPath(value);
+            } else if (arg == "--tuned") {
+                CompilerFlagConfiguration config = loadCompilerFlagConfiguration(value);
+                benchmark.setCompileFlags(config.compileFlags);
+                benchmark.setMaxAssignmentsPerFunc(config.maxAssignPerFunc);
+                benchmark.setFunctionGraphPartitioning(config.functionGraphPartitioning);
+            } else if (arg == "--csv") {
+                csvFile = value;
+            } else if (arg == "--json") {
+                jsonFile = value;
+            } else if (arg == "--compare") {
+                baselineFile = value;
+            } else if (arg == "--tolerance") {
+                tolerance = std::stod(value);
+            } else {
+                throw CGException("Unknown argument '", arg, "'");
+            }
+        }
+
+        for (const std::string& name : modelNames) {
+            auto it = allModels.find(name);
+            if (it == allModels.end())
+                throw CGException("Unknown model '", name, "'");
+            benchmark.addModel(*it->second);
+        }
+
+        benchmark.run();
+        benchmark.printResults(std::cout);
+
+        const std::vector<RuntimeBenchmarkResult>& results = benchmark.getResults();
+
+        if (!csvFile.empty()) {
+            std::ofstream out(csvFile.c_str());
+            saveRuntimeResultsCsv(results, out);
+        }
+
+        if (!jsonFile.empty()) {
+            std::ofstream out(jsonFile.c_str());
+            saveRuntimeResultsJson(results, out);
+        }
+
+        if (!baselineFile.empty()) {
+            std::vector<RuntimeBenchmarkResult> baseline = loadRuntimeResultsCsv(baselineFile);
+            std::cout << "\n";
+            size_t regressions = compareRuntimeResults(baseline, results, tolerance, std::cout);
+            if (regressions > 0)
+                return 2;
+        }
+
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
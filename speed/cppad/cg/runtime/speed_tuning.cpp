@@ -0,0 +1,164 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Ciengis
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+#include "runtime_benchmark_models.hpp"
+#include "compiler_flag_tuner.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace {
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+            "  --model NAME           plugflow,diagonal,banded,dense (default: plugflow)\n"
+            "  --size N               model size (default: 50)\n"
+            "  --backend NAME         gcc,clang (default: gcc)\n"
+            "  --loops 0|1            generate the model with loops (default: 0)\n"
+            "  --threading NAME       none,pthreads (default: none)\n"
+            "  --functions LIST       forward_zero,sparse_jacobian,sparse_hessian,reverse_two\n"
+            "                         (default: sparse_jacobian)\n"
+            "  --max-assignments LIST candidates for the maximum assignments per function\n"
+            "                         (default: 0,10000,2000,500 where 0 is the default size)\n"
+            "  --budget SECONDS       maximum accumulated library build time (default: 600)\n"
+            "  --samples N            number of measured executions (default: 50)\n"
+            "  --warmup N             number of executions before measuring (default: 5)\n"
+            "  --gcc PATH             GCC executable\n"
+            "  --clang PATH           Clang executable\n"
+            "  --output FILE          where the best configuration is saved\n"
+            "                         (default: speed_tuning.cfg)\n"
+            "  --csv FILE             save all the evaluated configurations in the CSV format\n"
+            "  --verbose\n";
+}
+
+} // END namespace
+
+int main(int argc, char** argv) {
+    using Backend = RuntimeBenchmark::Backend;
+    using Function = RuntimeBenchmark::Function;
+
+    PlugFlowBenchmarkModel plugflow;
+    BandedBenchmarkModel diagonal("diagonal", 1);
+    BandedBenchmarkModel banded("banded", 5);
+    BandedBenchmarkModel dense("dense", 0);
+
+    std::map<std::string, RuntimeBenchmarkModel*> allModels{
+        {"plugflow", &plugflow},
+        {"diagonal", &diagonal},
+        {"banded", &banded},
+        {"dense", &dense}
+    };
+
+    CompilerFlagTuner tuner;
+    std::string modelName = "plugflow";
+    size_t size = 50;
+    Backend backend = Backend::GCC;
+    bool loops = false;
+    MultiThreadingType threading = MultiThreadingType::NONE;
+    std::string outputFile = "speed_tuning.cfg";
+    std::string csvFile;
+
+    try {
+        for (int a = 1; a < argc; a++) {
+            std::string arg = argv[a];
+            if (arg == "--help" || arg == "-h") {
+                printUsage(argv[0]);
+                return 0;
+            } else if (arg == "--verbose") {
+                tuner.setVerbose(true);
+                continue;
+            }
+
+            if (a + 1 >= argc) {
+                throw CGException("Missing value for argument '", arg, "'");
+            }
+            std::string value = argv[++a];
+
+            if (arg == "--model") {
+                modelName = value;
+            } else if (arg == "--size") {
+                size = std::stoul(value);
+            } else if (arg == "--backend") {
+                if (value == "gcc") backend = Backend::GCC;
+                else if (value == "clang") backend = Backend::CLANG;
+                else throw CGException("Unknown back end '", value, "'");
+            } else if (arg == "--loops") {
+                loops = value == "1";
+            } else if (arg == "--threading") {
+                if (value == "none") threading = MultiThreadingType::NONE;
+                else if (value == "pthreads") threading = MultiThreadingType::PTHREADS;
+                else throw CGException("Unknown threading mode '", value, "'");
+            } else if (arg == "--functions") {
+                std::vector<Function> functions;
+                for (const std::string& s : splitList(value)) {
+                    if (s == "forward_zero") functions.push_back(Function::FORWARD_ZERO);
+                    else if (s == "sparse_jacobian") functions.push_back(Function::SPARSE_JACOBIAN);
+                    else if (s == "sparse_hessian") functions.push_back(Function::SPARSE_HESSIAN);
+                    else if (s == "reverse_two") functions.push_back(Function::REVERSE_TWO);
+                    else throw CGException("Unknown function '", s, "'");
+                }
+                tuner.setFunctions(functions);
+            } else if (arg == "--max-assignments") {
+                std::vector<size_t> candidates;
+                for (const std::string& s : splitList(value))
+                    candidates.push_back(std::stoul(s));
+                tuner.setMaxAssignmentsPerFuncCandidates(candidates);
+            } else if (arg == "--budget") {
+                tuner.setBuildTimeBudget(std::stod(value));
+            } else if (arg == "--samples") {
+                tuner.setSamples(std::stoul(value));
+            } else if (arg == "--warmup") {
+                tuner.setWarmup(std::stoul(value));
+            } else if (arg == "--gcc") {
+                tuner.setGccPath(value);
+            } else if (arg == "--clang") {
+                tuner.setClangPath(value);
+            } else if (arg == "--output") {
+                outputFile = value;
+            } else if (arg == "--csv") {
+                csvFile = value;
+            } else {
+                throw CGException("Unknown argument '", arg, "'");
+            }
+        }
+
+        auto it = allModels.find(modelName);
+        if (it == allModels.end())
+            throw CGException("Unknown model '", modelName, "'");
+
+        CompilerFlagTrial best = tuner.tune(*it->second, size, backend, loops, threading);
+
+        std::cout << "evaluated configurations: " << tuner.getTrials().size()
+                  << " (build time: " << tuner.getBuildTime() << " s)\n"
+                  << "best configuration: " << best.config.toString() << "\n"
+                  << "score: " << best.score << " s" << std::endl;
+
+        std::ofstream out(outputFile.c_str());
+        out << "# " << modelName << "/" << size << "/" << RuntimeBenchmark::toString(backend) << "/"
+            << (loops ? "loops" : "noloops") << "/" << RuntimeBenchmark::toString(threading) << "\n";
+        saveCompilerFlagConfiguration(best.config, out);
+
+        if (!csvFile.empty()) {
+            std::ofstream csv(csvFile.c_str());
+            tuner.saveTrialsCsv(csv);
+        }
+
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,144 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Ciengis
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+/**
+ * Measures the time and the number of heap allocations required to
+ * record a model with AD<CG<double> > and to create its operation graph
+ * (zero order forward mode with a CodeHandler).
+ */
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include <cppad/cg/cppadcg.hpp>
+#include "../../../../test/cppad/cg/models/plug_flow.hpp"
+
+namespace {
+
+std::atomic<size_t> allocations(0);
+
+}
+
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr)
+        throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace {
+
+using CGD = CG<double>;
+using ADCGD = AD<CGD>;
+using clock = std::chrono::steady_clock;
+
+struct TapingStatistics {
+    double time = 0;
+    size_t allocations = 0;
+};
+
+void printLine(const std::string& name,
+               size_t size,
+               size_t repeat,
+               const TapingStatistics& s) {
+    std::cout << std::setw(20) << std::left << name << std::right
+              << std::setw(8) << size
+              << std::setw(16) << std::setprecision(6) << s.time / repeat * 1e3
+              << std::setw(16) << s.allocations / repeat << std::endl;
+}
+
+} // END namespace
+
+int main(int argc, char** argv) {
+    std::vector<size_t> sizes{10, 50, 100};
+    size_t repeat = 20;
+
+    if (argc > 1) {
+        sizes.clear();
+        std::istringstream ss(argv[1]);
+        std::string s;
+        while (std::getline(ss, s, ','))
+            sizes.push_back(std::stoul(s));
+    }
+    if (argc > 2) {
+        repeat = std::stoul(argv[2]);
+    }
+
+    std::cout << "sizeof(CG<double>):       " << sizeof(CGD) << "\n"
+              << "sizeof(Argument<double>): " << sizeof(Argument<double>) << "\n\n";
+
+    std::cout << std::setw(20) << std::left << "stage" << std::right
+              << std::setw(8) << "size"
+              << std::setw(16) << "time (ms)"
+              << std::setw(16) << "allocations" << std::endl;
+
+    PlugFlowModel<CGD> model;
+
+    for (size_t size : sizes) {
+        std::vector<double> xTypical = PlugFlowModel<double>::getTypicalValues(size);
+        size_t n = xTypical.size();
+
+        TapingStatistics tape, graph;
+
+        for (size_t r = 0; r < repeat; r++) {
+            /**
+             * record the model
+             */
+            size_t alloc0 = allocations.load();
+            auto t0 = clock::now();
+
+            std::vector<ADCGD> x(n);
+            for (size_t j = 0; j < n; j++)
+                x[j] = xTypical[j];
+            Independent(x);
+            std::vector<ADCGD> y = model.model2(x, size);
+            ADFun<CGD> fun(x, y);
+
+            tape.time += std::chrono::duration<double>(clock::now() - t0).count();
+            tape.allocations += allocations.load() - alloc0;
+
+            /**
+             * create the operation graph
+             */
+            alloc0 = allocations.load();
+            t0 = clock::now();
+
+            CodeHandler<double> handler;
+            std::vector<CGD> indVars(n);
+            handler.makeVariables(indVars);
+            std::vector<CGD> dep = fun.Forward(0, indVars);
+
+            graph.time += std::chrono::duration<double>(clock::now() - t0).count();
+            graph.allocations += allocations.load() - alloc0;
+        }
+
+        printLine("tape", size, repeat, tape);
+        printLine("operation graph", size, repeat, graph);
+    }
+
+    return 0;
+}
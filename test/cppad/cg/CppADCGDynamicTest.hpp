@@ -25,6 +25,37 @@
 namespace CppAD {
 namespace cg {
 
+/**
+ * Source generation options used to test the same model with different
+ * code generation strategies (see CppADCGDynamicTest::setOptions())
+ */
+struct DynamicTestOptions {
+    /// a unique name used for the test name
+    std::string name;
+    size_t maxAssignPerFunc = 100;
+    bool scheduleOperations = false;
+    bool localTemporaries = false;
+    bool streamSources = false;
+    size_t compilationThreads = 0;
+    bool compactTemporaryNames = false;
+    bool functionGraphPartitioning = false;
+};
+
+inline std::ostream& operator<<(std::ostream& os,
+                                const DynamicTestOptions& options) {
+    return os << options.name;
+}
+
+/**
+ * Provides the test name of a parameterized test using DynamicTestOptions
+ */
+struct DynamicTestOptionsName {
+    template<class ParamType>
+    std::string operator()(const ::testing::TestParamInfo<ParamType>& info) const {
+        return info.param.name;
+    }
+};
+
 class CppADCGDynamicTest : public CppADCGModelTest {
 public:
     using CGD = CG<double>;
@@ -39,9 +70,19 @@ protected:
     MultiThreadingType _multithread;
     bool _multithreadDisabled;
     ThreadPoolScheduleStrategy _multithreadScheduler;
+    SparseColoring _sparseColoring;
+    SparsityEngine _sparsityEngine;
+    bool _scheduleOperations;
+    bool _functionGraphPartitioning;
+    bool _localTemporaries;
+    bool _compactTemporaryNames;
+    bool _temporaryWorkspace;
+    bool _streamSources;
+    size_t _compilationThreads;
     std::vector<Base> _xTape;
     std::vector<double> _xRun;
     size_t _maxAssignPerFunc = 100;
+    size_t _forwardZeroTasks = 0;
     double epsilonR = 1e-14;
     double epsilonA = 1e-14;
     std::vector<double> _xNorm;
@@ -67,11 +108,34 @@ public:
             _reverseTwo(true),
             _multithread(MultiThreadingType::NONE),
             _multithreadDisabled(false),
-            _multithreadScheduler(ThreadPoolScheduleStrategy::DYNAMIC) {
+            _multithreadScheduler(ThreadPoolScheduleStrategy::DYNAMIC),
+            _sparseColoring(SparseColoring::CppAD),
+            _sparsityEngine(SparsityEngine::CppAD),
+            _scheduleOperations(false),
+            _functionGraphPartitioning(false),
+            _localTemporaries(false),
+            _compactTemporaryNames(false),
+            _temporaryWorkspace(false),
+            _streamSources(false),
+            _compilationThreads(0) {
     }
 
     virtual std::vector<ADCGD> model(const std::vector<ADCGD>& ind) = 0;
 
+    /**
+     * Defines the source generation options (must be called before
+     * SetUp()).
+     */
+    inline void setOptions(const DynamicTestOptions& options) {
+        _maxAssignPerFunc = options.maxAssignPerFunc;
+        _scheduleOperations = options.scheduleOperations;
+        _localTemporaries = options.localTemporaries;
+        _streamSources = options.streamSources;
+        _compilationThreads = options.compilationThreads;
+        _compactTemporaryNames = options.compactTemporaryNames;
+        _functionGraphPartitioning = options.functionGraphPartitioning;
+    }
+
     void SetUp() override {
         ASSERT_EQ(_xTape.size(), _xRun.size());
         ASSERT_TRUE(_xNorm.empty() || _xRun.size() == _xNorm.size());
@@ -124,6 +188,14 @@ public:
         modelSourceGen.setCreateReverseTwo(_reverseTwo);
         modelSourceGen.setMaxAssignmentsPerFunc(_maxAssignPerFunc);
         modelSourceGen.setMultiThreading(true);
+        modelSourceGen.setForwardZeroTaskCount(_forwardZeroTasks);
+        modelSourceGen.setSparseColoring(_sparseColoring);
+        modelSourceGen.setSparsityEngine(_sparsityEngine);
+        modelSourceGen.setScheduleOperations(_scheduleOperations);
+        modelSourceGen.setFunctionGraphPartitioning(_functionGraphPartitioning);
+        modelSourceGen.setLocalTemporaries(_localTemporaries);
+        modelSourceGen.setCompactTemporaryNames(_compactTemporaryNames);
+        modelSourceGen.setTemporaryWorkspace(_temporaryWorkspace);
 
         if (!_jacRow.empty())
             modelSourceGen.setCustomSparseJacobianElements(_jacRow, _jacCol);
@@ -134,9 +206,13 @@ public:
         ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
         libSourceGen.setMultiThreading(_multithread);
 
-        SaveFilesModelLibraryProcessor<double>::saveLibrarySourcesTo(libSourceGen, "sources_" + _name + "_1");
+        if (!_streamSources && _compilationThreads == 0) {
+            SaveFilesModelLibraryProcessor<double>::saveLibrarySourcesTo(libSourceGen, "sources_" + _name + "_1");
+        }
 
         DynamicModelLibraryProcessor<double> p(libSourceGen);
+        p.setStreamSources(_streamSources);
+        p.setCompilationThreads(_compilationThreads);
 
         // some additional tests
         ASSERT_EQ(p.getLibraryName(), "cppad_cg_model");
@@ -0,0 +1,128 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Ciengis
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+#include <cppad/cg/cppadcg.hpp>
+#include <gtest/gtest.h>
+
+#include "CppADCGTest.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+using namespace std;
+
+namespace {
+
+using CGD = CG<double>;
+using ADCGD = AD<CGD>;
+
+std::vector<ADCGD> modelInner(const std::vector<ADCGD>& u) {
+    std::vector<ADCGD> v(2);
+    v[0] = u[0] * u[1];
+    v[1] = sin(u[0]) + u[1] * u[1];
+    return v;
+}
+
+std::vector<ADCGD> modelOuter(const std::vector<ADCGD>& x,
+                              const std::vector<ADCGD>& v) {
+    std::vector<ADCGD> y(2);
+    y[0] = v[0] * x[1] + v[1];
+    y[1] = v[1] / x[0];
+    return y;
+}
+
+}
+
+TEST_F(CppADCGTest, AtomicFunBridgeInline) {
+    std::vector<double> xv{1.5, 0.5};
+    size_t n = xv.size();
+
+    // inner model
+    std::vector<ADCGD> au(n, 1.0);
+    CppAD::Independent(au);
+    std::vector<ADCGD> av = modelInner(au);
+    ADFun<CGD> funInner(au, av);
+
+    CGAtomicFunBridge<double> atomicFun("inner", funInner, true);
+    atomicFun.setInline(true);
+
+    // outer model using the atomic function
+    std::vector<ADCGD> ax(n, 1.0);
+    CppAD::Independent(ax);
+    std::vector<ADCGD> aAtomicV(2);
+    atomicFun(ax, aAtomicV);
+    std::vector<ADCGD> ay = modelOuter(ax, aAtomicV);
+    ADFun<CGD> fun(ax, ay);
+
+    // same model without the atomic function
+    std::vector<ADCGD> ax2(n, 1.0);
+    CppAD::Independent(ax2);
+    std::vector<ADCGD> ay2 = modelOuter(ax2, modelInner(ax2));
+    ADFun<CGD> fun2(ax2, ay2);
+
+    std::vector<CGD> x2(n);
+    for (size_t j = 0; j < n; j++)
+        x2[j] = xv[j];
+    std::vector<CGD> w2{1.0, 2.0};
+
+    /**
+     * generate the operations of the outer model
+     */
+    CodeHandler<double> handler;
+    std::vector<CGD> x(n);
+    handler.makeVariables(x);
+    for (size_t j = 0; j < n; j++)
+        x[j].setValue(xv[j]);
+
+    std::vector<CGD> y = fun.Forward(0, x);
+    std::vector<CGD> jac = fun.Jacobian(x);
+    std::vector<CGD> w(w2.begin(), w2.end());
+    std::vector<CGD> hess = fun.Hessian(x, w);
+
+    // no runtime calls to the atomic function
+    ASSERT_TRUE(handler.getAtomicFunctions().empty());
+
+    std::vector<CGD> yExpected = fun2.Forward(0, x2);
+    std::vector<CGD> jacExpected = fun2.Jacobian(x2);
+    std::vector<CGD> hessExpected = fun2.Hessian(x2, w2);
+
+    ASSERT_EQ(y.size(), yExpected.size());
+    for (size_t i = 0; i < y.size(); i++) {
+        ASSERT_TRUE(y[i].isValueDefined());
+        ASSERT_NEAR(y[i].getValue(), yExpected[i].getValue(), 1e-10);
+    }
+
+    ASSERT_EQ(jac.size(), jacExpected.size());
+    for (size_t i = 0; i < jac.size(); i++) {
+        ASSERT_TRUE(jac[i].isValueDefined());
+        ASSERT_NEAR(jac[i].getValue(), jacExpected[i].getValue(), 1e-10);
+    }
+
+    ASSERT_EQ(hess.size(), hessExpected.size());
+    for (size_t i = 0; i < hess.size(); i++) {
+        ASSERT_TRUE(hess[i].isValueDefined());
+        ASSERT_NEAR(hess[i].getValue(), hessExpected[i].getValue(), 1e-10);
+    }
+
+    /**
+     * the generated source must not reference the atomic function
+     */
+    LanguageC<double> langC("double");
+    LangCDefaultVariableNameGenerator<double> nameGen;
+
+    std::ostringstream code;
+    handler.generateCode(code, langC, jac, nameGen);
+
+    ASSERT_EQ(code.str().find("atomicFun"), std::string::npos);
+}
@@ -32,6 +32,36 @@ public:
          */
         this->memory_check_ = false;
     }
+
+    /**
+     * Checks that two index reductions selected the same dummy derivatives
+     * (the same variables) and the same reduced equations.
+     */
+    static inline void compareReducedModels(const std::vector<DaeVarInfo>& varInfo1,
+                                            const std::vector<DaeEquationInfo>& eqInfo1,
+                                            const std::vector<DaeVarInfo>& varInfo2,
+                                            const std::vector<DaeEquationInfo>& eqInfo2) {
+        ASSERT_EQ(varInfo1.size(), varInfo2.size());
+        for (size_t j = 0; j < varInfo1.size(); j++) {
+            const DaeVarInfo& v1 = varInfo1[j];
+            const DaeVarInfo& v2 = varInfo2[j];
+            ASSERT_EQ(v1.getName(), v2.getName()) << "variable " << j;
+            ASSERT_EQ(v1.getOriginalIndex(), v2.getOriginalIndex()) << v1.getName();
+            ASSERT_EQ(v1.getDerivative(), v2.getDerivative()) << v1.getName();
+            ASSERT_EQ(v1.getAntiDerivative(), v2.getAntiDerivative()) << v1.getName();
+            ASSERT_EQ(v1.isIntegratedVariable(), v2.isIntegratedVariable()) << v1.getName();
+        }
+
+        ASSERT_EQ(eqInfo1.size(), eqInfo2.size());
+        for (size_t i = 0; i < eqInfo1.size(); i++) {
+            const DaeEquationInfo& e1 = eqInfo1[i];
+            const DaeEquationInfo& e2 = eqInfo2[i];
+            ASSERT_EQ(e1.getOriginalIndex(), e2.getOriginalIndex()) << "equation " << i;
+            ASSERT_EQ(e1.getAntiDerivative(), e2.getAntiDerivative()) << "equation " << i;
+            ASSERT_EQ(e1.getAssignedVarIndex(), e2.getAssignedVarIndex()) << "equation " << i;
+            ASSERT_EQ(e1.isExplicit(), e2.isExplicit()) << "equation " << i;
+        }
+    }
 };
 
 } // END cg namespace
@@ -0,0 +1,112 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Ciengis
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include <cppad/cg/dae_index_reduction/pantelides.hpp>
+
+#include "CppADCGIndexReductionTest.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace {
+
+BipartiteMatching createMatching(size_t nVars,
+                                 const std::vector<std::vector<size_t> >& eqs) {
+    BipartiteMatching m;
+    m.addVariables(nVars);
+    for (const auto& vars : eqs)
+        m.addEquation(vars);
+    return m;
+}
+
+}
+
+TEST(BipartiteMatching, Maximum) {
+    // the greedy assignment (eq0 -> v0) must be changed
+    BipartiteMatching m = createMatching(3, {{0, 1},
+                                             {0},
+                                             {1, 2}});
+
+    ASSERT_EQ(m.match(), 3u);
+    ASSERT_EQ(m.matchedVariable(1), 0u);
+    ASSERT_EQ(m.matchedVariable(0), 1u);
+    ASSERT_EQ(m.matchedVariable(2), 2u);
+}
+
+TEST(BipartiteMatching, Incremental) {
+    BipartiteMatching m = createMatching(2, {{0},
+                                             {0, 1}});
+    ASSERT_EQ(m.match(), 2u);
+
+    // a new equation and variable (e.g. after a differentiation)
+    m.addVariables(1);
+    m.addEquation(std::vector<size_t>{1, 2});
+    ASSERT_EQ(m.match(), 3u);
+    ASSERT_EQ(m.matchedVariable(0), 0u);
+    ASSERT_EQ(m.matchedVariable(1), 1u);
+    ASSERT_EQ(m.matchedVariable(2), 2u);
+}
+
+TEST(BipartiteMatching, BlockTriangular) {
+    /**
+     * eq0: v0
+     * eq1: v0 v1 v2
+     * eq2: v1 v2
+     * eq3: v2 v3
+     */
+    BipartiteMatching m = createMatching(4, {{0},
+                                             {0, 1, 2},
+                                             {1, 2},
+                                             {2, 3}});
+    ASSERT_EQ(m.match(), 4u);
+
+    BltDecomposition blt = m.blockTriangular();
+    ASSERT_EQ(blt.blockCount(), 3u);
+    ASSERT_EQ(blt.blockSize(0), 1u);
+    ASSERT_EQ(blt.equations[0], 0u);
+    ASSERT_EQ(blt.blockSize(1), 2u);
+    ASSERT_EQ(blt.blockSize(2), 1u);
+    ASSERT_EQ(blt.equations[3], 3u);
+
+    // each block can only use variables of the previous blocks
+    std::vector<size_t> varBlock(4);
+    for (size_t b = 0; b < blt.blockCount(); b++) {
+        for (size_t p = blt.blockStart[b]; p < blt.blockStart[b + 1]; p++)
+            varBlock[blt.variables[p]] = b;
+    }
+    ASSERT_LE(varBlock[0], varBlock[1]);
+    ASSERT_LE(varBlock[2], varBlock[3]);
+}
+
+TEST(BipartiteMatching, DulmageMendelsohn) {
+    /**
+     * eq0: v0 v1  (under-determined)
+     * eq1: v2     (square)
+     * eq2: v3     (over-determined)
+     * eq3: v3
+     */
+    BipartiteMatching m = createMatching(4, {{0, 1},
+                                             {2},
+                                             {3},
+                                             {3}});
+    ASSERT_EQ(m.match(), 3u);
+
+    DulmageMendelsohn dm = m.dulmageMendelsohn();
+    ASSERT_EQ(dm.underEquations, std::vector<size_t>({0}));
+    ASSERT_EQ(dm.underVariables, std::vector<size_t>({0, 1}));
+    ASSERT_EQ(dm.overEquations, std::vector<size_t>({2, 3}));
+    ASSERT_EQ(dm.overVariables, std::vector<size_t>({3}));
+    ASSERT_EQ(dm.square.equations, std::vector<size_t>({1}));
+    ASSERT_EQ(dm.square.variables, std::vector<size_t>({2}));
+}
@@ -0,0 +1,186 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Ciengis
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include <cppad/cg/dae_index_reduction/dae_model_c_source_gen.hpp>
+
+#include "CppADCGIndexReductionTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace {
+
+/**
+ * Index 1 DAE with two blocks:
+ *   {F0, F2} for {x0, y0}
+ *   {F1, F3, F4} for {x1, y1, y2}
+ */
+ADFun<CGD>* blockDae(std::vector<DaeVarInfo>& daeVar) {
+    using ADCG = AD<CGD>;
+
+    std::vector<ADCG> U(9);
+    Independent(U);
+
+    ADCG x0 = U[0];
+    ADCG x1 = U[1];
+    ADCG y0 = U[2];
+    ADCG y1 = U[3];
+    ADCG y2 = U[4];
+    ADCG p = U[5];
+    ADCG t = U[6];
+    ADCG dx0dt = U[7];
+    ADCG dx1dt = U[8];
+
+    daeVar.resize(U.size());
+    daeVar[0] = DaeVarInfo("x0");
+    daeVar[1] = DaeVarInfo("x1");
+    daeVar[2] = DaeVarInfo("y0");
+    daeVar[3] = DaeVarInfo("y1");
+    daeVar[4] = DaeVarInfo("y2");
+    daeVar[5] = DaeVarInfo("p");
+    daeVar[5].makeConstant();
+    daeVar[6] = DaeVarInfo("t");
+    daeVar[6].makeIntegratedVariable();
+    daeVar[7] = DaeVarInfo(0, "dx0dt");
+    daeVar[8] = DaeVarInfo(1, "dx1dt");
+    daeVar[0].setDerivative(7);
+    daeVar[1].setDerivative(8);
+
+    std::vector<ADCG> Z(5);
+    Z[0] = dx0dt + x0 - y0;
+    Z[1] = dx1dt - x0 + x1 * y1;
+    Z[2] = y0 - p * x0;
+    Z[3] = y1 * y1 + y2 - x1;
+    Z[4] = y2 - y1 * t - 1.0;
+
+    return new ADFun<CGD>(U, Z);
+}
+
+}
+
+TEST_F(IndexReductionTest, DaeModelCSourceGenBlt) {
+    using std::vector;
+
+    vector<DaeVarInfo> daeVar;
+    std::unique_ptr<ADFun<CGD>> fun(blockDae(daeVar));
+
+    vector<DaeEquationInfo> eqInfo(fun->Range());
+    for (size_t i = 0; i < eqInfo.size(); i++)
+        eqInfo[i] = DaeEquationInfo(i, i, -1, -1);
+
+    vector<double> x{0.5, 1.5, 0.3, 0.7, 1.2, 2.0, 0.1, -0.2, 0.4};
+
+    DaeModelCSourceGen<double> daeGen(*fun, daeVar, eqInfo, "dae");
+    daeGen.setTypicalIndependentValues(x);
+
+    /**
+     * structure
+     */
+    const BltDecomposition& blt = daeGen.getBlockTriangularForm();
+    ASSERT_EQ(size_t(2), blt.blockCount());
+    ASSERT_EQ(size_t(2), blt.blockSize(0));
+    ASSERT_EQ(size_t(3), blt.blockSize(1));
+
+    std::set<size_t> eqs0(blt.equations.begin(), blt.equations.begin() + 2);
+    std::set<size_t> vars0(blt.variables.begin(), blt.variables.begin() + 2);
+    ASSERT_EQ((std::set<size_t>{0, 2}), eqs0);
+    ASSERT_EQ((std::set<size_t>{0, 2}), vars0);
+
+    const vector<size_t>& eqOrder = daeGen.getEquationOrder();
+    ASSERT_EQ(fun->Range(), eqOrder.size());
+
+    /**
+     * compile
+     */
+    GccCompiler<double> compiler;
+    prepareTestCompilerFlags(compiler);
+
+    ModelLibraryCSourceGen<double> libGen(daeGen.getModel());
+    daeGen.addBlockModels(libGen);
+
+    DynamicModelLibraryProcessor<double> p(libGen, "cppadcg_dae_blt");
+    std::unique_ptr<DynamicLib<double>> lib = p.createDynamicLibrary(compiler);
+
+    /**
+     * reference values
+     */
+    vector<CGD> xCG(x.size());
+    for (size_t j = 0; j < x.size(); j++)
+        xCG[j] = x[j];
+    vector<CGD> resOrig = fun->Forward(0, xCG);
+    vector<CGD> jacOrig = fun->Jacobian(xCG);
+    size_t n = fun->Domain();
+
+    /**
+     * complete model
+     */
+    std::unique_ptr<GenericModel<double>> model = lib->model("dae");
+    ASSERT_TRUE(model != nullptr);
+
+    vector<double> res = model->ForwardZero(x);
+    ASSERT_EQ(resOrig.size(), res.size());
+    for (size_t i = 0; i < res.size(); i++) {
+        ASSERT_NEAR(resOrig[eqOrder[i]].getValue(), res[i], 1e-10);
+    }
+
+    vector<double> jac;
+    vector<size_t> row, col;
+    model->SparseJacobian(x, jac, row, col);
+    for (size_t e = 0; e < jac.size(); e++) {
+        ASSERT_TRUE(col[e] != 5 && col[e] != 6); // no parameters nor time
+        ASSERT_NEAR(jacOrig[eqOrder[row[e]] * n + col[e]].getValue(), jac[e], 1e-10);
+    }
+
+    /**
+     * block models
+     */
+    for (size_t b = 0; b < blt.blockCount(); b++) {
+        std::unique_ptr<GenericModel<double>> blockModel = lib->model(daeGen.getBlockModelName(b));
+        ASSERT_TRUE(blockModel != nullptr);
+        ASSERT_EQ(blt.blockSize(b), blockModel->Range());
+        ASSERT_EQ(n, blockModel->Domain());
+
+        size_t start = blt.blockStart[b];
+
+        res = blockModel->ForwardZero(x);
+        for (size_t i = 0; i < res.size(); i++) {
+            ASSERT_NEAR(resOrig[blt.equations[start + i]].getValue(), res[i], 1e-10);
+        }
+
+        blockModel->SparseJacobian(x, jac, row, col);
+        ASSERT_FALSE(jac.empty());
+        for (size_t e = 0; e < jac.size(); e++) {
+            ASSERT_NEAR(jacOrig[blt.equations[start + row[e]] * n + col[e]].getValue(), jac[e], 1e-10);
+        }
+
+        /**
+         * iteration matrix (block unknowns and their time derivatives)
+         */
+        ASSERT_TRUE(blockModel->isSparseIterationMatrixAvailable());
+        double alpha = 3.5;
+        blockModel->SparseIterationMatrix(x, alpha, jac, row, col);
+        ASSERT_FALSE(jac.empty());
+        for (size_t e = 0; e < jac.size(); e++) {
+            ASSERT_LT(col[e], blt.blockSize(b));
+            size_t eq = blt.equations[start + row[e]];
+            size_t j = blt.variables[start + col[e]];
+            double expected = jacOrig[eq * n + j].getValue();
+            int dj = daeVar[j].getDerivative();
+            if (dj >= 0)
+                expected += alpha * jacOrig[eq * n + dj].getValue();
+            ASSERT_NEAR(expected, jac[e], 1e-10);
+        }
+    }
+}
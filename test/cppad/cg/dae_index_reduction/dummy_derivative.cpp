@@ -74,6 +74,183 @@ TEST_F(IndexReductionTest, DummyDerivPendulum2D) {
     delete fun;
 }
 
+/**
+ * @test select dummy derivatives with the sparse QR decomposition
+ */
+TEST_F(IndexReductionTest, DummyDerivPendulum2DSparse) {
+    using namespace std;
+
+    std::vector<DaeVarInfo> daeVar;
+
+    // create f: U -> Z and vectors used for derivative calculations
+    ADFun<CGD>* fun = Pendulum2D<CGD> (daeVar);
+
+    std::vector<double> x(daeVar.size());
+    std::vector<double> normVar(daeVar.size(), 1.0);
+    std::vector<double> normEq(5, 1.0);
+
+    x[0] = -1.0; // x
+    x[1] = 0.0; // y
+    x[2] = 0.0; // vx
+    x[3] = 0.0; // vy
+    x[4] = 1.0; // Tension
+    x[5] = 1.0; // length
+
+    x[6] = 0.0; // time
+
+    x[7] = 0.0; // dxdt
+    x[8] = 0.0; // dydt
+    x[9] = -1.0; // dvxdt
+    x[10] = 9.80665; // dvydt
+
+    std::vector<std::string> eqName; // empty
+
+    std::vector<DaeVarInfo> newDaeVarDense;
+    std::vector<DaeEquationInfo> newEqInfoDense;
+    std::unique_ptr<ADFun<CGD>> reducedFunDense;
+    {
+        Pantelides<double> pantelides(*fun, daeVar, eqName, x);
+        DummyDerivatives<double> dummyD(pantelides, x, normVar, normEq);
+        dummyD.setReduceEquations(false);
+        ASSERT_NO_THROW(reducedFunDense = dummyD.reduceIndex(newDaeVarDense, newEqInfoDense));
+    }
+
+    Pantelides<double> pantelides(*fun, daeVar, eqName, x);
+    DummyDerivatives<double> dummyD(pantelides, x, normVar, normEq);
+    dummyD.setReduceEquations(false);
+    dummyD.setSparseSelection(true);
+    ASSERT_TRUE(dummyD.isSparseSelection());
+
+    std::vector<DaeVarInfo> newDaeVar;
+    std::vector<DaeEquationInfo> newEqInfo;
+    std::unique_ptr<ADFun<CGD>> reducedFun;
+    ASSERT_NO_THROW(reducedFun = dummyD.reduceIndex(newDaeVar, newEqInfo));
+
+    ASSERT_TRUE(reducedFun != nullptr);
+    ASSERT_TRUE(reducedFunDense != nullptr);
+
+    ASSERT_EQ(size_t(3), pantelides.getStructuralIndex());
+
+    // the same number of dummy derivatives must be selected
+    ASSERT_EQ(newDaeVarDense.size(), newDaeVar.size());
+    ASSERT_EQ(reducedFunDense->Range(), reducedFun->Range());
+
+    // the same dummy derivatives and equations must be selected
+    compareReducedModels(newDaeVarDense, newEqInfoDense, newDaeVar, newEqInfo);
+
+    delete fun;
+}
+
+TEST_F(IndexReductionTest, DummyDerivPendulum2DSparseMultiThreaded) {
+    using namespace std;
+
+    std::vector<DaeVarInfo> daeVar;
+
+    // create f: U -> Z and vectors used for derivative calculations
+    ADFun<CGD>* fun = Pendulum2D<CGD> (daeVar);
+
+    std::vector<double> x(daeVar.size());
+    std::vector<double> normVar(daeVar.size(), 1.0);
+    std::vector<double> normEq(5, 1.0);
+
+    x[0] = -1.0; // x
+    x[1] = 0.0; // y
+    x[2] = 0.0; // vx
+    x[3] = 0.0; // vy
+    x[4] = 1.0; // Tension
+    x[5] = 1.0; // length
+
+    x[6] = 0.0; // time
+
+    x[7] = 0.0; // dxdt
+    x[8] = 0.0; // dydt
+    x[9] = -1.0; // dvxdt
+    x[10] = 9.80665; // dvydt
+
+    std::vector<std::string> eqName; // empty
+
+    Pantelides<double> pantelides(*fun, daeVar, eqName, x);
+    DummyDerivatives<double> dummyD(pantelides, x, normVar, normEq);
+    dummyD.setSparseSelection(true);
+    dummyD.setThreadCount(2);
+    ASSERT_EQ(size_t(2), dummyD.getThreadCount());
+
+    std::vector<DaeVarInfo> newDaeVar;
+    std::vector<DaeEquationInfo> newEqInfo;
+    std::unique_ptr<ADFun<CGD>> reducedFun;
+    ASSERT_NO_THROW(reducedFun = dummyD.reduceIndex(newDaeVar, newEqInfo));
+
+    ASSERT_TRUE(reducedFun != nullptr);
+
+    ASSERT_EQ(size_t(3), pantelides.getStructuralIndex());
+
+    const auto& stages = dummyD.getStageTimes();
+    ASSERT_FALSE(stages.empty());
+    for (const auto& s : stages) {
+        ASSERT_GE(s.second, 0.0);
+    }
+
+    delete fun;
+}
+
+/**
+ * @test factorize several independent selection blocks in parallel
+ */
+TEST_F(IndexReductionTest, DummyDerivPendulumsSparseMultiThreaded) {
+    using namespace std;
+
+    const size_t nPendulums = 4;
+
+    std::vector<DaeVarInfo> daeVar;
+    std::vector<double> x;
+
+    // create f: U -> Z and vectors used for derivative calculations
+    std::unique_ptr<ADFun<CGD>> fun(Pendulums2D<CGD> (nPendulums, daeVar, x));
+
+    std::vector<double> normVar(daeVar.size(), 1.0);
+    std::vector<double> normEq(fun->Range(), 1.0);
+
+    std::vector<std::string> eqName; // empty
+
+    std::vector<DaeVarInfo> newDaeVarSerial;
+    std::vector<DaeEquationInfo> newEqInfoSerial;
+    std::unique_ptr<ADFun<CGD>> reducedFunSerial;
+    {
+        Pantelides<double> pantelides(*fun, daeVar, eqName, x);
+        DummyDerivatives<double> dummyD(pantelides, x, normVar, normEq);
+        dummyD.setReduceEquations(false);
+        dummyD.setSparseSelection(true);
+        ASSERT_NO_THROW(reducedFunSerial = dummyD.reduceIndex(newDaeVarSerial, newEqInfoSerial));
+    }
+
+    Pantelides<double> pantelides(*fun, daeVar, eqName, x);
+    DummyDerivatives<double> dummyD(pantelides, x, normVar, normEq);
+    dummyD.setReduceEquations(false);
+    dummyD.setSparseSelection(true);
+    dummyD.setThreadCount(3);
+
+    std::ostringstream log;
+    dummyD.setLog(log);
+    dummyD.setVerbosity(Verbosity::High);
+
+    std::vector<DaeVarInfo> newDaeVar;
+    std::vector<DaeEquationInfo> newEqInfo;
+    std::unique_ptr<ADFun<CGD>> reducedFun;
+    ASSERT_NO_THROW(reducedFun = dummyD.reduceIndex(newDaeVar, newEqInfo));
+
+    ASSERT_TRUE(reducedFun != nullptr);
+    ASSERT_TRUE(reducedFunSerial != nullptr);
+
+    ASSERT_EQ(size_t(3), pantelides.getStructuralIndex());
+
+    // each pendulum is an independent block (factorized by several threads)
+    ASSERT_NE(log.str().find("## independent blocks: " + std::to_string(nPendulums)), std::string::npos) << log.str();
+
+    // the threaded selection must be the same as the single threaded one
+    ASSERT_EQ(reducedFunSerial->Range(), reducedFun->Range());
+    compareReducedModels(newDaeVarSerial, newEqInfoSerial, newDaeVar, newEqInfo);
+}
+
 /**
  * @test explicitly avoid using a variable as dummy derivative
  */
@@ -54,4 +54,53 @@ TEST_F(IndexReductionTest, DummyDerivMattsson) {
     //ASSERT_EQ(10, reducedFun->Range());
 
     delete fun;
-}
\ No newline at end of file
+}
+
+TEST_F(IndexReductionTest, DummyDerivMattssonSparse) {
+    using namespace std;
+
+    std::vector<DaeVarInfo> daeVar;
+    std::vector<double> x;
+
+    // create f: U -> Z and vectors used for derivative calculations
+    std::unique_ptr<ADFun<CGD>> fun(MattssonLinear<CGD> (daeVar, x));
+
+    std::vector<double> normVar(daeVar.size(), 1.0);
+    std::vector<double> normEq(7, 1.0);
+
+    std::vector<std::string> eqName; // empty
+
+    std::vector<DaeVarInfo> newDaeVarDense;
+    std::vector<DaeEquationInfo> newEqInfoDense;
+    std::unique_ptr<ADFun<CGD>> reducedFunDense;
+    {
+        Pantelides<double> pantelides(*fun, daeVar, eqName, x);
+
+        DummyDerivatives<double> dummyD(pantelides, x, normVar, normEq);
+        dummyD.setGenerateSemiExplicitDae(true);
+        dummyD.setReduceEquations(true);
+        ASSERT_NO_THROW(reducedFunDense = dummyD.reduceIndex(newDaeVarDense, newEqInfoDense));
+    }
+
+    Pantelides<double> pantelides(*fun, daeVar, eqName, x);
+
+    DummyDerivatives<double> dummyD(pantelides, x, normVar, normEq);
+    dummyD.setGenerateSemiExplicitDae(true);
+    dummyD.setReduceEquations(true);
+    dummyD.setSparseSelection(true);
+    dummyD.setPivotThreshold(1e-10);
+
+    std::vector<DaeVarInfo> newDaeVar;
+    std::vector<DaeEquationInfo> newEqInfo;
+    std::unique_ptr<ADFun<CGD>> reducedFun;
+    ASSERT_NO_THROW(reducedFun = dummyD.reduceIndex(newDaeVar, newEqInfo));
+
+    ASSERT_TRUE(reducedFun != nullptr);
+    ASSERT_TRUE(reducedFunDense != nullptr);
+
+    ASSERT_EQ(size_t(3), pantelides.getStructuralIndex());
+
+    // the same dummy derivatives and reduced equations must be selected
+    ASSERT_EQ(reducedFunDense->Range(), reducedFun->Range());
+    compareReducedModels(newDaeVarDense, newEqInfoDense, newDaeVar, newEqInfo);
+}
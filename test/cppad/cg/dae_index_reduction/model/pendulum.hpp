@@ -69,6 +69,73 @@ inline CppAD::ADFun<Base>* Pendulum2D(std::vector<DaeVarInfo>& daeVar) {
     return new ADFun<Base> (U, Z);
 }
 
+/**
+ * Several independent 2D pendulums with different lengths
+ * (each pendulum has its own dummy derivative selection block).
+ *
+ * @param n the number of pendulums
+ * @param daeVar the variable information
+ * @param x typical variable values
+ */
+template<class Base>
+inline CppAD::ADFun<Base>* Pendulums2D(size_t n,
+                                       std::vector<DaeVarInfo>& daeVar,
+                                       std::vector<double>& x) {
+    using namespace CppAD;
+    using namespace std;
+    using ADB = CppAD::AD<Base>;
+
+    // per pendulum: x, y, w, z, T, l and 4 derivatives; plus the time
+    std::vector<ADB> U(10 * n + 1);
+    Independent(U);
+
+    size_t tIndex = 6 * n;
+    daeVar.resize(U.size());
+    x.resize(U.size());
+    daeVar[tIndex].makeIntegratedVariable();
+    x[tIndex] = 0.0;
+
+    double g = 9.80665; // gravity constant
+
+    std::vector<ADB> Z(5 * n);
+    for (size_t p = 0; p < n; p++) {
+        size_t v = 6 * p;
+        size_t d = tIndex + 1 + 4 * p;
+        std::string suffix = std::to_string(p);
+
+        daeVar[v] = DaeVarInfo("x" + suffix);
+        daeVar[v + 1] = DaeVarInfo("y" + suffix);
+        daeVar[v + 2] = DaeVarInfo("w" + suffix); // vx
+        daeVar[v + 3] = DaeVarInfo("z" + suffix); // vy
+        daeVar[v + 4] = DaeVarInfo("T" + suffix);
+        daeVar[v + 5] = DaeVarInfo("l" + suffix);
+        daeVar[v + 5].makeConstant();
+        for (size_t k = 0; k < 4; k++)
+            daeVar[d + k] = int(v + k);
+
+        double L = 1.0 + 0.5 * p;
+        x[v] = -L; // x
+        x[v + 1] = 0.0; // y
+        x[v + 2] = 0.0; // vx
+        x[v + 3] = 0.0; // vy
+        x[v + 4] = 1.0; // tension
+        x[v + 5] = L; // length
+        x[d] = 0.0; // dxdt
+        x[d + 1] = 0.0; // dydt
+        x[d + 2] = -L; // dvxdt
+        x[d + 3] = g; // dvydt
+
+        Z[5 * p] = U[d] - U[v + 2];
+        Z[5 * p + 1] = U[d + 1] - U[v + 3];
+        Z[5 * p + 2] = U[d + 2] - U[v + 4] * U[v];
+        Z[5 * p + 3] = U[d + 3] - (U[v + 4] * U[v + 1] - g);
+        Z[5 * p + 4] = U[v] * U[v] + U[v + 1] * U[v + 1] - U[v + 5] * U[v + 5];
+    }
+
+    // create f: U -> Z and vectors used for derivative calculations
+    return new ADFun<Base> (U, Z);
+}
+
 template<class Base>
 inline CppAD::ADFun<Base>* Pendulum3D() {
     using namespace CppAD;
@@ -0,0 +1,144 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Ciengis
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+#include <cppad/cg/cppadcg.hpp>
+#include <gtest/gtest.h>
+#include "CppADCGTest.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+using namespace std;
+
+using VectorSet = std::vector<std::set<size_t> >;
+
+namespace {
+
+VectorSet tridiagonal(size_t n) {
+    VectorSet s(n);
+    for (size_t i = 0; i < n; i++) {
+        if (i > 0) s[i].insert(i - 1);
+        s[i].insert(i);
+        if (i + 1 < n) s[i].insert(i + 1);
+    }
+    return s;
+}
+
+void allElements(const VectorSet& s,
+                 std::vector<size_t>& row,
+                 std::vector<size_t>& col) {
+    for (size_t i = 0; i < s.size(); i++) {
+        for (size_t j : s[i]) {
+            row.push_back(i);
+            col.push_back(j);
+        }
+    }
+}
+
+}
+
+TEST(SparseColoring, Distance2Tridiagonal) {
+    size_t n = 10;
+    VectorSet s = tridiagonal(n);
+    std::vector<size_t> row, col;
+    allElements(s, row, col);
+
+    std::vector<size_t> color;
+    size_t nColors = colorDistanceTwo(s, n, row, col, color);
+
+    ASSERT_EQ(nColors, 3u);
+
+    // structurally orthogonal columns
+    for (size_t i = 0; i < n; i++) {
+        std::set<size_t> used;
+        for (size_t j : s[i]) {
+            ASSERT_TRUE(used.insert(color[j]).second);
+        }
+    }
+}
+
+TEST(SparseColoring, Distance2PartialElements) {
+    // dense row 0 but only the diagonal is requested
+    size_t n = 4;
+    VectorSet s(n);
+    for (size_t j = 0; j < n; j++) {
+        s[0].insert(j);
+        s[j].insert(j);
+    }
+    std::vector<size_t> row = {1, 2, 3};
+    std::vector<size_t> col = {1, 2, 3};
+
+    std::vector<size_t> color;
+    size_t nColors = colorDistanceTwo(s, n, row, col, color);
+
+    ASSERT_EQ(nColors, 1u);
+    ASSERT_EQ(color[0], (std::numeric_limits<size_t>::max)());
+}
+
+TEST(SparseColoring, StarArrowHead) {
+    // arrow-head matrix: a star coloring needs only 2 colors
+    size_t n = 8;
+    VectorSet s(n);
+    for (size_t j = 0; j < n; j++) {
+        s[0].insert(j);
+        s[j].insert(0);
+        s[j].insert(j);
+    }
+
+    std::vector<size_t> color;
+    size_t nColors = colorStar(s, color);
+    ASSERT_EQ(nColors, 2u);
+
+    std::vector<size_t> dcolor;
+    std::vector<size_t> row, col;
+    allElements(s, row, col);
+    size_t nDColors = colorDistanceTwo(s, n, row, col, dcolor);
+    ASSERT_EQ(nDColors, n);
+
+    // all elements must be recoverable
+    for (size_t e = 0; e < row.size(); e++) {
+        ASSERT_NO_THROW(starColoringSource(s, color, row[e], col[e]));
+    }
+}
+
+TEST(SparseColoring, StarRecovery) {
+    size_t n = 9;
+    VectorSet s = tridiagonal(n);
+    // add a few off-band elements
+    s[0].insert(5);
+    s[5].insert(0);
+    s[2].insert(8);
+    s[8].insert(2);
+
+    std::vector<size_t> color;
+    colorStar(s, color);
+
+    // numeric check: H (symmetric) with H(i,j) = 1 + i + j
+    auto h = [](size_t i, size_t j) {
+        return 1.0 + i + j;
+    };
+
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j : s[i]) {
+            std::pair<size_t, size_t> src = starColoringSource(s, color, i, j);
+
+            double b = 0; // compressed B(r, c) = sum_{k: color[k] == c} H(r, k)
+            for (size_t k : s[src.first]) {
+                if (color[k] == src.second)
+                    b += h(src.first, k);
+            }
+            ASSERT_EQ(b, h(i, j));
+        }
+    }
+}
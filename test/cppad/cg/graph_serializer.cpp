@@ -0,0 +1,137 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Ciengis
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace {
+
+using CGD = CG<double>;
+using ADCGD = AD<CGD>;
+
+std::vector<ADCGD> modelInner(const std::vector<ADCGD>& u) {
+    std::vector<ADCGD> v(2);
+    v[0] = u[0] * u[1];
+    v[1] = sin(u[0]) + u[1] * u[1];
+    return v;
+}
+
+std::vector<ADCGD> model(const std::vector<ADCGD>& x,
+                         const std::vector<ADCGD>& v) {
+    std::vector<ADCGD> y(4);
+    y[0] = v[0] * x[1] + v[1];
+    y[1] = CondExpLt(x[0], x[1], x[2] * x[2], exp(x[0]));
+    y[2] = pow(x[2], 3.0) / x[0];
+    y[3] = 5.0;
+    return y;
+}
+
+std::string generateC(CodeHandler<double>& handler,
+                      std::vector<CGD>& dep) {
+    LanguageC<double> langC("double");
+    LangCDefaultVariableNameGenerator<double> nameGen;
+
+    std::ostringstream code;
+    handler.generateCode(code, langC, dep, nameGen);
+    return code.str();
+}
+
+}
+
+TEST_F(CppADCGTest, GraphSerializer) {
+    size_t n = 3;
+
+    // atomic function
+    std::vector<ADCGD> au(2, 1.0);
+    CppAD::Independent(au);
+    std::vector<ADCGD> av = modelInner(au);
+    ADFun<CGD> funInner(au, av);
+
+    CGAtomicFunBridge<double> atomicFun("inner", funInner, true);
+
+    // model
+    std::vector<ADCGD> ax(n, 1.0);
+    CppAD::Independent(ax);
+    std::vector<ADCGD> axInner{ax[0], ax[1]};
+    std::vector<ADCGD> aAtomicV(2);
+    atomicFun(axInner, aAtomicV);
+    std::vector<ADCGD> ay = model(ax, aAtomicV);
+    ADFun<CGD> fun(ax, ay);
+
+    /**
+     * original graph
+     */
+    CodeHandler<double> handler;
+    std::vector<CGD> x(n);
+    handler.makeVariables(x);
+
+    std::vector<CGD> y = fun.Forward(0, x);
+    std::vector<CGD> jac = fun.Jacobian(x);
+
+    std::vector<CGD> dep(y);
+    dep.insert(dep.end(), jac.begin(), jac.end());
+
+    std::ostringstream saved;
+    GraphSerializer<double>::save(saved, x, dep);
+
+    std::string expected = generateC(handler, dep);
+
+    /**
+     * loaded graph
+     */
+    std::istringstream in(saved.str());
+    CodeHandler<double> handler2;
+    std::vector<CGD> x2, dep2;
+    std::map<std::string, CGAbstractAtomicFun<double>*> atomics{{atomicFun.atomic_name(), &atomicFun}};
+    GraphSerializer<double>::load(in, handler2, x2, dep2, atomics);
+
+    ASSERT_EQ(x.size(), x2.size());
+    ASSERT_EQ(dep.size(), dep2.size());
+    for (size_t i = 0; i < dep.size(); i++) {
+        ASSERT_EQ(dep[i].isParameter(), dep2[i].isParameter());
+        if (dep[i].isParameter())
+            ASSERT_EQ(dep[i].getValue(), dep2[i].getValue());
+    }
+
+    ASSERT_EQ(expected, generateC(handler2, dep2));
+    ASSERT_NE(std::string::npos, expected.find("atomicFun"));
+
+    // the same graph directly from memory
+    std::string data = saved.str();
+    CodeHandler<double> handler3;
+    std::vector<CGD> x3, dep3;
+    GraphSerializer<double>::load(data.data(), data.size(), handler3, x3, dep3, atomics);
+    ASSERT_EQ(expected, generateC(handler3, dep3));
+
+    /**
+     * errors
+     */
+    CodeHandler<double> handler4;
+    std::vector<CGD> x4, dep4;
+
+    std::istringstream in2(saved.str());
+    ASSERT_THROW(GraphSerializer<double>::load(in2, handler4, x4, dep4), CGException); // missing atomic
+
+    ASSERT_THROW(GraphSerializer<double>::load(data.data(), data.size() / 2, handler4, x4, dep4, atomics), CGException);
+
+    std::string invalid = data;
+    invalid[0] = 'X';
+    ASSERT_THROW(GraphSerializer<double>::load(invalid.data(), invalid.size(), handler4, x4, dep4, atomics), CGException);
+
+    std::ostringstream saved2;
+    std::vector<CGD> xMissing{x[1], x[2]};
+    ASSERT_THROW(GraphSerializer<double>::save(saved2, xMissing, dep), CGException); // x[0] not provided
+}
@@ -0,0 +1,135 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Ciengis
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+#include <cppad/cg/cppadcg.hpp>
+#include <gtest/gtest.h>
+
+#include "CppADCGTest.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+using namespace std;
+
+namespace {
+
+using CGD = CG<double>;
+using ADCGD = AD<CGD>;
+using VectorSet = std::vector<std::set<size_t> >;
+
+std::vector<ADCGD> model(const std::vector<ADCGD>& x) {
+    std::vector<ADCGD> y(6);
+
+    y[0] = x[0] * x[1] + 2.0 * x[2];
+    y[1] = sin(x[1]) + x[3] / x[4];
+    y[2] = exp(x[2] - x[3]) * 3.0;
+    y[3] = CondExpLt(x[0], x[1], x[2] * x[2], x[4]);
+    y[4] = pow(x[5], 2.0) + x[0];
+    y[5] = 5.0;
+
+    return y;
+}
+
+void testGraphSparsity(size_t threads) {
+    size_t n = 6;
+
+    std::vector<ADCGD> ax(n, 1.0);
+    CppAD::Independent(ax);
+    std::vector<ADCGD> ay = model(ax);
+    ADFun<CGD> fun(ax, ay);
+
+    size_t m = fun.Range();
+
+    CodeHandler<double> handler;
+    std::vector<CGD> x(n);
+    handler.makeVariables(x);
+    std::vector<CGD> y = fun.Forward(0, x);
+
+    GraphSparsity<double> graph(handler, x, y);
+    graph.setThreadCount(threads);
+
+    /**
+     * Jacobian
+     */
+    VectorSet jacExpected = jacobianSparsitySet<VectorSet>(fun);
+    VectorSet jac = graph.jacobianSparsity();
+    CppADCGTest::compareVectorSetValues(jacExpected, jac);
+
+    /**
+     * Hessian
+     */
+    VectorSet hessExpected = hessianSparsitySet<VectorSet>(fun);
+    VectorSet hess = graph.hessianSparsity();
+    CppADCGTest::compareVectorSetValues(hessExpected, hess);
+
+    std::vector<VectorSet> hessians = graph.hessianSparsities();
+    ASSERT_EQ(hessians.size(), m);
+    for (size_t i = 0; i < m; i++) {
+        VectorSet hessExpectedi = hessianSparsitySet<VectorSet>(fun, i);
+        CppADCGTest::compareVectorSetValues(hessExpectedi, hessians[i]);
+    }
+}
+
+/**
+ * A model with enough non-linear operations for the Hessian sparsity of
+ * the sum of the dependents to be split among several threads
+ * (more than 1024 non-linear operations per thread).
+ */
+void testGraphHessianSparsityLarge(size_t threads) {
+    size_t n = 50;
+    size_t m = 40;
+
+    std::vector<ADCGD> ax(n, 1.0);
+    CppAD::Independent(ax);
+    std::vector<ADCGD> ay(m);
+    for (size_t i = 0; i < m; i++) {
+        ay[i] = sin(ax[i]);
+        for (size_t k = 0; k < 80; k++) {
+            ay[i] += ax[(i + k) % n] * ax[(7 * i + 3 * k) % n];
+        }
+    }
+    ADFun<CGD> fun(ax, ay);
+
+    CodeHandler<double> handler;
+    std::vector<CGD> x(n);
+    handler.makeVariables(x);
+    std::vector<CGD> y = fun.Forward(0, x);
+
+    GraphSparsity<double> graph(handler, x, y);
+    graph.setThreadCount(threads);
+    ASSERT_EQ(graph.getThreadCount(), threads);
+
+    VectorSet hessExpected = hessianSparsitySet<VectorSet>(fun);
+    VectorSet hess = graph.hessianSparsity();
+    CppADCGTest::compareVectorSetValues(hessExpected, hess);
+
+    std::set<size_t> eqs = {1, 5, 22, 39};
+    hessExpected = hessianSparsitySet<VectorSet>(fun, eqs);
+    hess = graph.hessianSparsity(eqs);
+    CppADCGTest::compareVectorSetValues(hessExpected, hess);
+}
+
+}
+
+TEST_F(CppADCGTest, GraphSparsity) {
+    testGraphSparsity(1);
+}
+
+TEST_F(CppADCGTest, GraphSparsityMultiThreaded) {
+    testGraphSparsity(3);
+}
+
+TEST_F(CppADCGTest, GraphHessianSparsityMultiThreaded) {
+    testGraphHessianSparsityLarge(3);
+}
@@ -0,0 +1,347 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Ciengis
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+using Base = double;
+using CGD = CppAD::cg::CG<Base>;
+
+namespace {
+
+/**
+ * A minimal JSON reader used to validate the exported files.
+ * It provides the member names of the objects in the top level array.
+ */
+class JsonReader {
+private:
+    const std::string& s_;
+    size_t p_;
+    std::vector<std::set<std::string> > objects_;
+public:
+
+    explicit JsonReader(const std::string& s) :
+        s_(s),
+        p_(0) {
+    }
+
+    /**
+     * @return the member names of each object in the top level array
+     * @throws CGException if the text is not valid JSON
+     */
+    const std::vector<std::set<std::string> >& read() {
+        skipSpaces();
+        expect('[');
+        skipSpaces();
+        if (peek() != ']') {
+            while (true) {
+                objects_.emplace_back();
+                readObject(&objects_.back());
+                skipSpaces();
+                if (peek() == ',') {
+                    p_++;
+                    skipSpaces();
+                } else {
+                    break;
+                }
+            }
+        }
+        expect(']');
+        skipSpaces();
+        if (p_ != s_.size())
+            error("trailing characters");
+        return objects_;
+    }
+
+private:
+
+    void error(const std::string& what) const {
+        throw CGException("Invalid JSON at position ", p_, ": ", what);
+    }
+
+    char peek() const {
+        if (p_ >= s_.size())
+            error("unexpected end");
+        return s_[p_];
+    }
+
+    void expect(char c) {
+        if (peek() != c)
+            error(std::string("expected '") + c + "'");
+        p_++;
+    }
+
+    void skipSpaces() {
+        while (p_ < s_.size() && std::isspace(static_cast<unsigned char>(s_[p_])))
+            p_++;
+    }
+
+    std::string readString() {
+        expect('"');
+        std::string str;
+        while (peek() != '"') {
+            if (s_[p_] == '\\')
+                p_++;
+            str += peek();
+            p_++;
+        }
+        p_++;
+        return str;
+    }
+
+    void readObject(std::set<std::string>* members) {
+        expect('{');
+        skipSpaces();
+        if (peek() == '}') {
+            p_++;
+            return;
+        }
+        while (true) {
+            skipSpaces();
+            std::string name = readString();
+            if (members != nullptr)
+                members->insert(name);
+            skipSpaces();
+            expect(':');
+            skipSpaces();
+            readValue();
+            skipSpaces();
+            if (peek() == ',') {
+                p_++;
+            } else {
+                expect('}');
+                return;
+            }
+        }
+    }
+
+    void readValue() {
+        char c = peek();
+        if (c == '{') {
+            readObject(nullptr);
+        } else if (c == '"') {
+            readString();
+        } else if (s_.compare(p_, 4, "true") == 0 || s_.compare(p_, 4, "null") == 0) {
+            p_ += 4;
+        } else if (s_.compare(p_, 5, "false") == 0) {
+            p_ += 5;
+        } else {
+            size_t b = p_;
+            if (c == '-')
+                p_++;
+            while (p_ < s_.size() && (std::isdigit(static_cast<unsigned char>(s_[p_])) || s_[p_] == '.'))
+                p_++;
+            if (p_ == b || (p_ == b + 1 && c == '-'))
+                error("invalid value");
+        }
+    }
+};
+
+const JobProfiler::Record* findRecord(const std::vector<JobProfiler::Record>& records,
+                                      const std::string& action,
+                                      const std::string& name) {
+    for (const auto& r : records) {
+        if (r.action == action && r.name.find(name) != std::string::npos)
+            return &r;
+    }
+    return nullptr;
+}
+
+double findInfo(const JobProfiler::Record& r,
+                const std::string& name) {
+    for (const auto& p : r.info) {
+        if (p.first == name)
+            return p.second;
+    }
+    return -1;
+}
+
+}
+
+TEST(JobProfilerTest, SourceGeneration) {
+    using ADCG = AD<CGD>;
+
+    std::vector<ADCG> x(4, 1.0);
+    Independent(x);
+
+    std::vector<ADCG> y(3);
+    y[0] = x[0] * x[1] + sin(x[2]);
+    y[1] = x[1] * x[2] * x[3];
+    y[2] = x[0] / x[3] + cos(x[0]);
+
+    ADFun<CGD> fun(x, y);
+
+    ModelCSourceGen<double> modelGen(fun, "profiled");
+    modelGen.setCreateForwardZero(true);
+    modelGen.setCreateSparseJacobian(true);
+    modelGen.setCreateSparseHessian(true);
+
+    JobProfiler profiler;
+
+    ModelLibraryCSourceGen<double> libGen(modelGen);
+    libGen.addListener(profiler);
+    libGen.getLibrarySources();
+
+    const std::vector<JobProfiler::Record>& records = profiler.getRecords();
+    ASSERT_FALSE(records.empty());
+
+    // all jobs have been completed
+    for (const auto& r : records) {
+        ASSERT_GE(r.elapsed, 0.0);
+        if (r.parent >= 0) {
+            const auto& parent = records[r.parent];
+            ASSERT_EQ(parent.depth + 1, r.depth);
+            ASSERT_GE(r.begin, parent.begin);
+        }
+    }
+
+    // sparsity
+    const JobProfiler::Record* jacSparsity = findRecord(records, JobTimer::SPARSITY.getActionName(), "Jacobian");
+    ASSERT_TRUE(jacSparsity != nullptr);
+    ASSERT_EQ(8.0, findInfo(*jacSparsity, "non-zeros"));
+
+    // source generation and its stages
+    const JobProfiler::Record* source = findRecord(records, JobTimer::DEFAULT.getActionName(), "zero-order forward");
+    ASSERT_TRUE(source != nullptr);
+    ASSERT_GT(findInfo(*source, "nodes"), 0.0);
+    ASSERT_EQ(3.0, findInfo(*source, "dependents"));
+
+    const JobProfiler::Record* emission = findRecord(records, JobTimer::STAGE.getActionName(), "emission");
+    ASSERT_TRUE(emission != nullptr);
+    ASSERT_GE(emission->parent, 0);
+    ASSERT_EQ(JobTimer::DEFAULT.getActionName(), records[emission->parent].action);
+
+    // exports
+    std::ostringstream trace;
+    profiler.saveChromeTrace(trace);
+    ASSERT_NE(std::string::npos, trace.str().find("\"traceEvents\""));
+    ASSERT_NE(std::string::npos, trace.str().find("\"ph\": \"X\""));
+
+    std::ostringstream json;
+    profiler.saveJson(json);
+    ASSERT_NE(std::string::npos, json.str().find("\"emission\""));
+    ASSERT_NE(std::string::npos, json.str().find("\"non-zeros\": 8.000"));
+}
+
+TEST(JobProfilerTest, JsonWithoutMemory) {
+    JobProfiler profiler;
+    profiler.setRecordMemory(false);
+
+    JobTimer timer;
+    timer.addListener(profiler);
+
+    timer.startingJob("outer");
+    timer.startingJob("no information");
+    timer.finishedJob();
+    timer.startingJob("with information");
+    timer.reportJobInfo("nodes", 10);
+    timer.finishedJob();
+    timer.finishedJob();
+
+    std::ostringstream json;
+    profiler.saveJson(json);
+
+    std::vector<std::set<std::string> > objects;
+    try {
+        objects = JsonReader(json.str()).read();
+    } catch (const CGException& e) {
+        FAIL() << e.what() << "\n" << json.str();
+    }
+
+    ASSERT_EQ(3u, objects.size());
+    for (const auto& members : objects) {
+        ASSERT_EQ(1u, members.count("elapsed_us"));
+        ASSERT_EQ(0u, members.count("rss_begin_MiB"));
+    }
+    ASSERT_EQ(0u, objects[1].count("nodes"));
+    ASSERT_EQ(1u, objects[2].count("nodes"));
+
+    // with memory information
+    profiler.setRecordMemory(true);
+    json.str("");
+    profiler.saveJson(json);
+    ASSERT_NO_THROW(JsonReader(json.str()).read());
+}
+
+TEST(JobProfilerTest, NonFiniteInformation) {
+    JobProfiler profiler;
+
+    JobTimer timer;
+    timer.addListener(profiler);
+
+    timer.startingJob("non finite");
+    timer.reportJobInfo("nan", std::numeric_limits<double>::quiet_NaN());
+    timer.reportJobInfo("inf", std::numeric_limits<double>::infinity());
+    timer.reportJobInfo("nodes", 10);
+    timer.finishedJob();
+
+    std::ostringstream json;
+    profiler.saveJson(json);
+
+    std::vector<std::set<std::string> > objects;
+    try {
+        objects = JsonReader(json.str()).read();
+    } catch (const CGException& e) {
+        FAIL() << e.what() << "\n" << json.str();
+    }
+
+    ASSERT_EQ(1u, objects.size());
+    ASSERT_EQ(1u, objects[0].count("nan"));
+    ASSERT_EQ(1u, objects[0].count("inf"));
+    ASSERT_NE(std::string::npos, json.str().find("\"nan\": null"));
+    ASSERT_NE(std::string::npos, json.str().find("\"inf\": null"));
+}
+
+TEST(JobProfilerTest, BackgroundJobs) {
+    using namespace std::chrono;
+
+    JobProfiler profiler;
+
+    JobTimer timer;
+    timer.addListener(profiler);
+
+    timer.startingJob("outer");
+    timer.startingJob("inner");
+    timer.finishedJob();
+    // two jobs performed concurrently by other threads
+    timer.completedJob("first", JobTimer::COMPILING, milliseconds(5));
+    timer.completedJob("second", JobTimer::COMPILING, milliseconds(5));
+    timer.finishedJob();
+
+    const std::vector<JobProfiler::Record>& records = profiler.getRecords();
+    ASSERT_EQ(4u, records.size());
+
+    const JobProfiler::Record* outer = findRecord(records, JobTimer::DEFAULT.getActionName(), "outer");
+    const JobProfiler::Record* inner = findRecord(records, JobTimer::DEFAULT.getActionName(), "inner");
+    const JobProfiler::Record* first = findRecord(records, JobTimer::COMPILING.getActionName(), "first");
+    const JobProfiler::Record* second = findRecord(records, JobTimer::COMPILING.getActionName(), "second");
+    ASSERT_TRUE(outer != nullptr && inner != nullptr && first != nullptr && second != nullptr);
+
+    ASSERT_EQ(1u, outer->thread);
+    ASSERT_EQ(1u, inner->thread);
+    ASSERT_NE(1u, first->thread);
+    ASSERT_NE(1u, second->thread);
+    ASSERT_NE(first->thread, second->thread);
+
+    // the background jobs started before they were reported
+    ASSERT_NEAR(5000.0, first->elapsed, 1.0);
+    ASSERT_LT(first->begin, inner->begin + inner->elapsed + 1.0);
+
+    std::ostringstream trace;
+    profiler.saveChromeTrace(trace);
+    ASSERT_NE(std::string::npos, trace.str().find("\"tid\": " + std::to_string(first->thread)));
+    ASSERT_NE(std::string::npos, trace.str().find("\"tid\": " + std::to_string(second->thread)));
+}
@@ -107,4 +107,123 @@ TEST_F(CppADCGDynamicTestCustomSparsity1, Jacobian) {
 
 TEST_F(CppADCGDynamicTestCustomSparsity1, Hessian) {
     this->testHessian();
-}
\ No newline at end of file
+}
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGDynamicTestGraphSparsity1 : public CppADCGDynamicTestCustomSparsity1 {
+public:
+
+    inline explicit CppADCGDynamicTestGraphSparsity1() :
+            CppADCGDynamicTestCustomSparsity1() {
+        _sparsityEngine = SparsityEngine::OperationGraph;
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+TEST_F(CppADCGDynamicTestGraphSparsity1, Jacobian) {
+    this->testJacobian();
+}
+
+TEST_F(CppADCGDynamicTestGraphSparsity1, Hessian) {
+    this->testHessian();
+}
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Tests the same model with different source generation options
+ */
+class CppADCGDynamicOptionsTest1 : public CppADCGDynamicTest1,
+                                   public ::testing::WithParamInterface<DynamicTestOptions> {
+public:
+
+    inline explicit CppADCGDynamicOptionsTest1() :
+            CppADCGDynamicTest1() {
+        setOptions(GetParam());
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+TEST_P(CppADCGDynamicOptionsTest1, ForwardZero) {
+    this->testForwardZero();
+}
+
+TEST_P(CppADCGDynamicOptionsTest1, Jacobian) {
+    this->testJacobian();
+}
+
+TEST_P(CppADCGDynamicOptionsTest1, Hessian) {
+    this->testHessian();
+}
+
+namespace {
+
+DynamicTestOptions scheduled() {
+    DynamicTestOptions o;
+    o.name = "Scheduled";
+    o.maxAssignPerFunc = 1;
+    o.scheduleOperations = true;
+    o.localTemporaries = true;
+    return o;
+}
+
+DynamicTestOptions streamed() {
+    DynamicTestOptions o;
+    o.name = "Streamed";
+    o.maxAssignPerFunc = 1;
+    o.streamSources = true;
+    return o;
+}
+
+DynamicTestOptions pipelined() {
+    DynamicTestOptions o;
+    o.name = "Pipelined";
+    o.maxAssignPerFunc = 1;
+    o.compilationThreads = 2;
+    return o;
+}
+
+DynamicTestOptions compact() {
+    DynamicTestOptions o;
+    o.name = "Compact";
+    o.maxAssignPerFunc = 1;
+    o.compactTemporaryNames = true;
+    return o;
+}
+
+DynamicTestOptions compactLocal() {
+    DynamicTestOptions o;
+    o.name = "CompactLocal";
+    o.compactTemporaryNames = true;
+    o.localTemporaries = true;
+    return o;
+}
+
+DynamicTestOptions partitioned() {
+    DynamicTestOptions o;
+    o.name = "Partitioned";
+    o.maxAssignPerFunc = 2;
+    o.functionGraphPartitioning = true;
+    return o;
+}
+
+}
+
+INSTANTIATE_TEST_CASE_P(SourceGeneration,
+                        CppADCGDynamicOptionsTest1,
+                        ::testing::Values(scheduled(),
+                                          partitioned(),
+                                          compact(),
+                                          compactLocal(),
+                                          streamed(),
+                                          pipelined()),
+                        DynamicTestOptionsName());
@@ -0,0 +1,121 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Ciengis
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGDynamicTest.hpp"
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * A banded model (tridiagonal Jacobian and Hessian)
+ */
+class CppADCGDynamicColoringTest : public CppADCGDynamicTest {
+public:
+
+    inline explicit CppADCGDynamicColoringTest(SparseColoring coloring,
+                                               MultiThreadingType multithread = MultiThreadingType::NONE) :
+            CppADCGDynamicTest("dynamic_coloring", false, false) {
+        _sparseColoring = coloring;
+        _multithread = multithread;
+        _xTape = {1, 1, 1, 1, 1, 1};
+        _xRun = {1, 2, 1.5, 0.5, 3, 2};
+    }
+
+    std::vector<ADCGD> model(const std::vector<ADCGD>& x) override {
+        size_t n = x.size();
+        std::vector<ADCGD> y(n);
+
+        y[0] = x[0] * x[1];
+        for (size_t i = 1; i < n - 1; i++) {
+            y[i] = x[i - 1] * x[i] + sin(x[i + 1]) * x[i];
+        }
+        y[n - 1] = x[n - 2] * x[n - 1] * x[n - 1];
+
+        return y;
+    }
+
+};
+
+class CppADCGDynamicDistance2Test : public CppADCGDynamicColoringTest {
+public:
+    inline explicit CppADCGDynamicDistance2Test() :
+            CppADCGDynamicColoringTest(SparseColoring::Distance2) {
+    }
+};
+
+class CppADCGDynamicStarTest : public CppADCGDynamicColoringTest {
+public:
+    inline explicit CppADCGDynamicStarTest() :
+            CppADCGDynamicColoringTest(SparseColoring::Star) {
+    }
+};
+
+class CppADCGDynamicStarCustomTest : public CppADCGDynamicColoringTest {
+public:
+    inline explicit CppADCGDynamicStarCustomTest() :
+            CppADCGDynamicColoringTest(SparseColoring::Star) {
+        _jacRow = {0, 2, 1, 4};
+        _jacCol = {1, 3, 0, 5};
+
+        // lower and upper elements
+        _hessRow = {1, 2, 5, 4};
+        _hessCol = {0, 3, 4, 5};
+    }
+};
+
+class CppADCGDynamicStarPThreadsTest : public CppADCGDynamicColoringTest {
+public:
+    inline explicit CppADCGDynamicStarPThreadsTest() :
+            CppADCGDynamicColoringTest(SparseColoring::Star, MultiThreadingType::PTHREADS) {
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+using namespace std;
+
+TEST_F(CppADCGDynamicDistance2Test, Jacobian) {
+    this->testJacobian();
+}
+
+TEST_F(CppADCGDynamicDistance2Test, Hessian) {
+    this->testHessian();
+}
+
+TEST_F(CppADCGDynamicStarTest, Jacobian) {
+    this->testJacobian();
+}
+
+TEST_F(CppADCGDynamicStarTest, Hessian) {
+    this->testHessian();
+}
+
+TEST_F(CppADCGDynamicStarCustomTest, Jacobian) {
+    this->testJacobian();
+}
+
+TEST_F(CppADCGDynamicStarCustomTest, Hessian) {
+    this->testHessian();
+}
+
+TEST_F(CppADCGDynamicStarPThreadsTest, Jacobian) {
+    this->testJacobian();
+}
+
+TEST_F(CppADCGDynamicStarPThreadsTest, Hessian) {
+    this->testHessian();
+}
@@ -0,0 +1,87 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Ciengis
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+using Base = double;
+using CGD = CppAD::cg::CG<Base>;
+
+/**
+ * Residuals of an implicit system F(y, y', p) with y = {x[0], x[1], x[2]},
+ * y' = {x[3], x[4]} (the last state is algebraic) and p = x[5]
+ */
+TEST(CppADCGDynamicIterationMatrixTest, IterationMatrix) {
+    using ADCG = AD<CGD>;
+
+    const size_t n = 6;
+    const size_t m = 3;
+
+    std::vector<ADCG> u(n, 1.0);
+    Independent(u);
+
+    std::vector<ADCG> Z(m);
+    Z[0] = u[3] + u[0] * u[1] - u[5];
+    Z[1] = u[4] * u[0] - sin(u[1]);
+    Z[2] = u[2] * u[2] + u[0] * u[5] - 1.0;
+
+    ADFun<CGD> fun(u, Z);
+
+    std::vector<int> columns{0, 1, 2};
+    std::vector<int> alphaColumns{3, 4, -1};
+
+    ModelCSourceGen<double> modelGen(fun, "iter_mat");
+    modelGen.setCreateForwardZero(true);
+    modelGen.setCreateSparseIterationMatrix(true);
+    modelGen.setIterationMatrixColumns(columns, alphaColumns);
+
+    GccCompiler<double> compiler;
+    prepareTestCompilerFlags(compiler);
+
+    ModelLibraryCSourceGen<double> libGen(modelGen);
+    DynamicModelLibraryProcessor<double> p(libGen, "cppadcg_iter_mat");
+    std::unique_ptr<DynamicLib<double>> lib = p.createDynamicLibrary(compiler);
+
+    std::unique_ptr<GenericModel<double>> model = lib->model("iter_mat");
+    ASSERT_TRUE(model != nullptr);
+    ASSERT_TRUE(model->isSparseIterationMatrixAvailable());
+    ASSERT_FALSE(model->isSparseJacobianAvailable());
+
+    std::vector<size_t> rowsSp, colsSp;
+    model->IterationMatrixSparsity(rowsSp, colsSp);
+    ASSERT_EQ(size_t(6), rowsSp.size());
+    ASSERT_EQ(rowsSp.size(), colsSp.size());
+
+    std::vector<double> x{0.5, 1.5, -0.3, 0.7, 1.2, 2.0};
+    std::vector<CGD> xCG(x.begin(), x.end());
+    std::vector<CGD> jac = fun.Jacobian(xCG);
+
+    std::vector<double> mat;
+    std::vector<size_t> row, col;
+    for (double alpha : {0.0, 2.5, -40.0}) {
+        model->SparseIterationMatrix(x, alpha, mat, row, col);
+        ASSERT_EQ(rowsSp, row);
+        ASSERT_EQ(colsSp, col);
+
+        for (size_t e = 0; e < mat.size(); e++) {
+            double expected = jac[row[e] * n + columns[col[e]]].getValue();
+            if (alphaColumns[col[e]] >= 0)
+                expected += alpha * jac[row[e] * n + alphaColumns[col[e]]].getValue();
+            ASSERT_NEAR(expected, mat[e], 1e-10);
+        }
+    }
+}
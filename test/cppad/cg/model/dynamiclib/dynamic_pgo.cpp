@@ -0,0 +1,197 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Ciengis
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include <dirent.h>
+
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+using Base = double;
+using CGD = CppAD::cg::CG<Base>;
+
+namespace {
+
+/**
+ * Saves the action names of the jobs
+ */
+class JobRecorder : public JobListener {
+public:
+    std::vector<std::string> started;
+    size_t ended = 0;
+
+    void jobStarted(const std::vector<Job>& job) override {
+        started.push_back(job.back().getType().getActionName());
+    }
+
+    void jobEndended(const std::vector<Job>& job,
+                     duration elapsed) override {
+        ended++;
+    }
+
+    bool hasStarted(const JobType& type) const {
+        return std::find(started.begin(), started.end(), type.getActionName()) != started.end();
+    }
+};
+
+/**
+ * Counts the files with a given extension in a folder and its sub-folders
+ */
+size_t countFiles(const std::string& folder,
+                  const std::string& extension) {
+    DIR* dir = opendir(folder.c_str());
+    if (dir == nullptr)
+        return 0;
+
+    size_t count = 0;
+    while (struct dirent* entry = readdir(dir)) {
+        std::string name = entry->d_name;
+        if (name == "." || name == "..")
+            continue;
+
+        std::string path = system::createPath(folder, name);
+        if (system::isDirectory(path)) {
+            count += countFiles(path, extension);
+        } else if (name.size() > extension.size() &&
+                name.compare(name.size() - extension.size(), extension.size(), extension) == 0) {
+            count++;
+        }
+    }
+    closedir(dir);
+
+    return count;
+}
+
+}
+
+TEST(CppADCGDynamicPGOTest, ProfileGuidedOptimization) {
+    using ADCG = AD<CGD>;
+
+    const size_t n = 3;
+    const size_t m = 2;
+
+    std::vector<ADCG> u(n, 1.0);
+    Independent(u);
+
+    std::vector<ADCG> Z(m);
+    Z[0] = u[0] * u[1] + sin(u[2]);
+    Z[1] = exp(u[0]) / u[2] - u[1] * u[1];
+
+    ADFun<CGD> fun(u, Z);
+
+    ModelCSourceGen<double> modelGen(fun, "pgo");
+    modelGen.setCreateForwardZero(true);
+    modelGen.setCreateJacobian(true);
+
+    GccCompiler<double> compiler;
+    prepareTestCompilerFlags(compiler);
+    const std::vector<std::string> compileFlags = compiler.getCompileFlags();
+    const std::vector<std::string> compileLibFlags = compiler.getCompileLibFlags();
+
+    JobRecorder jobs;
+
+    ModelLibraryCSourceGen<double> libGen(modelGen);
+    libGen.addListener(jobs);
+    DynamicModelLibraryProcessor<double> p(libGen, "cppadcg_pgo");
+    p.setProfileFolder("cppadcg_pgo_profile");
+
+    size_t trainingRuns = 0;
+    auto training = [&](DynamicLib<double>& lib) {
+        std::unique_ptr<GenericModel<double>> model = lib.model("pgo");
+        ASSERT_TRUE(model != nullptr);
+        for (size_t i = 0; i < 50; ++i) {
+            std::vector<double> x{0.1 * i, 1.5, 2.0 + i};
+            model->ForwardZero(x);
+            model->Jacobian(x);
+        }
+        trainingRuns++;
+    };
+
+    std::unique_ptr<DynamicLib<double>> lib = p.createDynamicLibraryPGO(compiler, training);
+
+    ASSERT_EQ(1u, trainingRuns);
+
+    // the instrumented library saved profile data
+    ASSERT_GT(countFiles("cppadcg_pgo_profile", ".gcda"), 0u);
+
+    // all the stages were performed
+    ASSERT_TRUE(jobs.hasStarted(JobTimer::PROFILE_TRAINING));
+    ASSERT_TRUE(jobs.hasStarted(JobTimer::PROFILE_USE));
+    ASSERT_EQ(2, std::count(jobs.started.begin(), jobs.started.end(),
+                            JobTimer::DYNAMIC_MODEL_LIBRARY.getActionName()));
+    ASSERT_EQ(jobs.started.size(), jobs.ended);
+
+    // the flags of the compiler are restored
+    ASSERT_EQ(compileFlags, compiler.getCompileFlags());
+    ASSERT_EQ(compileLibFlags, compiler.getCompileLibFlags());
+
+    std::unique_ptr<GenericModel<double>> model = lib->model("pgo");
+    ASSERT_TRUE(model != nullptr);
+
+    std::vector<double> x{0.5, 1.5, 2.5};
+    std::vector<CGD> xCG(x.begin(), x.end());
+    std::vector<CGD> yCG = fun.Forward(0, xCG);
+    std::vector<CGD> jacCG = fun.Jacobian(xCG);
+
+    std::vector<double> y = model->ForwardZero(x);
+    std::vector<double> jac = model->Jacobian(x);
+    ASSERT_EQ(m, y.size());
+    ASSERT_EQ(m * n, jac.size());
+    for (size_t i = 0; i < m; i++) {
+        ASSERT_NEAR(yCG[i].getValue(), y[i], 1e-10);
+    }
+    for (size_t i = 0; i < m * n; i++) {
+        ASSERT_NEAR(jacCG[i].getValue(), jac[i], 1e-10);
+    }
+}
+
+TEST(CppADCGDynamicPGOTest, TrainingFailure) {
+    using ADCG = AD<CGD>;
+
+    std::vector<ADCG> u(2, 1.0);
+    Independent(u);
+
+    std::vector<ADCG> Z(1);
+    Z[0] = u[0] * u[1];
+
+    ADFun<CGD> fun(u, Z);
+
+    ModelCSourceGen<double> modelGen(fun, "pgofail");
+    modelGen.setCreateForwardZero(true);
+
+    GccCompiler<double> compiler;
+    prepareTestCompilerFlags(compiler);
+    const std::vector<std::string> compileFlags = compiler.getCompileFlags();
+
+    JobRecorder jobs;
+
+    ModelLibraryCSourceGen<double> libGen(modelGen);
+    libGen.addListener(jobs);
+    DynamicModelLibraryProcessor<double> p(libGen, "cppadcg_pgo_fail");
+    p.setProfileFolder("cppadcg_pgo_fail_profile");
+
+    auto training = [](DynamicLib<double>& lib) {
+        throw CGException("training failed");
+    };
+
+    ASSERT_THROW(p.createDynamicLibraryPGO(compiler, training), CGException);
+
+    // the training job was terminated and the flags restored
+    ASSERT_TRUE(jobs.hasStarted(JobTimer::PROFILE_TRAINING));
+    ASSERT_FALSE(jobs.hasStarted(JobTimer::PROFILE_USE));
+    ASSERT_EQ(jobs.started.size(), jobs.ended);
+    ASSERT_EQ(compileFlags, compiler.getCompileFlags());
+}
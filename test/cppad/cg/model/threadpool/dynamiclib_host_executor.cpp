@@ -0,0 +1,104 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include <atomic>
+#include <thread>
+
+#include "ThreadPoolTest.hpp"
+
+using namespace CppAD::cg;
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * A simple executor which runs each job in its own thread
+ */
+class TestHostExecutor {
+public:
+    std::atomic<size_t> batches{0};
+    std::atomic<size_t> jobs{0};
+
+    static void* submit(void* executor,
+                        void (*functions[])(void*),
+                        void* args[],
+                        int nJobs) {
+        auto* e = static_cast<TestHostExecutor*>(executor);
+        e->batches++;
+        e->jobs += nJobs;
+
+        auto* threads = new std::vector<std::thread>();
+        for (int i = 0; i < nJobs; ++i) {
+            threads->emplace_back(functions[i], args[i]);
+        }
+        return threads;
+    }
+
+    static void wait(void* executor,
+                     void* batch) {
+        auto* threads = static_cast<std::vector<std::thread>*>(batch);
+        for (auto& t : *threads) {
+            t.join();
+        }
+        delete threads;
+    }
+};
+
+class CppADCGHostExecutorTest : public ThreadPoolTest {
+protected:
+    TestHostExecutor _executor;
+public:
+    explicit CppADCGHostExecutorTest() :
+            ThreadPoolTest(MultiThreadingType::HOST_EXECUTOR) {
+        this->_multithreadDisabled = false;
+        this->_forwardZeroTasks = 3;
+    }
+
+    void SetUp() override {
+        ThreadPoolTest::SetUp();
+
+        ASSERT_TRUE(this->_dynamicLib->setHostExecutor(&_executor, &TestHostExecutor::submit, &TestHostExecutor::wait));
+    }
+
+    void TearDown() override {
+        this->_dynamicLib->setHostExecutor(nullptr, nullptr, nullptr);
+
+        ThreadPoolTest::TearDown();
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+TEST_F(CppADCGHostExecutorTest, ForwardZero) {
+    this->testForwardZero();
+    ASSERT_GT(_executor.batches.load(), 0u);
+}
+
+TEST_F(CppADCGHostExecutorTest, Jacobian) {
+    this->testJacobian();
+    ASSERT_GT(_executor.batches.load(), 0u);
+}
+
+TEST_F(CppADCGHostExecutorTest, Hessian) {
+    this->testHessian();
+    ASSERT_GT(_executor.batches.load(), 0u);
+}
+
+TEST_F(CppADCGHostExecutorTest, Disabled) {
+    this->_dynamicLib->setThreadPoolDisabled(true);
+    this->testJacobian();
+    this->testHessian();
+    ASSERT_EQ(_executor.batches.load(), 0u);
+}
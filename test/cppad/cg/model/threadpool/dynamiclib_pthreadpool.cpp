@@ -53,6 +53,91 @@ public:
         this->_multithreadDisabled = false;
         this->_multithreadScheduler = ThreadPoolScheduleStrategy::DYNAMIC;
     }
+
+protected:
+
+    /**
+     * Compiles the same model into a different library (with its own
+     * thread pool state).
+     */
+    std::unique_ptr<DynamicLib<double>> createLibrary(const std::string& libName,
+                                                      const std::string& embeddedProfile = "") {
+        ModelCSourceGen<double> modelSourceGen(*_fun, _name + "dynamic");
+        modelSourceGen.setCreateForwardZero(true);
+        modelSourceGen.setCreateSparseJacobian(true);
+        modelSourceGen.setCreateSparseHessian(true);
+        modelSourceGen.setCreateReverseOne(_reverseOne);
+        modelSourceGen.setCreateReverseTwo(_reverseTwo);
+        modelSourceGen.setMaxAssignmentsPerFunc(_maxAssignPerFunc);
+        modelSourceGen.setMultiThreading(true);
+        modelSourceGen.setSparseColoring(_sparseColoring);
+        modelSourceGen.setSparsityEngine(_sparsityEngine);
+
+        ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+        libSourceGen.setMultiThreading(MultiThreadingType::PTHREADS);
+        libSourceGen.setThreadPoolProfile(embeddedProfile);
+
+        DynamicModelLibraryProcessor<double> p(libSourceGen);
+        p.setLibraryName(libName);
+
+        GccCompiler<double> compiler;
+        prepareTestCompilerFlags(compiler);
+        compiler.addCompileFlag("-pthread");
+
+        std::unique_ptr<DynamicLib<double>> lib = p.createDynamicLibrary(compiler);
+        lib->setThreadPoolVerbose(this->verbose_);
+        lib->setThreadNumber(2);
+        lib->setThreadPoolSchedulerStrategy(_multithreadScheduler);
+        return lib;
+    }
+
+    /**
+     * Creates a profile with the reversed job order of each entry of an
+     * exported profile and enough time measurements to stop benchmarking.
+     */
+    static std::string reverseProfileOrder(const std::string& profile,
+                                           unsigned int nMeas) {
+        std::istringstream in(profile);
+        std::ostringstream out;
+        out << std::setprecision(9);
+
+        std::string line;
+        std::getline(in, line);
+        out << line << "\n";
+
+        while (std::getline(in, line)) {
+            std::istringstream ls(line);
+            std::string name;
+            int nJobs;
+            unsigned int n;
+            ls >> name >> nJobs >> n;
+
+            std::vector<float> refElapsed(nJobs);
+            std::vector<int> order(nJobs);
+            for (int i = 0; i < nJobs; ++i)
+                ls >> refElapsed[i];
+            for (int i = 0; i < nJobs; ++i)
+                ls >> order[i];
+
+            out << name << " " << nJobs << " " << nMeas;
+            for (int i = 0; i < nJobs; ++i)
+                out << " " << refElapsed[i];
+            for (int i = nJobs - 1; i >= 0; --i)
+                out << " " << order[i];
+            out << "\n";
+        }
+
+        return out.str();
+    }
+
+    /**
+     * Evaluates the sparse Jacobian and Hessian of a model in the same
+     * order used by testJacobian() and testHessian().
+     */
+    void testDerivatives(GenericModel<double>& model) {
+        this->testSparseJacobianResults(2, model, *_fun, nullptr, _xRun, false, epsilonR, epsilonA);
+        this->testSparseHessianResults(2, model, *_fun, nullptr, _xRun, false, epsilonR, epsilonA);
+    }
 };
 
 } // END cg namespace
@@ -70,6 +155,64 @@ TEST_F(CppADCGThreadPoolDynamicTest, Hessian) {
     this->testHessian();
 }
 
+TEST_F(CppADCGThreadPoolDynamicTest, Profile) {
+    this->testJacobian();
+    this->testHessian();
+
+    std::string profile = _dynamicLib->getThreadPoolProfile();
+    ASSERT_EQ(0u, profile.find("cppadcg_thpool_profile 1\n"));
+    ASSERT_NE(std::string::npos, profile.find(_name + "dynamic_sparse_jacobian "));
+    ASSERT_NE(std::string::npos, profile.find(_name + "dynamic_sparse_hessian "));
+
+    // importing the same profile does not change it
+    _dynamicLib->setThreadPoolProfile(profile);
+    ASSERT_EQ(profile, _dynamicLib->getThreadPoolProfile());
+
+    // profiles for unknown functions are ignored
+    _dynamicLib->setThreadPoolProfile("cppadcg_thpool_profile 1\nunknown 2 1 0.5 0.25 1 0\n");
+    ASSERT_EQ(profile, _dynamicLib->getThreadPoolProfile());
+
+    ASSERT_THROW(_dynamicLib->setThreadPoolProfile("invalid"), CGException);
+    ASSERT_THROW(_dynamicLib->setThreadPoolProfile("cppadcg_thpool_profile 1\nf 2 1 0.5\n"), CGException);
+}
+
+TEST_F(CppADCGThreadPoolDynamicTest, ProfileWarmStart) {
+    this->testJacobian();
+    this->testHessian();
+
+    std::string profile = reverseProfileOrder(_dynamicLib->getThreadPoolProfile(),
+                                              _dynamicLib->getThreadPoolNumberOfTimeMeas());
+
+    // the profile is imported before the functions are registered in the new library
+    std::unique_ptr<DynamicLib<double>> lib = createLibrary("cppad_cg_lib_warm");
+    ASSERT_EQ("cppadcg_thpool_profile 1\n", lib->getThreadPoolProfile());
+    lib->setThreadPoolProfile(profile);
+
+    std::unique_ptr<GenericModel<double>> model = lib->model(_name + "dynamic");
+    ASSERT_TRUE(model != nullptr);
+    testDerivatives(*model);
+
+    // the imported order is used and it is not benchmarked again
+    ASSERT_EQ(profile, lib->getThreadPoolProfile());
+}
+
+TEST_F(CppADCGThreadPoolDynamicTest, ProfileEmbedded) {
+    this->testJacobian();
+    this->testHessian();
+
+    std::string profile = reverseProfileOrder(_dynamicLib->getThreadPoolProfile(),
+                                              _dynamicLib->getThreadPoolNumberOfTimeMeas());
+
+    std::unique_ptr<DynamicLib<double>> lib = createLibrary("cppad_cg_lib_embedded", profile);
+
+    std::unique_ptr<GenericModel<double>> model = lib->model(_name + "dynamic");
+    ASSERT_TRUE(model != nullptr);
+    testDerivatives(*model);
+
+    // the embedded order is used and it is not benchmarked again
+    ASSERT_EQ(profile, lib->getThreadPoolProfile());
+}
+
 namespace CppAD {
 namespace cg {
 
@@ -158,3 +301,75 @@ TEST_F(CppADCGThreadPoolDynamicCustomTest, Jacobian) {
 TEST_F(CppADCGThreadPoolDynamicCustomTest, Hessian) {
     this->testHessian();
 }
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGThreadPoolForwardZeroTasksTest : public ThreadPoolTest {
+public:
+    explicit CppADCGThreadPoolForwardZeroTasksTest() :
+            ThreadPoolTest(MultiThreadingType::PTHREADS) {
+        this->_multithreadDisabled = false;
+        this->_multithreadScheduler = ThreadPoolScheduleStrategy::DYNAMIC;
+        this->_forwardZeroTasks = 3;
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+TEST_F(CppADCGThreadPoolForwardZeroTasksTest, ForwardZero) {
+    this->testForwardZero();
+}
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGThreadPoolWorkspaceTest : public ThreadPoolTest {
+public:
+    explicit CppADCGThreadPoolWorkspaceTest() :
+            ThreadPoolTest(MultiThreadingType::PTHREADS) {
+        this->_multithreadDisabled = false;
+        this->_multithreadScheduler = ThreadPoolScheduleStrategy::DYNAMIC;
+        this->_forwardZeroTasks = 3;
+        this->_temporaryWorkspace = true;
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+TEST_F(CppADCGThreadPoolWorkspaceTest, ForwardZero) {
+    this->testForwardZero();
+}
+
+TEST_F(CppADCGThreadPoolWorkspaceTest, Jacobian) {
+    this->testJacobian();
+}
+
+TEST_F(CppADCGThreadPoolWorkspaceTest, Hessian) {
+    this->testHessian();
+}
+
+TEST_F(CppADCGThreadPoolWorkspaceTest, CustomWorkspace) {
+    size_t size = _model->getWorkspaceSize();
+    ASSERT_GT(size, 0u);
+
+    // a workspace provided by the application
+    const size_t align = LanguageC<double>::WORKSPACE_ALIGNMENT;
+    std::vector<char> buffer(size + align, 0);
+    size_t shift = (align - reinterpret_cast<std::uintptr_t>(buffer.data()) % align) % align;
+    _model->setWorkspace(buffer.data() + shift);
+
+    this->testForwardZero();
+    this->testJacobian();
+    this->testHessian();
+
+    if (shift != 1) {
+        ASSERT_THROW(_model->setWorkspace(buffer.data() + 1), CGException);
+    }
+
+    // back to the workspace owned by the model
+    _model->setWorkspace(nullptr);
+    this->testForwardZero();
+}
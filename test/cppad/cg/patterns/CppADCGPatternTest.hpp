@@ -32,6 +32,8 @@ protected:
     bool testZeroOrder_;
     bool testJacobian_;
     bool testHessian_;
+    bool vectorizationHints_;
+    bool localTemporaries_;
     std::vector<Base> xNorm_;
     std::vector<Base> eqNorm_;
     std::vector<atomic_base<Base>*> atoms_;
@@ -41,7 +43,23 @@ protected:
     Base hessianEpsilonR_;
     std::vector<std::set<size_t> > customJacSparsity_;
     std::vector<std::set<size_t> > customHessSparsity_;
+    /**
+     * the source files generated for the models with loops
+     */
+    std::map<std::string, std::string> loopSources_;
 private:
+    /**
+     * Provides access to the source files of a model
+     */
+    class ModelSourcesProcessor : public ModelLibraryProcessor<Base> {
+    public:
+        inline explicit ModelSourcesProcessor(ModelLibraryCSourceGen<Base>& libGen) :
+            ModelLibraryProcessor<Base>(libGen) {
+        }
+
+        using ModelLibraryProcessor<Base>::getSources;
+    };
+
     std::unique_ptr<DefaultPatternTestModel<CG<Base> > > modelMem_;
 public:
 
@@ -51,6 +69,8 @@ public:
         testZeroOrder_(true),
         testJacobian_(true),
         testHessian_(true),
+        vectorizationHints_(false),
+        localTemporaries_(false),
         epsilonA_(std::numeric_limits<Base>::epsilon() * 1e2),
         epsilonR_(std::numeric_limits<Base>::epsilon() * 1e2),
         hessianEpsilonA_(std::numeric_limits<Base>::epsilon() * 1e2),
@@ -397,6 +417,8 @@ public:
         compHelpL.setRelatedDependents(relatedDepCandidates);
         compHelpL.setTypicalIndependentValues(xTypical);
         compHelpL.setParameterPrecision(std::numeric_limits<Base>::digits10 + 4);
+        compHelpL.setVectorizationHints(vectorizationHints_);
+        compHelpL.setLocalTemporaries(localTemporaries_);
 
         if (!customJacSparsity_.empty())
             compHelpL.setCustomSparseJacobianElements(customJacSparsity_);
@@ -416,6 +438,8 @@ public:
 
         DynamicModelLibraryProcessor<double> p(compDynHelpL, libBaseName + "Loops");
         std::unique_ptr<DynamicLib<double> > dynamicLibL = p.createDynamicLibrary(compiler);
+        const std::map<std::string, std::string>& sourcesL = ModelSourcesProcessor(compDynHelpL).getSources(compHelpL);
+        loopSources_.insert(sourcesL.begin(), sourcesL.end());
         std::unique_ptr<GenericModel<double> > modelL;
         if (loadModels) {
             modelL = dynamicLibL->model(libBaseName + "Loops");
@@ -438,6 +462,8 @@ public:
         compHelp.setCreateReverseTwo(reverseTwo);
         compHelp.setTypicalIndependentValues(xTypical);
         compHelp.setParameterPrecision(std::numeric_limits<Base>::digits10 + 4);
+        compHelp.setVectorizationHints(vectorizationHints_);
+        compHelp.setLocalTemporaries(localTemporaries_);
         //compHelp.setMaxAssignmentsPerFunc(maxAssignPerFunc);
 
         if (!customJacSparsity_.empty())
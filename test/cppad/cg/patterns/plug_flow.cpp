@@ -64,6 +64,63 @@ public:
         //customHessSparsity_[22].insert(22);
     }
 
+    /**
+     * Checks that the source code of the models with loops uses restrict
+     * pointers and that the vectorization pragma is only used for loops
+     * whose iterations do not accumulate into the same variables.
+     */
+    inline void checkVectorizationHints() const {
+        ASSERT_FALSE(loopSources_.empty());
+
+        auto trim = [](const std::string& line) {
+            size_t b = line.find_first_not_of(" \t");
+            return b == std::string::npos ? std::string() : line.substr(b);
+        };
+
+        size_t restrictDcl = 0;
+        size_t hinted = 0;
+        size_t accumulating = 0;
+
+        for (const auto& src : loopSources_) {
+            if (src.second.find("* restrict ") != std::string::npos)
+                restrictDcl++;
+
+            std::vector<std::string> lines;
+            std::istringstream is(src.second);
+            for (std::string line; std::getline(is, line);)
+                lines.push_back(trim(line));
+
+            for (size_t l = 0; l < lines.size(); l++) {
+                const std::string& line = lines[l];
+                if (line.compare(0, 4, "for(") != 0 || line.back() != '{')
+                    continue; // not a loop with a body
+
+                bool hint = l >= 2 && lines[l - 1] == "#endif" && lines[l - 2] == "#pragma GCC ivdep";
+
+                // the loop body
+                std::string body;
+                int depth = 1;
+                for (size_t k = l + 1; k < lines.size() && depth > 0; k++) {
+                    depth += std::count(lines[k].begin(), lines[k].end(), '{');
+                    depth -= std::count(lines[k].begin(), lines[k].end(), '}');
+                    body += lines[k] + "\n";
+                }
+
+                if (body.find("+=") != std::string::npos) {
+                    accumulating++;
+                    ASSERT_FALSE(hint) << src.first << ": vectorization hint for an accumulating loop\n"
+                                       << line << "\n" << body;
+                } else if (hint) {
+                    hinted++;
+                }
+            }
+        }
+
+        ASSERT_GT(restrictDcl, 0u);
+        ASSERT_GT(hinted, 0u); // at least one loop which evaluates equations
+        ASSERT_GT(accumulating, 0u); // the Jacobian loops add contributions
+    }
+
 };
 
 } // END cg namespace
@@ -93,4 +150,20 @@ TEST_F(CppADCGPatternPlugFlowTest, plugflow) {
     this->useCustomSparsity_ = true;
 
     this->test(nEls);
-}
\ No newline at end of file
+}
+
+/**
+ * @test test the usage of loops for the generation of the plug flow model
+ *       with vectorization hints (restrict arrays and loop pragmas)
+ */
+TEST_F(CppADCGPatternPlugFlowTest, plugflowVectorizationHints) {
+    modelName += "Vectorization";
+
+    this->useCustomSparsity_ = true;
+    this->vectorizationHints_ = true;
+    this->localTemporaries_ = true;
+
+    this->test(nEls);
+
+    this->checkVectorizationHints();
+}
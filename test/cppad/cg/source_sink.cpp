@@ -0,0 +1,115 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Ciengis
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace {
+
+using CGD = CG<double>;
+
+/**
+ * Provides access to the sources of a model
+ */
+class SourcesProcessor : public ModelLibraryProcessor<double> {
+public:
+
+    inline explicit SourcesProcessor(ModelLibraryCSourceGen<double>& libGen) :
+        ModelLibraryProcessor<double>(libGen) {
+    }
+
+    inline const std::map<std::string, std::string>& sources(ModelCSourceGen<double>& model) {
+        return this->getSources(model);
+    }
+};
+
+std::unique_ptr<ADFun<CGD> > createModel() {
+    using ADCG = AD<CGD>;
+
+    std::vector<ADCG> x(3, 1.0);
+    Independent(x);
+
+    std::vector<ADCG> y(2);
+    y[0] = x[0] * x[1] + sin(x[2]);
+    y[1] = x[1] / x[2] + cos(x[0]);
+
+    return std::unique_ptr<ADFun<CGD> >(new ADFun<CGD>(x, y));
+}
+
+void configure(ModelCSourceGen<double>& modelGen) {
+    modelGen.setCreateForwardZero(true);
+    modelGen.setCreateSparseJacobian(true);
+    modelGen.setCreateSparseHessian(true);
+    modelGen.setMaxAssignmentsPerFunc(5); // also split functions
+}
+
+std::string readFile(const std::string& path) {
+    std::ifstream file(path.c_str());
+    std::stringstream ss;
+    ss << file.rdbuf();
+    return ss.str();
+}
+
+}
+
+TEST(SourceSinkTest, NoSink) {
+    std::unique_ptr<ADFun<CGD> > fun = createModel();
+
+    ModelCSourceGen<double> modelGen(*fun, "nosink");
+    configure(modelGen);
+    ASSERT_TRUE(modelGen.getSourceSink() == nullptr);
+
+    ModelLibraryCSourceGen<double> libGen(modelGen);
+    SourcesProcessor p(libGen);
+
+    const std::map<std::string, std::string>& sources = p.sources(modelGen);
+    ASSERT_FALSE(sources.empty());
+    ASSERT_TRUE(sources.find("nosink_forward_zero.c") != sources.end());
+
+    for (const auto& it : sources) {
+        ASSERT_FALSE(it.second.empty()) << it.first;
+    }
+
+    // the library sources are also kept in memory
+    ASSERT_FALSE(libGen.getLibrarySources().empty());
+}
+
+TEST(SourceSinkTest, FileSink) {
+    std::unique_ptr<ADFun<CGD> > fun = createModel();
+
+    ModelCSourceGen<double> modelGenMem(*fun, "sink");
+    configure(modelGenMem);
+    ModelLibraryCSourceGen<double> libGenMem(modelGenMem);
+    SourcesProcessor pMem(libGenMem);
+    std::map<std::string, std::string> expected = pMem.sources(modelGenMem);
+
+    FileSourceSink sink("cppadcg_source_sink");
+    ModelCSourceGen<double> modelGen(*fun, "sink");
+    configure(modelGen);
+    modelGen.setSourceSink(&sink);
+    ModelLibraryCSourceGen<double> libGen(modelGen);
+    SourcesProcessor p(libGen);
+
+    ASSERT_TRUE(p.sources(modelGen).empty());
+    ASSERT_EQ(sink.getFiles().size(), expected.size());
+
+    for (const auto& it : expected) {
+        std::string path = system::createPath(sink.getFolder(), it.first);
+        ASSERT_EQ(readFile(path), it.second) << it.first;
+        remove(path.c_str());
+    }
+    remove(sink.getFolder().c_str());
+}
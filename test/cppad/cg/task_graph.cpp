@@ -0,0 +1,179 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Ciengis
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace {
+
+using CGD = CG<double>;
+using ADCGD = AD<CGD>;
+
+std::vector<ADCGD> model(const std::vector<ADCGD>& x) {
+    std::vector<ADCGD> y(7);
+
+    // shared by all equations
+    ADCGD s = x[0] * x[1] + exp(x[2]);
+
+    for (size_t i = 0; i < 3; ++i) {
+        size_t j0 = i * 2;
+        y[i * 2] = sin(x[j0]) * s + x[j0 + 1] / x[j0];
+        y[i * 2 + 1] = pow(x[j0 + 1], 2.0) - s * cos(x[j0 + 1]);
+    }
+    y[6] = x[3];
+
+    return y;
+}
+
+/**
+ * Evaluates the tasks in their execution order using the workspace
+ */
+std::vector<double> evaluateTasks(TaskGraph<double>& tasks,
+                                  const std::vector<CGD>& dep,
+                                  const std::vector<double>& xv) {
+    size_t n = xv.size();
+    std::vector<double> w(tasks.getWorkspaceSize(), std::numeric_limits<double>::quiet_NaN());
+
+    for (const auto& level : tasks.getLevels()) {
+        for (const auto& task : level) {
+            CodeHandler<double> handler;
+            std::vector<CGD> x(n);
+            handler.makeVariables(x);
+            for (size_t j = 0; j < n; j++)
+                x[j].setValue(xv[j]);
+
+            std::vector<CGD> inputs(task.inputs.size());
+            handler.makeVariables(inputs);
+            for (size_t i = 0; i < inputs.size(); i++) {
+                size_t p = tasks.getWorkspacePosition(*task.inputs[i]);
+                EXPECT_LT(p, w.size());
+                inputs[i].setValue(w[p]);
+            }
+
+            std::vector<CGD> outputs = tasks.createTaskOperations(task, x, inputs);
+            EXPECT_EQ(outputs.size(), task.outputs.size());
+            for (size_t i = 0; i < outputs.size(); i++) {
+                EXPECT_TRUE(outputs[i].isValueDefined());
+                w[task.offset + i] = outputs[i].getValue();
+            }
+        }
+    }
+
+    std::vector<double> y(dep.size());
+    for (size_t i = 0; i < dep.size(); i++) {
+        const OperationNode<double>* node = dep[i].getOperationNode();
+        if (node == nullptr)
+            y[i] = dep[i].getValue();
+        else if (node->getOperationType() == CGOpCode::Inv)
+            y[i] = xv[node->getCodeHandler()->getIndependentVariableIndex(*node)];
+        else
+            y[i] = w[tasks.getWorkspacePosition(*node)];
+    }
+    return y;
+}
+
+/**
+ * Provides access to the sources of a model
+ */
+class SourcesProcessor : public ModelLibraryProcessor<double> {
+public:
+
+    inline explicit SourcesProcessor(ModelLibraryCSourceGen<double>& libGen) :
+        ModelLibraryProcessor<double>(libGen) {
+    }
+
+    inline const std::map<std::string, std::string>& sources(ModelCSourceGen<double>& model) {
+        return this->getSources(model);
+    }
+};
+
+}
+
+TEST_F(CppADCGTest, TaskDispatchConstants) {
+    size_t n = 6;
+
+    std::vector<ADCGD> ax(n, 1.0);
+    CppAD::Independent(ax);
+    std::vector<ADCGD> ay = model(ax);
+    ay.push_back(std::numeric_limits<double>::infinity());
+    ay.push_back(-std::numeric_limits<double>::infinity());
+    ay.push_back(std::numeric_limits<double>::quiet_NaN());
+    ay.push_back(3.0);
+    ADFun<CGD> fun(ax, ay);
+
+    ModelCSourceGen<double> modelGen(fun, "constants");
+    modelGen.setCreateForwardZero(true);
+    modelGen.setMultiThreading(true);
+    modelGen.setForwardZeroTaskCount(3);
+
+    ModelLibraryCSourceGen<double> libGen(modelGen);
+    libGen.setMultiThreading(MultiThreadingType::PTHREADS);
+    SourcesProcessor p(libGen);
+
+    const std::map<std::string, std::string>& sources = p.sources(modelGen);
+    auto it = sources.find("constants_forward_zero.c");
+    ASSERT_TRUE(it != sources.end());
+    const std::string& src = it->second;
+
+    // non-finite constants must be valid C
+    ASSERT_NE(src.find("y[7] = INFINITY;"), std::string::npos) << src;
+    ASSERT_NE(src.find("y[8] = (-INFINITY);"), std::string::npos) << src;
+    ASSERT_NE(src.find("y[9] = NAN;"), std::string::npos) << src;
+    ASSERT_NE(src.find("y[10] = 3.;"), std::string::npos) << src;
+    ASSERT_EQ(src.find("inf;"), std::string::npos) << src;
+    ASSERT_EQ(src.find("nan;"), std::string::npos) << src;
+}
+
+TEST_F(CppADCGTest, TaskGraph) {
+    size_t n = 6;
+
+    std::vector<ADCGD> ax(n, 1.0);
+    CppAD::Independent(ax);
+    std::vector<ADCGD> ay = model(ax);
+    ADFun<CGD> fun(ax, ay);
+
+    CodeHandler<double> handler;
+    std::vector<CGD> x(n);
+    handler.makeVariables(x);
+    std::vector<CGD> dep = fun.Forward(0, x);
+
+    std::vector<double> xv{0.5, 1.5, 0.25, 2.0, 1.25, 0.75};
+    std::vector<ADCGD> axv(xv.begin(), xv.end());
+    std::vector<ADCGD> ayv = model(axv);
+
+    for (size_t maxTasks : {1u, 2u, 3u}) {
+        TaskGraph<double> tasks(handler, maxTasks);
+        tasks.partition(dep);
+
+        ASSERT_FALSE(tasks.getLevels().empty());
+        for (const auto& level : tasks.getLevels()) {
+            ASSERT_LE(level.size(), maxTasks);
+        }
+        if (maxTasks == 1) {
+            ASSERT_EQ(tasks.getTaskCount(), 1u);
+        } else {
+            // the shared expression is evaluated before the equations
+            ASSERT_EQ(tasks.getLevels().size(), 2u);
+            ASSERT_EQ(tasks.getLevels().back().size(), maxTasks);
+        }
+
+        std::vector<double> y = evaluateTasks(tasks, dep, xv);
+        ASSERT_EQ(y.size(), ayv.size());
+        for (size_t i = 0; i < y.size(); i++) {
+            ASSERT_NEAR(y[i], Value(ayv[i]).getValue(), 1e-10);
+        }
+    }
+}
@@ -30,13 +30,15 @@ public:
 
     void testModel(ADFun<CGD>& f,
                    size_t expectedTmp,
-                   size_t expectedArraySize) {
+                   size_t expectedArraySize,
+                   bool schedule = false) {
         using CppAD::vector;
 
         size_t n = f.Domain();
         //size_t m = f.Range();
 
         CodeHandler<double> handler(10 + n * n);
+        handler.setScheduleOperations(schedule);
 
         vector<CGD> indVars(n);
         handler.makeVariables(indVars);
@@ -148,3 +150,28 @@ TEST_F(CppADCGTempTest, Temporary3) {
     ADFun<CGD> f(ind, dep);
     testModel(f, 1, 0);
 }
+
+TEST_F(CppADCGTempTest, Scheduled) {
+    size_t n = 5;
+    size_t m = 3;
+
+    std::vector<ADCGD> ind(n); // independent variable vector
+    for (size_t j = 0; j < n; j++)
+        ind[j] = j + 1;
+    Independent(ind);
+
+    std::vector<ADCGD> dep(m); // dependent variable vector
+
+    // model
+    ADCGD t = sin(ind[0]);
+    dep[0] = t * ind[1];
+    ADCGD s1 = cos(ind[2]);
+    ADCGD s2 = exp(ind[3]);
+    dep[1] = s1 * s1 + s2 * s2;
+    ADCGD u = t * ind[4]; // t could be released before s1 and s2 are created
+    dep[2] = u * u;
+
+    ADFun<CGD> f(ind, dep);
+    testModel(f, 3, 0, false);
+    testModel(f, 2, 0, true);
+}